@@ -92,18 +92,21 @@ void computeInterpolatedColor(FfxUInt32x2 iPxPos, out FfxFloat32x3 fInterpolated
     VectorFieldEntry gameMv;
     LoadInpaintedGameFieldMv(fUvInInterpolationRect, gameMv);
 
-    // OF is done on the back buffers which already have black bars
+    // DLSSG-TO-FSR3: OF is restricted to the interpolation rect, same as game MV
     VectorFieldEntry ofMv;
-    SampleOpticalFlowMotionVectorField(fUvInScreenSpace, ofMv);
+    SampleOpticalFlowMotionVectorField(fUvInInterpolationRect, ofMv);
 
     // Binarize disucclusion factor
     FfxFloat32x2 fDisocclusionFactor = FfxFloat32x2(FFX_EQUAL(ffxSaturate(SampleDisocclusionMask(fLrUvInInterpolationRect).xy), FfxFloat32x2(1.0, 1.0)));
 
-    InterpolationSourceColor fPrevColorGame = SampleTextureBilinear(false, fUvInScreenSpace, +gameMv.fMotionVector * fUvLetterBoxScale, DisplaySize());
-    InterpolationSourceColor fCurrColorGame = SampleTextureBilinear(true, fUvInScreenSpace, -gameMv.fMotionVector * fUvLetterBoxScale, DisplaySize());
+    const FfxFloat32 fPrevScale = PreviousFrameVectorScale();
+    const FfxFloat32 fCurrScale = CurrentFrameVectorScale();
 
-    InterpolationSourceColor fPrevColorOF = SampleTextureBilinear(false, fUvInScreenSpace, +ofMv.fMotionVector * fUvLetterBoxScale, DisplaySize());
-    InterpolationSourceColor fCurrColorOF = SampleTextureBilinear(true, fUvInScreenSpace, -ofMv.fMotionVector * fUvLetterBoxScale, DisplaySize());
+    InterpolationSourceColor fPrevColorGame = SampleTextureBilinear(false, fUvInScreenSpace, +gameMv.fMotionVector * fPrevScale * fUvLetterBoxScale, DisplaySize());
+    InterpolationSourceColor fCurrColorGame = SampleTextureBilinear(true, fUvInScreenSpace, -gameMv.fMotionVector * fCurrScale * fUvLetterBoxScale, DisplaySize());
+
+    InterpolationSourceColor fPrevColorOF = SampleTextureBilinear(false, fUvInScreenSpace, +ofMv.fMotionVector * fPrevScale * fUvLetterBoxScale, DisplaySize());
+    InterpolationSourceColor fCurrColorOF = SampleTextureBilinear(true, fUvInScreenSpace, -ofMv.fMotionVector * fCurrScale * fUvLetterBoxScale, DisplaySize());
 
     FfxFloat32 fBilinearWeightSum = 0.0f;
     FfxFloat32 fDisoccludedFactor = 0.0f;
@@ -116,9 +119,11 @@ void computeInterpolatedColor(FfxUInt32x2 iPxPos, out FfxFloat32x3 fInterpolated
         // Inpaint in bi-directional disocclusion areas
         updateInPaintingWeight(fInPaintingWeight, FfxFloat32(length(fDisocclusionFactor) <= FFX_FRAMEINTERPOLATION_EPSILON));
 
-        FfxFloat32 t = 0.5f;
-        t += 0.5f * (1 - (fDisocclusionFactor.x));
-        t -= 0.5f * (1 - (fDisocclusionFactor.y));
+        // DLSSG-TO-FSR3: Bias towards the closer source frame when generating more than one frame
+        const FfxFloat32 fT = InterpolationFactor();
+        FfxFloat32 t = fT;
+        t += (1.0f - fT) * (1 - (fDisocclusionFactor.x));
+        t -= fT * (1 - (fDisocclusionFactor.y));
 
         fInterpolatedColor = ffxLerp(fPrevColorGame.fRaw, fCurrColorGame.fRaw, ffxSaturate(t));
         fBilinearWeightSum = ffxLerp(fPrevColorGame.fBilinearWeightSum, fCurrColorGame.fBilinearWeightSum, ffxSaturate(t));
@@ -143,11 +148,11 @@ void computeInterpolatedColor(FfxUInt32x2 iPxPos, out FfxFloat32x3 fInterpolated
 
     {
 
-        FfxFloat32 ofT = 0.5f;
+        FfxFloat32 ofT = InterpolationFactor();
 
         if (fPrevColorOF.fBilinearWeightSum > 0 && fCurrColorOF.fBilinearWeightSum > 0)
         {
-            ofT = 0.5f;
+            ofT = InterpolationFactor();
         }
         else if (fPrevColorOF.fBilinearWeightSum > 0)
         {
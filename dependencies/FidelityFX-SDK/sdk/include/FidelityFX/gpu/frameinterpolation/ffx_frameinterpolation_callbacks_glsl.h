@@ -65,7 +65,7 @@
 
         FfxFloat32x2    minMaxLuminance;
         FfxFloat32      fTanHalfFOV;
-        FfxInt32        _pad1;
+        FfxFloat32      fInterpolationFactor; // DLSSG-TO-FSR3: Was _pad1
 
         FfxFloat32x2    fJitter;
         FfxFloat32x2    fMotionVectorScale;
@@ -168,6 +168,11 @@
         return cbFI.fTanHalfFOV;
     }
 
+    FfxFloat32 InterpolationFactor()
+    {
+        return cbFI.fInterpolationFactor;
+    }
+
     FfxUInt32 BackBufferTransferFunction()
     {
         return cbFI.backBufferTransferFunction;
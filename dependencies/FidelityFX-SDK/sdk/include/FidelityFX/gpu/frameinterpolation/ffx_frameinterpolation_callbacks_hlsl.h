@@ -77,7 +77,7 @@
 
         FfxFloat32x2    minMaxLuminance;
         FfxFloat32      fTanHalfFOV;
-        FfxInt32        _pad1;
+        FfxFloat32      fInterpolationFactor; // DLSSG-TO-FSR3: Was _pad1
 
         FfxFloat32x2    fJitter;
         FfxFloat32x2    fMotionVectorScale;
@@ -180,6 +180,11 @@
         return fTanHalfFOV;
     }
 
+    FfxFloat32 InterpolationFactor()
+    {
+        return fInterpolationFactor;
+    }
+
     FfxUInt32 BackBufferTransferFunction()
     {
         return backBufferTransferFunction;
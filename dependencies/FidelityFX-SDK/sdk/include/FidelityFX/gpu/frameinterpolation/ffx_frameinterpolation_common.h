@@ -33,6 +33,18 @@ FFX_STATIC const FfxFloat32 FFX_FRAMEINTERPOLATION_FLT_MIN = 1.175494351e-38f;
 
 FFX_STATIC const FfxFloat32 fReconstructedDepthBilinearWeightThreshold = FFX_FRAMEINTERPOLATION_EPSILON;
 
+// DLSSG-TO-FSR3: Vector fields hold half vectors (midpoint to previous/current frame). These scale them for an
+// arbitrary interpolation factor t where 0 is the previous frame and 1 is the current frame.
+FfxFloat32 PreviousFrameVectorScale()
+{
+    return 2.0f * InterpolationFactor();
+}
+
+FfxFloat32 CurrentFrameVectorScale()
+{
+    return 2.0f * (1.0f - InterpolationFactor());
+}
+
 FfxFloat32 RGBToLuma(FfxFloat32x3 fLinearRgb)
 {
     return dot(fLinearRgb, FfxFloat32x3(0.2126f, 0.7152f, 0.0722f));
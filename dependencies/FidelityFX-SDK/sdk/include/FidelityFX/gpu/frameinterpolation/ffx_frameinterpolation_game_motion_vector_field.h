@@ -46,7 +46,7 @@ void computeGameFieldMvs(FfxInt32x2 iPxPos)
     const FfxFloat32 fDepthSample = LoadDilatedDepth(iPxPos + iDistortionPixelOffset);
     const FfxFloat32x2 fGameMotionVector = LoadDilatedMotionVector(iPxPos + iDistortionPixelOffset);
     const FfxFloat32x2 fMotionVectorHalf = fGameMotionVector * 0.5f;
-    const FfxFloat32x2 fInterpolatedLocationUv = fUvInScreenSpace + fMotionVectorHalf;
+    const FfxFloat32x2 fInterpolatedLocationUv = fUvInScreenSpace + fMotionVectorHalf * CurrentFrameVectorScale();
 
     const FfxFloat32 fViewSpaceDepth = ConvertFromDeviceDepthToViewSpace(fDepthSample);
     const FfxUInt32 uHighPriorityFactorPrimary = getPriorityFactorFromViewSpaceDepth(fViewSpaceDepth);
@@ -86,7 +86,7 @@ void computeGameFieldMvs(FfxInt32x2 iPxPos)
         FfxUInt32 uNumPrimaryHits = 0;
         const FfxFloat32 fSecondaryStepScale = length(1.0f / RenderSize());
         const FfxFloat32x2 fStepMv = normalize(fGameMotionVector);
-        const FfxFloat32 fBreakDist = ffxMin(length(fMotionVectorHalf), length(FfxFloat32x2(0.5f, 0.5f)));
+        const FfxFloat32 fBreakDist = ffxMin(length(fMotionVectorHalf * CurrentFrameVectorScale()), length(FfxFloat32x2(0.5f, 0.5f)));
 
         for (FfxFloat32 fMvScale = fSecondaryStepScale; fMvScale <= fBreakDist && bWriteSecondary; fMvScale += fSecondaryStepScale)
         {
@@ -27,12 +27,17 @@ void computeOpticalFlowFieldMvs(FfxUInt32x2 dtID, FfxFloat32x2 fOpticalFlowVecto
 {
     FfxFloat32x2 fUv = FfxFloat32x2(FfxFloat32x2(dtID)+0.5f) / GetOpticalFlowSize2();
 
+    // DLSSG-TO-FSR3: Optical flow only covers the interpolation rect. Map back to the backbuffers for sampling.
+    const FfxFloat32x2 fUvInInterpolationRectStart = FfxFloat32x2(InterpolationRectBase()) / DisplaySize();
+    const FfxFloat32x2 fUvLetterBoxScale           = FfxFloat32x2(InterpolationRectSize()) / DisplaySize();
+    const FfxFloat32x2 fUvInScreenSpace            = fUvInInterpolationRectStart + fUv * fUvLetterBoxScale;
+
     const FfxFloat32 scaleFactor = 1.0f;
     FfxFloat32x2 fMotionVectorHalf = fOpticalFlowVector * 0.5f;
 
     // pixel position in current frame + fOpticalFlowVector-> pixel position in previous frame
-    FfxFloat32x3 prevBackbufferCol = SamplePreviousBackbuffer(fUv + fOpticalFlowVector).xyz; // returns previous backbuffer color of current frame pixel position in previous frame
-    FfxFloat32x3 curBackbufferCol  = SampleCurrentBackbuffer(fUv).xyz; // returns current backbuffer color at current frame pixel position
+    FfxFloat32x3 prevBackbufferCol = SamplePreviousBackbuffer(fUvInScreenSpace + fOpticalFlowVector * fUvLetterBoxScale).xyz; // returns previous backbuffer color of current frame pixel position in previous frame
+    FfxFloat32x3 curBackbufferCol  = SampleCurrentBackbuffer(fUvInScreenSpace).xyz; // returns current backbuffer color at current frame pixel position
 
     FfxFloat32 prevLuma = 0.001f + RawRGBToLuminance(prevBackbufferCol);
     FfxFloat32 currLuma = 0.001f + RawRGBToLuminance(curBackbufferCol);
@@ -49,7 +54,7 @@ void computeOpticalFlowFieldMvs(FfxUInt32x2 dtID, FfxFloat32x2 fOpticalFlowVecto
 
         const FfxUInt32x2 packedVectorPrimary = PackVectorFieldEntries(true, uHighPriorityFactor, uLowPriorityFactor, fMotionVectorHalf);
 
-        BilinearSamplingData bilinearInfo = GetBilinearSamplingData(fUv + fMotionVectorHalf, GetOpticalFlowSize2());
+        BilinearSamplingData bilinearInfo = GetBilinearSamplingData(fUv + fMotionVectorHalf * CurrentFrameVectorScale(), GetOpticalFlowSize2());
         for (FfxInt32 iSampleIndex = 0; iSampleIndex < 4; iSampleIndex++)
         {
             const FfxInt32x2 iOffset = bilinearInfo.iOffsets[iSampleIndex];
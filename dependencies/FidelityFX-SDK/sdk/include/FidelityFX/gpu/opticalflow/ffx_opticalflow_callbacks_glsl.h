@@ -60,6 +60,7 @@
         FfxUInt32 iFrameIndex;
         FfxUInt32 backbufferTransferFunction;
         FfxFloat32x2 minMaxLuminance;
+        FfxInt32x2 iInputColorOffset; // DLSSG-TO-FSR3
     } cbOF;
 
 FfxInt32x2 DisplaySize()
@@ -82,6 +83,11 @@ FfxFloat32x2 MinMaxLuminance()
     return cbOF.minMaxLuminance;
 }
 
+FfxInt32x2 InputColorOffset()
+{
+    return cbOF.iInputColorOffset;
+}
+
 FfxBoolean CrossedSceneChangeThreshold(FfxFloat32 sceneChangeValue)
 {
     return sceneChangeValue > 0.45f;
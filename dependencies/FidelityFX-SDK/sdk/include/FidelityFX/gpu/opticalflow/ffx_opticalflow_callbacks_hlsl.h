@@ -70,8 +70,9 @@
         FfxUInt32 iFrameIndex;
         FfxUInt32 backbufferTransferFunction;
         FfxFloat32x2 minMaxLuminance;
+        FfxInt32x2 iInputColorOffset; // DLSSG-TO-FSR3
     };
-#define FFX_OPTICALFLOW_CONSTANT_BUFFER_1_SIZE 8
+#define FFX_OPTICALFLOW_CONSTANT_BUFFER_1_SIZE 10
 
 #endif //FFX_OPTICALFLOW_BIND_CB_COMMON
 
@@ -158,6 +159,11 @@ FfxFloat32x2 MinMaxLuminance()
     return minMaxLuminance;
 }
 
+FfxInt32x2 InputColorOffset()
+{
+    return iInputColorOffset;
+}
+
 FfxBoolean CrossedSceneChangeThreshold(FfxFloat32 sceneChangeValue)
 {
     return sceneChangeValue > 0.45f;
@@ -80,7 +80,7 @@ void PrepareLuma(FfxInt32x2 iGlobalId, FfxInt32 iLocalIndex)
             FfxInt32x2 iPxHrPos = pos;
             FfxFloat32 fY = 0.0;
 
-            FfxFloat32x3 inputColor = LoadInputColor(iPxHrPos).rgb;
+            FfxFloat32x3 inputColor = LoadInputColor(iPxHrPos + InputColorOffset()).rgb; // DLSSG-TO-FSR3: Active region only
 
             FfxUInt32 backbufferTransferFunction = BackbufferTransferFunction();
             if (backbufferTransferFunction == 0)
@@ -365,6 +365,133 @@ struct FfxSwapchainReplacementFunctions
 };
 FFX_API FfxErrorCode ffxGetSwapchainReplacementFunctionsVK(FfxDevice device, FfxSwapchainReplacementFunctions* functions);
 
+/// DLSSG-TO-FSR3: GPU execution time of a single pass, aggregated over a window of submissions.
+///
+/// @ingroup VKBackend
+typedef struct FfxGpuPassTimingVK
+{
+    const wchar_t*  name;                   ///< Job label, or the pipeline name for unlabeled dispatches. Only valid during the callback.
+    uint32_t        sampleCount;            ///< Number of times the pass was measured in this window.
+    double          minMilliseconds;
+    double          avgMilliseconds;
+    double          maxMilliseconds;
+} FfxGpuPassTimingVK;
+
+/// DLSSG-TO-FSR3: Receives pass timings once per window. Called from within <c><i>fpExecuteGpuJobs</i></c>.
+///
+/// @param [in] timings                     An array of <c><i>timingCount</i></c> pass timings in first seen order.
+/// @param [in] timingCount                 The number of elements in <c><i>timings</i></c>.
+/// @param [in] droppedSubmissions          Submissions in this window that weren't measured, either because every query slot was still in flight or because their queries never became available.
+/// @param [in] userData                    The pointer passed to <c><i>ffxSetGpuPassTimingCallbackVK</i></c>.
+///
+/// @ingroup VKBackend
+typedef void (*FfxGpuPassTimingCallbackVK)(const FfxGpuPassTimingVK* timings, uint32_t timingCount, uint32_t droppedSubmissions, void* userData);
+
+/// DLSSG-TO-FSR3: Measure every clear, copy and compute job executed by the backend with timestamp queries.
+///
+/// Queries are read back without waiting once the GPU has caught up, usually a few submissions later. The setting
+/// survives backend context destruction and may be applied before the first context is created.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [in] windowSize                  The number of resolved submissions aggregated before <c><i>callback</i></c> is invoked.
+/// @param [in] callback                    The function receiving pass timings, or <c><i>NULL</i></c> to stop measuring.
+/// @param [in] userData                    An opaque pointer forwarded to <c><i>callback</i></c>.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+/// @retval
+/// FFX_ERROR_BACKEND_API_ERROR             The device doesn't support timestamps on compute queues.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxSetGpuPassTimingCallbackVK(
+    FfxInterface* backendInterface,
+    uint32_t windowSize,
+    FfxGpuPassTimingCallbackVK callback,
+    void* userData);
+
+/// DLSSG-TO-FSR3: Create compute pipelines through an application provided pipeline cache.
+///
+/// Vulkan pipeline caches are internally synchronized, so one cache may be shared by several backend interfaces on
+/// the same device. The setting survives backend context destruction and should be applied before the first context
+/// is created. The cache must outlive every pipeline creation made through <c><i>backendInterface</i></c>.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [in] pipelineCache               The cache to use, or <c><i>VK_NULL_HANDLE</i></c> for none.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxSetPipelineCacheVK(FfxInterface* backendInterface, VkPipelineCache pipelineCache);
+
+/// DLSSG-TO-FSR3: Device memory held by the internal resources of every effect context of a backend interface.
+///
+/// Unlike <c><i>FfxEffectMemoryUsage</i></c>, sizes are counted per <c><i>VkDeviceMemory</i></c>. Block sizes include
+/// free space and empty blocks kept for reuse.
+typedef struct FfxDeviceMemoryStatsVK
+{
+    uint32_t    blockCount;                 ///< Shared blocks internal resources are sub-allocated from.
+    uint32_t    blockAllocationCount;       ///< Resources placed in those blocks.
+    uint64_t    blockSize;                  ///< Total size of every block.
+    uint64_t    blockUsedSize;              ///< Part of <c><i>blockSize</i></c> reserved for resources, alignment included.
+    uint32_t    dedicatedAllocationCount;   ///< Resources with a <c><i>VkDeviceMemory</i></c> of their own.
+    uint64_t    dedicatedAllocationSize;    ///< Total size of those allocations.
+} FfxDeviceMemoryStatsVK;
+
+/// DLSSG-TO-FSR3: Query the device memory held by a backend interface.
+///
+/// Calls must be externally synchronized with every other use of <c><i>backendInterface</i></c>.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [out] outStats                   The statistics. Zeroed when no effect context exists.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> or <c><i>outStats</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxGetDeviceMemoryStatsVK(FfxInterface* backendInterface, FfxDeviceMemoryStatsVK* outStats);
+
+/// DLSSG-TO-FSR3: Let pipelines push their descriptors with VK_KHR_push_descriptor instead of allocating sets.
+///
+/// Only enable this when the application is known to have enabled VK_KHR_push_descriptor on the device. Support
+/// reported by the physical device isn't enough. The setting survives backend context destruction and has to be applied
+/// before the first context is created. Disabled by default.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [in] enabled                     Whether push descriptors may be used.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxSetPushDescriptorsEnabledVK(FfxInterface* backendInterface, bool enabled);
+
+/// DLSSG-TO-FSR3: Stop reusing cached image views of an application image.
+///
+/// Views created for resources passed to <c><i>fpRegisterResource</i></c> are cached across frames and matched by image
+/// handle, resource description and view parameters. Call this when <c><i>image</i></c> may have been destroyed and its
+/// handle reused for a new image with an identical description. Views the GPU may still reference are destroyed later.
+/// Calls must be externally synchronized with every other use of <c><i>backendInterface</i></c>.
+///
+/// @param [in] backendInterface            A pointer to a <c><i>FfxInterface</i></c> populated by <c><i>ffxGetInterfaceVK</i></c>.
+/// @param [in] image                       The application image, or <c><i>VK_NULL_HANDLE</i></c> for every cached view.
+///
+/// @retval
+/// FFX_OK                                  The operation completed successfully.
+/// @retval
+/// FFX_ERROR_INVALID_POINTER               The <c><i>backendInterface</i></c> pointer was <c><i>NULL</i></c>.
+///
+/// @ingroup VKBackend
+FFX_API FfxErrorCode ffxInvalidateImageViewsVK(FfxInterface* backendInterface, VkImage image);
+
 #if defined(__cplusplus)
 }
 #endif // #if defined(__cplusplus)
@@ -51,8 +51,15 @@
 
 /// The size of the context specified in 32bit values.
 ///
+/// DLSSG-TO-FSR3: Doubled where wchar_t is 4 bytes. The resource and binding names in the private context would not
+/// fit otherwise. Only host-side test builds are affected.
+///
 /// @ingroup FRAMEINTERPOLATIONFRAMEINTERPOLATION
+#if defined(_WIN32)
 #define FFX_FRAMEINTERPOLATION_CONTEXT_SIZE (FFX_SDK_DEFAULT_CONTEXT_SIZE)
+#else
+#define FFX_FRAMEINTERPOLATION_CONTEXT_SIZE (FFX_SDK_DEFAULT_CONTEXT_SIZE * 2)
+#endif
 
 #if defined(__cplusplus)
 extern "C" {
@@ -234,6 +241,7 @@ typedef enum FfxFrameInterpolationDispatchFlags
     FFX_FRAMEINTERPOLATION_DISPATCH_DRAW_DEBUG_RESET_INDICATORS = (1 << 1),  ///< A bit indicating that the debug reset indicators will be drawn to the generated output.
     FFX_FRAMEINTERPOLATION_DISPATCH_DRAW_DEBUG_VIEW             = (1 << 2),  ///< A bit indicating that the interpolated output resource will contain debug views with relevant information.
     FFX_FRAMEINTERPOLATION_DISPATCH_DRAW_DEBUG_PACING_LINES     = (1 << 3),  ///< A bit indicating that the debug pacing lines will be drawn to the generated output.
+    FFX_FRAMEINTERPOLATION_DISPATCH_SKIP_STORE_INTERPOLATION_SOURCE = (1 << 4), ///< DLSSG-TO-FSR3: A bit indicating that more frames will be generated between the same pair of source frames, so the current interpolation source must not be stored as the previous one yet.
 } FfxFrameInterpolationDispatchFlags;
 
 typedef struct FfxFrameInterpolationDispatchDescription {
@@ -271,6 +279,8 @@ typedef struct FfxFrameInterpolationDispatchDescription {
     FfxResource                         reconstructedPrevDepth;             ///< The reconstructed depth buffer data
 
     FfxResource                         distortionField;                    ///< A resource containing distortion offset data used when distortion post effects are enabled.
+
+    float                               interpolationFactor;                ///< DLSSG-TO-FSR3: Position of the generated frame between the previous (0) and current (1) frame. Values outside of (0, 1) select the midpoint.
 } FfxFrameInterpolationDispatchDescription;
 
 FFX_API FfxErrorCode ffxFrameInterpolationDispatch(FfxFrameInterpolationContext* context, const FfxFrameInterpolationDispatchDescription* params);
@@ -372,6 +372,12 @@ typedef FfxErrorCode (*FfxStageConstantBufferDataFunc)(
 /// A rendering pipeline contains the shader as well as resource bindpoints
 /// and samplers.
 ///
+/// DLSSG-TO-FSR3: May be called from several threads at once, for different
+/// outPipeline destinations of the same effect context, by
+/// ffxCreatePipelinesParallel. Implementations must be thread-safe: anything
+/// beyond outPipeline that they modify, such as caches or descriptor set
+/// layout pools, needs its own synchronization.
+///
 /// @param [in] backendInterface                    A pointer to the backend interface.
 /// @param [in] pass                                The identifier for the pass.
 /// @param [in] pipelineDescription                 A pointer to a <c><i>FfxPipelineDescription</i></c> describing the pipeline to be created.
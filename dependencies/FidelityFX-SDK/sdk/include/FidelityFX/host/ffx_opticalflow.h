@@ -108,6 +108,7 @@ typedef struct FfxOpticalflowDispatchDescription
     bool             reset;             ///< A boolean value which when set to true, indicates the camera has moved discontinuously.
     int              backbufferTransferFunction;
     FfxFloatCoords2D minMaxLuminance;
+    FfxIntCoords2D   colorOffset;       ///< DLSSG-TO-FSR3: Top left corner of the region in <c><i>color</i></c> to process. The region size is taken from the color description.
 } FfxOpticalflowDispatchDescription;
 
 typedef struct FfxOpticalflowSharedResourceDescriptions {
@@ -2393,6 +2393,8 @@ FfxErrorCode CreatePipelineDX12(
     FFX_ASSERT(NULL != backendInterface);
     FFX_ASSERT(NULL != pipelineDescription);
 
+    // DLSSG-TO-FSR3: Called concurrently by ffxCreatePipelinesParallel. Only outPipeline is written. The backend and
+    // effect contexts are only read, ID3D12Device is free-threaded and the permutation tables are constant.
     BackendContext_DX12* backendContext = (BackendContext_DX12*)backendInterface->scratchBuffer;
     ID3D12Device* dx12Device = backendContext->device;
 
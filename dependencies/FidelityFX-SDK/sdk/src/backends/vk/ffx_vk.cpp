@@ -26,6 +26,7 @@
 #include <FidelityFX/host/backends/vk/ffx_vk.h>
 #include <ffx_shader_blobs.h>
 #include <ffx_breadcrumbs_list.h>
+#include "ffx_vk_memory_block.h" // DLSSG-TO-FSR3
 
 #ifdef _WIN32
 #include <windows.h>
@@ -68,12 +69,32 @@ static VkDeviceContext sVkDeviceContext = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_N
 #define MAX_DESCRIPTOR_SET_LAYOUTS        (64)
 #define FFX_MAX_BINDLESS_DESCRIPTOR_COUNT (65536)
 
+// DLSSG-TO-FSR3: GPU pass timing limits. Each ExecuteGpuJobs call claims one slot of begin/end query pairs.
+#define FFX_GPU_PASS_TIMING_SLOT_COUNT    (16)
+#define FFX_GPU_PASS_TIMING_MAX_JOBS      (64)
+#define FFX_GPU_PASS_TIMING_MAX_PASSES    (64)
+#define FFX_GPU_PASS_TIMING_LATENCY       (4)  // Submissions before a slot is polled
+#define FFX_GPU_PASS_TIMING_MAX_AGE       (64) // Submissions before a slot that never became available is reset anyway
+
+// DLSSG-TO-FSR3: Image views kept per effect context for registered resources
+#define FFX_IMAGE_VIEW_CACHE_SIZE         (64)
+
+// DLSSG-TO-FSR3: Device memory sub-allocation. Resources larger than half a block get their own allocation.
+#define FFX_MEMORY_BLOCK_SIZE             (64ull * 1024 * 1024)
+#define FFX_MAX_MEMORY_BLOCKS             (32)
+
 // Constant buffer allocation callback
 static FfxConstantBufferAllocator s_fpConstantAllocator = nullptr;
 
 // Offset the binding of samplers to avoid collisions
 constexpr uint32_t SAMPLER_BINDING_SHIFT = 1000;
 
+// DLSSG-TO-FSR3: Descriptor data filled in by executeGpuJobCompute. Push descriptor update templates point into it.
+typedef struct DescriptorInfos {
+    VkDescriptorImageInfo  image[FFX_MAX_RESOURCE_COUNT];
+    VkDescriptorBufferInfo buffer[FFX_MAX_RESOURCE_COUNT];
+} DescriptorInfos;
+
 typedef struct BackendContext_VK {
 
     // store for resources and resourceViews
@@ -97,6 +118,9 @@ typedef struct BackendContext_VK {
         VkDeviceMemory          deviceMemory;
         VkDeviceSize            allocationSize;
         VkMemoryPropertyFlags   memoryProperties;
+        int32_t                 memoryBlockIndex;   // DLSSG-TO-FSR3: -1 when deviceMemory is owned by the resource
+        VkDeviceSize            memoryOffset;       // DLSSG-TO-FSR3
+        VkDeviceSize            memoryRangeSize;    // DLSSG-TO-FSR3: Part of the block reserved for the resource
 
         bool                    undefined;
         bool                    dynamic;
@@ -114,6 +138,11 @@ typedef struct BackendContext_VK {
         int32_t                 staticBufferSrvSet;
         int32_t                 staticTextureUavSet;
         int32_t                 staticBufferUavSet;
+
+        // DLSSG-TO-FSR3: Set 0 is pushed rather than allocated. The template covers the case where no binding is null.
+        bool                        pushDescriptors;
+        VkDescriptorUpdateTemplate  descriptorUpdateTemplate;
+        uint32_t                    descriptorUpdateTemplateEntryCount;
     } PipelineLayout;
 
     typedef struct VKFunctionTable
@@ -143,6 +172,7 @@ typedef struct BackendContext_VK {
         PFN_vkGetBufferMemoryRequirements       vkGetBufferMemoryRequirements = 0;
         PFN_vkGetBufferMemoryRequirements2KHR   vkGetBufferMemoryRequirements2KHR = 0;
         PFN_vkGetImageMemoryRequirements        vkGetImageMemoryRequirements = 0;
+        PFN_vkGetImageMemoryRequirements2KHR    vkGetImageMemoryRequirements2KHR = 0;       // DLSSG-TO-FSR3
         PFN_vkAllocateDescriptorSets            vkAllocateDescriptorSets = 0;
         PFN_vkFreeDescriptorSets                vkFreeDescriptorSets = 0;
         PFN_vkAllocateMemory                    vkAllocateMemory = 0;
@@ -167,6 +197,15 @@ typedef struct BackendContext_VK {
         PFN_vkCmdWriteBufferMarker2AMD          vkCmdWriteBufferMarker2AMD = 0;
         PFN_vkCmdBeginDebugUtilsLabelEXT        vkCmdBeginDebugUtilsLabelEXT = 0;
         PFN_vkCmdEndDebugUtilsLabelEXT          vkCmdEndDebugUtilsLabelEXT = 0;
+        PFN_vkCreateQueryPool                   vkCreateQueryPool = 0;          // DLSSG-TO-FSR3
+        PFN_vkDestroyQueryPool                  vkDestroyQueryPool = 0;         // DLSSG-TO-FSR3
+        PFN_vkCmdResetQueryPool                 vkCmdResetQueryPool = 0;        // DLSSG-TO-FSR3
+        PFN_vkCmdWriteTimestamp                 vkCmdWriteTimestamp = 0;        // DLSSG-TO-FSR3
+        PFN_vkGetQueryPoolResults               vkGetQueryPoolResults = 0;      // DLSSG-TO-FSR3
+        PFN_vkCreateDescriptorUpdateTemplate    vkCreateDescriptorUpdateTemplate = 0;       // DLSSG-TO-FSR3
+        PFN_vkDestroyDescriptorUpdateTemplate   vkDestroyDescriptorUpdateTemplate = 0;      // DLSSG-TO-FSR3
+        PFN_vkCmdPushDescriptorSetKHR           vkCmdPushDescriptorSetKHR = 0;              // DLSSG-TO-FSR3
+        PFN_vkCmdPushDescriptorSetWithTemplateKHR vkCmdPushDescriptorSetWithTemplateKHR = 0; // DLSSG-TO-FSR3
 
     } VkFunctionTable;
 
@@ -182,6 +221,7 @@ typedef struct BackendContext_VK {
 
     typedef struct VkResourceView {
         VkImageView imageView;
+        bool        cached;     // DLSSG-TO-FSR3: Owned by EffectContext::imageViewCache
     } VkResourceView;
     VkResourceView*         pResourceViews;
 
@@ -192,6 +232,7 @@ typedef struct BackendContext_VK {
 
     VkDescriptorPool        descriptorPool;
     uint32_t                bindlessBase;
+    uint32_t                maxPushDescriptors;     // DLSSG-TO-FSR3: Zero when VK_KHR_push_descriptor isn't enabled
 
     VkImageMemoryBarrier    imageMemoryBarriers[FFX_MAX_BARRIERS] = {};
     VkBufferMemoryBarrier   bufferMemoryBarriers[FFX_MAX_BARRIERS] = {};
@@ -200,6 +241,21 @@ typedef struct BackendContext_VK {
     VkPipelineStageFlags    srcStageMask = 0;
     VkPipelineStageFlags    dstStageMask = 0;
 
+    // DLSSG-TO-FSR3: Views of registered resources are reused across frames instead of being recreated every frame.
+    // An entry only matches the same image with the same full description and view parameters. Unused entries are destroyed
+    // after FFX_MAX_QUEUED_FRAMES frames, the same lifetime per-frame views had.
+    typedef struct CachedImageView {
+        VkImage                 image;
+        FfxResourceDescription  description;
+        VkImageViewType         viewType;
+        VkFormat                format;
+        VkImageSubresourceRange subresourceRange;
+        VkImageUsageFlags       usage;
+        VkImageView             imageView;
+        uint64_t                lastUsedFrame;
+        bool                    invalidated;    // See ffxInvalidateImageViewsVK
+    } CachedImageView;
+
     typedef struct alignas(32) EffectContext {
 
         // Effect identifier -- used for various resource callbacks to application
@@ -242,6 +298,10 @@ typedef struct BackendContext_VK {
         // VRAM usage
         FfxEffectMemoryUsage vramUsage;
 
+        // DLSSG-TO-FSR3: Views of registered resources
+        uint64_t              unregisteredFrameCount;
+        CachedImageView       imageViewCache[FFX_IMAGE_VIEW_CACHE_SIZE];
+
     } EffectContext;
 
     Resource*               pResources;
@@ -257,6 +317,20 @@ typedef struct BackendContext_VK {
     VkDeviceSize          uniformBufferSize      = 0;
     VkDeviceSize          uniformBufferOffset    = 0;
     std::mutex            uniformBufferMutex;
+    std::mutex            pipelineMutex;    // DLSSG-TO-FSR3: CreatePipelineVK may be called concurrently, see ffxCreatePipelinesParallel
+
+    // DLSSG-TO-FSR3: Blocks of device memory shared by the internal resources of all effect contexts
+    typedef struct MemoryBlock : FfxMemoryBlockRanges {
+        VkDeviceMemory  memory;
+        uint32_t        memoryTypeIndex;
+    } MemoryBlock;
+
+    VkPhysicalDeviceMemoryProperties    memoryProperties;
+    VkDeviceSize                        bufferImageGranularity;
+    bool                                dedicatedAllocationSupported;
+    MemoryBlock                         memoryBlocks[FFX_MAX_MEMORY_BLOCKS];
+    uint32_t                            dedicatedAllocationCount;   // Resources that own their VkDeviceMemory
+    VkDeviceSize                        dedicatedAllocationSize;
 
     uint32_t                numDeviceExtensions = 0;
     VkExtensionProperties*  extensionProperties = nullptr;
@@ -270,6 +344,62 @@ typedef struct BackendContext_VK {
     uint8_t                 breadcrumbsFlags = 0;
     uint32_t                breadcrumbsMemoryIndex = 0;
 
+    // DLSSG-TO-FSR3: Per-pass GPU timings
+    typedef struct GpuPassTimings
+    {
+        // Set by ffxSetGpuPassTimingCallbackVK and kept across resetBackendContext
+        typedef struct Config
+        {
+            FfxGpuPassTimingCallbackVK  callback;
+            void*                       userData;
+            uint32_t                    windowSize;
+        } Config;
+
+        // A slot's queries are reset in a command buffer recorded after its results were read. It's only claimed
+        // again once the GPU has executed that reset, which is when its queries read back as unavailable.
+        typedef enum SlotState
+        {
+            SLOT_STATE_FREE = 0,
+            SLOT_STATE_RECORDED,
+            SLOT_STATE_RESETTING,
+        } SlotState;
+
+        typedef struct Slot
+        {
+            SlotState   state;
+            uint64_t    submission;
+            uint32_t    jobCount;
+            uint8_t     passIndices[FFX_GPU_PASS_TIMING_MAX_JOBS];
+        } Slot;
+
+        typedef struct Pass
+        {
+            wchar_t     name[FFX_RESOURCE_NAME_SIZE];
+            uint32_t    sampleCount;
+            double      minMilliseconds;
+            double      maxMilliseconds;
+            double      sumMilliseconds;
+        } Pass;
+
+        Config          config;
+        VkQueryPool     queryPool;
+        float           timestampPeriod;        // Nanoseconds per tick
+        Slot            slots[FFX_GPU_PASS_TIMING_SLOT_COUNT];
+        uint32_t        nextSlot;
+        uint64_t        submissionCount;
+        Pass            passes[FFX_GPU_PASS_TIMING_MAX_PASSES];
+        uint32_t        passCount;
+        uint32_t        resolvedSubmissions;
+        uint32_t        droppedSubmissions;
+    } GpuPassTimings;
+    GpuPassTimings          gpuPassTimings;
+
+    // DLSSG-TO-FSR3: Set by ffxSetPipelineCacheVK and kept across resetBackendContext
+    VkPipelineCache         pipelineCache;
+
+    // DLSSG-TO-FSR3: Set by ffxSetPushDescriptorsEnabledVK and kept across resetBackendContext
+    bool                    pushDescriptorsEnabled;
+
 } BackendContext_VK;
 
 FFX_API size_t ffxGetScratchMemorySizeVK(VkPhysicalDevice physicalDevice, size_t maxContexts)
@@ -918,7 +1048,108 @@ FfxResourceDescription ffxGetImageResourceDescriptionVK(const VkImage
     return resourceDescription;
 }
 
-FfxErrorCode allocateDeviceMemory(BackendContext_VK* backendContext, VkMemoryRequirements memRequirements, VkMemoryPropertyFlags requiredMemoryProperties, BackendContext_VK::Resource* backendResource)
+// DLSSG-TO-FSR3: Also reports whether the driver asks for the resource to get its own allocation
+void getResourceMemoryRequirements(BackendContext_VK* backendContext, const BackendContext_VK::Resource* backendResource, VkMemoryRequirements& outRequirements, bool& outDedicated)
+{
+    const bool isBuffer = backendResource->resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER;
+    outDedicated = false;
+
+    if (!backendContext->dedicatedAllocationSupported) {
+        if (isBuffer)
+            backendContext->vkFunctionTable.vkGetBufferMemoryRequirements(backendContext->device, backendResource->bufferResource, &outRequirements);
+        else
+            backendContext->vkFunctionTable.vkGetImageMemoryRequirements(backendContext->device, backendResource->imageResource, &outRequirements);
+        return;
+    }
+
+    VkMemoryDedicatedRequirements dedicatedRequirements = {};
+    dedicatedRequirements.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS;
+
+    VkMemoryRequirements2 memoryRequirements2 = {};
+    memoryRequirements2.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+    memoryRequirements2.pNext = &dedicatedRequirements;
+
+    if (isBuffer) {
+        VkBufferMemoryRequirementsInfo2 bufferInfo = {};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2;
+        bufferInfo.buffer = backendResource->bufferResource;
+        backendContext->vkFunctionTable.vkGetBufferMemoryRequirements2KHR(backendContext->device, &bufferInfo, &memoryRequirements2);
+    }
+    else {
+        VkImageMemoryRequirementsInfo2 imageInfo = {};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2;
+        imageInfo.image = backendResource->imageResource;
+        backendContext->vkFunctionTable.vkGetImageMemoryRequirements2KHR(backendContext->device, &imageInfo, &memoryRequirements2);
+    }
+
+    outRequirements = memoryRequirements2.memoryRequirements;
+    outDedicated = dedicatedRequirements.requiresDedicatedAllocation || dedicatedRequirements.prefersDedicatedAllocation;
+}
+
+// DLSSG-TO-FSR3: See ffxMemoryBlockAllocate
+bool allocateFromMemoryBlock(BackendContext_VK::MemoryBlock& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize granularity, BackendContext_VK::Resource* backendResource)
+{
+    uint64_t offset = 0;
+    uint64_t rangeSize = 0;
+
+    if (!ffxMemoryBlockAllocate(block, size, alignment, granularity, &offset, &rangeSize))
+        return false;
+
+    backendResource->deviceMemory = block.memory;
+    backendResource->memoryOffset = offset;
+    backendResource->memoryRangeSize = rangeSize;
+    return true;
+}
+
+// DLSSG-TO-FSR3
+bool suballocateDeviceMemory(BackendContext_VK* backendContext, VkMemoryRequirements memRequirements, uint32_t memoryTypeIndex, VkDeviceSize blockSize, BackendContext_VK::Resource* backendResource)
+{
+    const VkDeviceSize granularity = FFX_MAXIMUM(backendContext->bufferImageGranularity, VkDeviceSize(1));
+    const VkDeviceSize alignment = FFX_MAXIMUM(memRequirements.alignment, granularity);
+    int32_t unusedBlockIndex = -1;
+
+    for (int32_t i = 0; i < FFX_MAX_MEMORY_BLOCKS; ++i)
+    {
+        BackendContext_VK::MemoryBlock& block = backendContext->memoryBlocks[i];
+
+        if (block.memory == VK_NULL_HANDLE) {
+            if (unusedBlockIndex < 0)
+                unusedBlockIndex = i;
+            continue;
+        }
+
+        if (block.memoryTypeIndex == memoryTypeIndex && allocateFromMemoryBlock(block, memRequirements.size, alignment, granularity, backendResource)) {
+            backendResource->memoryBlockIndex = i;
+            return true;
+        }
+    }
+
+    if (unusedBlockIndex < 0)
+        return false;
+
+    BackendContext_VK::MemoryBlock& block = backendContext->memoryBlocks[unusedBlockIndex];
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = blockSize;
+    allocInfo.memoryTypeIndex = memoryTypeIndex;
+
+    if (backendContext->vkFunctionTable.vkAllocateMemory(backendContext->device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) {
+        block.memory = VK_NULL_HANDLE;
+        return false;
+    }
+
+    ffxMemoryBlockReset(block, blockSize);
+    block.memoryTypeIndex = memoryTypeIndex;
+
+    if (!allocateFromMemoryBlock(block, memRequirements.size, alignment, granularity, backendResource))
+        return false;
+
+    backendResource->memoryBlockIndex = unusedBlockIndex;
+    return true;
+}
+
+FfxErrorCode allocateDeviceMemory(BackendContext_VK* backendContext, VkMemoryRequirements memRequirements, VkMemoryPropertyFlags requiredMemoryProperties, bool dedicated, BackendContext_VK::Resource* backendResource)
 {
     VkMemoryAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
@@ -929,6 +1160,32 @@ FfxErrorCode allocateDeviceMemory(BackendContext_VK* backendContext, VkMemoryReq
         return FFX_ERROR_BACKEND_API_ERROR;
     }
 
+    // DLSSG-TO-FSR3: Sub-allocate where possible. Host visible memory is excluded since a block can only be mapped once
+    // at a time. Small heaps get smaller blocks.
+    backendResource->memoryBlockIndex = -1;
+    backendResource->memoryOffset = 0;
+    backendResource->memoryRangeSize = memRequirements.size;
+
+    const uint32_t heapIndex = backendContext->memoryProperties.memoryTypes[allocInfo.memoryTypeIndex].heapIndex;
+    const VkDeviceSize blockSize = FFX_MINIMUM(FFX_MEMORY_BLOCK_SIZE, backendContext->memoryProperties.memoryHeaps[heapIndex].size / 8);
+
+    if (!dedicated && (backendResource->memoryProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0 && memRequirements.size <= blockSize / 2) {
+        if (suballocateDeviceMemory(backendContext, memRequirements, allocInfo.memoryTypeIndex, blockSize, backendResource))
+            return FFX_OK;
+    }
+
+    VkMemoryDedicatedAllocateInfo dedicatedAllocInfo = {};
+    dedicatedAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO;
+
+    if (dedicated) {
+        if (backendResource->resourceDescription.type == FFX_RESOURCE_TYPE_BUFFER)
+            dedicatedAllocInfo.buffer = backendResource->bufferResource;
+        else
+            dedicatedAllocInfo.image = backendResource->imageResource;
+
+        allocInfo.pNext = &dedicatedAllocInfo;
+    }
+
     VkResult result = backendContext->vkFunctionTable.vkAllocateMemory(backendContext->device, &allocInfo, nullptr, &backendResource->deviceMemory);
 
     if (result != VK_SUCCESS) {
@@ -941,9 +1198,53 @@ FfxErrorCode allocateDeviceMemory(BackendContext_VK* backendContext, VkMemoryReq
         }
     }
 
+    backendContext->dedicatedAllocationCount++;
+    backendContext->dedicatedAllocationSize += memRequirements.size;
+
     return FFX_OK;
 }
 
+// DLSSG-TO-FSR3: Returns the range to its block and merges it with free neighbours. Empty blocks are kept until
+// releaseMemoryBlocks so that resources recreated on resize land in the same memory.
+void freeDeviceMemory(BackendContext_VK* backendContext, BackendContext_VK::Resource* backendResource)
+{
+    if (backendResource->memoryBlockIndex < 0) {
+        backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, backendResource->deviceMemory, nullptr);
+        backendResource->deviceMemory = VK_NULL_HANDLE;
+
+        FFX_ASSERT(backendContext->dedicatedAllocationCount > 0);
+        backendContext->dedicatedAllocationCount--;
+        backendContext->dedicatedAllocationSize -= backendResource->memoryRangeSize;
+        return;
+    }
+
+    BackendContext_VK::MemoryBlock& block = backendContext->memoryBlocks[backendResource->memoryBlockIndex];
+
+    FFX_ASSERT(block.allocationCount > 0);
+    ffxMemoryBlockFree(block, backendResource->memoryOffset, backendResource->memoryRangeSize);
+
+    backendResource->deviceMemory = VK_NULL_HANDLE;
+    backendResource->memoryBlockIndex = -1;
+}
+
+// DLSSG-TO-FSR3: Gives empty blocks back to the driver. Remaining resources can't be moved, so this is as far as
+// compaction goes. releaseAll is for the last context going away.
+void releaseMemoryBlocks(BackendContext_VK* backendContext, bool releaseAll)
+{
+    for (uint32_t i = 0; i < FFX_MAX_MEMORY_BLOCKS; ++i)
+    {
+        BackendContext_VK::MemoryBlock& block = backendContext->memoryBlocks[i];
+
+        if (block.memory == VK_NULL_HANDLE || (block.allocationCount > 0 && !releaseAll))
+            continue;
+
+        backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, block.memory, nullptr);
+        block.memory = VK_NULL_HANDLE;
+        block.allocationCount = 0;
+        block.freeRangeCount = 0;
+    }
+}
+
 void setVKObjectName(BackendContext_VK::VKFunctionTable& vkFunctionTable, VkDevice device, VkObjectType objectType, uint64_t object, char* name)
 {
     VkDebugUtilsObjectNameInfoEXT s{ VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT, nullptr, objectType, object, name };
@@ -972,12 +1273,98 @@ void destroyDynamicViews(BackendContext_VK* backendContext, uint32_t effectConte
     for (uint32_t dynamicViewIndex = effectContext.nextDynamicResourceView[frameIndex] + 1; dynamicViewIndex <= dynamicResourceViewIndexStart;
          ++dynamicViewIndex)
     {
-        backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[dynamicViewIndex].imageView, VK_NULL_HANDLE);
+        if (!backendContext->pResourceViews[dynamicViewIndex].cached) // DLSSG-TO-FSR3
+            backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, backendContext->pResourceViews[dynamicViewIndex].imageView, VK_NULL_HANDLE);
         backendContext->pResourceViews[dynamicViewIndex].imageView = VK_NULL_HANDLE;
+        backendContext->pResourceViews[dynamicViewIndex].cached = false;
     }
     effectContext.nextDynamicResourceView[frameIndex] = dynamicResourceViewIndexStart;
 }
 
+// DLSSG-TO-FSR3: Returns a view from the image view cache, creating it if needed. Views that don't fit in the cache are
+// owned by the dynamic view slot and destroyed with it.
+VkResult acquireDynamicImageView(BackendContext_VK* backendContext, uint32_t effectContextId, const FfxResourceDescription& description,
+                                 const VkImageViewCreateInfo& createInfo, BackendContext_VK::VkResourceView& outView)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+    BackendContext_VK::CachedImageView* freeEntry = nullptr;
+
+    // addMutableViewForSRV is the only source of extension structures
+    const VkImageUsageFlags usage = createInfo.pNext ? static_cast<const VkImageViewUsageCreateInfo*>(createInfo.pNext)->usage : 0;
+
+    for (uint32_t i = 0; i < FFX_IMAGE_VIEW_CACHE_SIZE; ++i)
+    {
+        BackendContext_VK::CachedImageView& entry = effectContext.imageViewCache[i];
+
+        if (entry.imageView == VK_NULL_HANDLE)
+        {
+            if (!freeEntry)
+                freeEntry = &entry;
+
+            continue;
+        }
+
+        if (entry.invalidated || entry.image != createInfo.image)
+            continue;
+
+        // Every field of the image's description, flags included, has to match
+        if (memcmp(&entry.description, &description, sizeof(FfxResourceDescription)) != 0)
+            continue;
+
+        if (entry.viewType != createInfo.viewType || entry.format != createInfo.format || entry.usage != usage ||
+            memcmp(&entry.subresourceRange, &createInfo.subresourceRange, sizeof(VkImageSubresourceRange)) != 0)
+            continue;
+
+        entry.lastUsedFrame = effectContext.unregisteredFrameCount;
+        outView.imageView = entry.imageView;
+        outView.cached = true;
+
+        return VK_SUCCESS;
+    }
+
+    const VkResult result = backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &createInfo, NULL, &outView.imageView);
+
+    if (result != VK_SUCCESS)
+        return result;
+
+    outView.cached = freeEntry != nullptr;
+
+    if (freeEntry)
+    {
+        freeEntry->image = createInfo.image;
+        freeEntry->description = description;
+        freeEntry->viewType = createInfo.viewType;
+        freeEntry->format = createInfo.format;
+        freeEntry->subresourceRange = createInfo.subresourceRange;
+        freeEntry->usage = usage;
+        freeEntry->imageView = outView.imageView;
+        freeEntry->lastUsedFrame = effectContext.unregisteredFrameCount;
+        freeEntry->invalidated = false;
+    }
+
+    return VK_SUCCESS;
+}
+
+// DLSSG-TO-FSR3: Destroys cached views the GPU can no longer reference, or all of them
+void evictCachedImageViews(BackendContext_VK* backendContext, uint32_t effectContextId, bool evictAll)
+{
+    BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
+
+    for (uint32_t i = 0; i < FFX_IMAGE_VIEW_CACHE_SIZE; ++i)
+    {
+        BackendContext_VK::CachedImageView& entry = effectContext.imageViewCache[i];
+
+        if (entry.imageView == VK_NULL_HANDLE)
+            continue;
+
+        if (!evictAll && effectContext.unregisteredFrameCount - entry.lastUsedFrame < FFX_MAX_QUEUED_FRAMES)
+            continue;
+
+        backendContext->vkFunctionTable.vkDestroyImageView(backendContext->device, entry.imageView, VK_NULL_HANDLE);
+        memset(&entry, 0, sizeof(entry));
+    }
+}
+
 VkAccessFlags getVKAccessFlagsFromResourceState(FfxResourceStates state)
 {
     switch (state) {
@@ -1346,11 +1733,44 @@ void resetBackendContext(BackendContext_VK* backendContext)
 {
     // reset the context except the maxEffectContexts in case the memory is reused for a new context
     uint32_t maxEffectContexts = backendContext->maxEffectContexts;
+    BackendContext_VK::GpuPassTimings::Config gpuPassTimingConfig = backendContext->gpuPassTimings.config; // DLSSG-TO-FSR3
+    VkPipelineCache pipelineCache = backendContext->pipelineCache; // DLSSG-TO-FSR3
+    bool pushDescriptorsEnabled = backendContext->pushDescriptorsEnabled; // DLSSG-TO-FSR3
 
     memset(backendContext, 0, sizeof(BackendContext_VK));
 
     // restore the maxEffectContexts
     backendContext->maxEffectContexts = maxEffectContexts;
+    backendContext->gpuPassTimings.config = gpuPassTimingConfig; // DLSSG-TO-FSR3
+    backendContext->pipelineCache = pipelineCache; // DLSSG-TO-FSR3
+    backendContext->pushDescriptorsEnabled = pushDescriptorsEnabled; // DLSSG-TO-FSR3
+}
+
+// DLSSG-TO-FSR3: Split out of CreateBackendContextVK
+FfxErrorCode createDescriptorPoolVK(BackendContext_VK* backendContext)
+{
+    VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
+    VkDescriptorPoolSize poolSizes[] = {
+        { VK_DESCRIPTOR_TYPE_SAMPLER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
+        { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
+        { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
+        { VK_DESCRIPTOR_TYPE_SAMPLER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
+    };
+
+    descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptorPoolCreateInfo.pNext = nullptr;
+    descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    descriptorPoolCreateInfo.poolSizeCount = 5;
+    descriptorPoolCreateInfo.pPoolSizes = poolSizes;
+    descriptorPoolCreateInfo.maxSets = backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * MAX_PIPELINE_USAGE_PER_FRAME * FFX_MAX_QUEUED_FRAMES;
+
+    if (backendContext->vkFunctionTable.vkCreateDescriptorPool(backendContext->device, &descriptorPoolCreateInfo, nullptr, &backendContext->descriptorPool) != VK_SUCCESS) {
+        return FFX_ERROR_BACKEND_API_ERROR;
+    }
+
+    return FFX_OK;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -1392,6 +1812,7 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         resetBackendContext(backendContext);
 
         new (&backendContext->uniformBufferMutex) std::mutex();
+        new (&backendContext->pipelineMutex) std::mutex(); // DLSSG-TO-FSR3
 
         // Map all of our pointers
         uint32_t gpuJobDescArraySize   = FFX_ALIGN_UP(backendContext->maxEffectContexts * FFX_MAX_GPU_JOBS * sizeof(FfxGpuJobDescription), sizeof(uint32_t));
@@ -1479,6 +1900,8 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         backendContext->vkFunctionTable.vkGetBufferMemoryRequirements2KHR = (PFN_vkGetBufferMemoryRequirements2KHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkGetBufferMemoryRequirements2KHR");
         if (!backendContext->vkFunctionTable.vkGetBufferMemoryRequirements2KHR) backendContext->vkFunctionTable.vkGetBufferMemoryRequirements2KHR = (PFN_vkGetBufferMemoryRequirements2KHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkGetBufferMemoryRequirements2");
         backendContext->vkFunctionTable.vkGetImageMemoryRequirements = (PFN_vkGetImageMemoryRequirements)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkGetImageMemoryRequirements");
+        backendContext->vkFunctionTable.vkGetImageMemoryRequirements2KHR = (PFN_vkGetImageMemoryRequirements2KHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkGetImageMemoryRequirements2KHR");
+        if (!backendContext->vkFunctionTable.vkGetImageMemoryRequirements2KHR) backendContext->vkFunctionTable.vkGetImageMemoryRequirements2KHR = (PFN_vkGetImageMemoryRequirements2KHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkGetImageMemoryRequirements2");
         backendContext->vkFunctionTable.vkAllocateDescriptorSets = (PFN_vkAllocateDescriptorSets)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkAllocateDescriptorSets");
         backendContext->vkFunctionTable.vkFreeDescriptorSets = (PFN_vkFreeDescriptorSets)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkFreeDescriptorSets");
         backendContext->vkFunctionTable.vkAllocateMemory = (PFN_vkAllocateMemory)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkAllocateMemory");
@@ -1502,32 +1925,77 @@ FfxErrorCode CreateBackendContextVK(FfxInterface* backendInterface, FfxEffect ef
         backendContext->vkFunctionTable.vkCmdWriteBufferMarker2AMD = (PFN_vkCmdWriteBufferMarker2AMD)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdWriteBufferMarker2AMD");
         backendContext->vkFunctionTable.vkCmdBeginDebugUtilsLabelEXT = (PFN_vkCmdBeginDebugUtilsLabelEXT)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdBeginDebugUtilsLabelEXT");
         backendContext->vkFunctionTable.vkCmdEndDebugUtilsLabelEXT = (PFN_vkCmdEndDebugUtilsLabelEXT)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdEndDebugUtilsLabelEXT");
+        backendContext->vkFunctionTable.vkCreateQueryPool = (PFN_vkCreateQueryPool)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCreateQueryPool");
+        backendContext->vkFunctionTable.vkDestroyQueryPool = (PFN_vkDestroyQueryPool)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkDestroyQueryPool");
+        backendContext->vkFunctionTable.vkCmdResetQueryPool = (PFN_vkCmdResetQueryPool)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdResetQueryPool");
+        backendContext->vkFunctionTable.vkCmdWriteTimestamp = (PFN_vkCmdWriteTimestamp)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdWriteTimestamp");
+        backendContext->vkFunctionTable.vkGetQueryPoolResults = (PFN_vkGetQueryPoolResults)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkGetQueryPoolResults");
 
         // enumerate all the device extensions
         backendContext->numDeviceExtensions = 0;
         vkEnumerateDeviceExtensionProperties(backendContext->physicalDevice, nullptr, &backendContext->numDeviceExtensions, nullptr);
         vkEnumerateDeviceExtensionProperties(backendContext->physicalDevice, nullptr, &backendContext->numDeviceExtensions, backendContext->extensionProperties);
 
-        // create a global descriptor pool to hold all descriptors we'll need
-        VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
-        VkDescriptorPoolSize poolSizes[] = {
-            { VK_DESCRIPTOR_TYPE_SAMPLER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_SAMPLER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-            { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, backendContext->maxEffectContexts * FFX_MAX_RESOURCE_COUNT * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME },
-        };
+        // DLSSG-TO-FSR3: Push descriptors need VK_KHR_push_descriptor enabled on the device. Neither the extension list
+        // nor resolved entry points prove that, so the application has to opt in. Update templates are core in 1.1.
+        backendContext->vkFunctionTable.vkCreateDescriptorUpdateTemplate = (PFN_vkCreateDescriptorUpdateTemplate)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCreateDescriptorUpdateTemplate");
+        backendContext->vkFunctionTable.vkDestroyDescriptorUpdateTemplate = (PFN_vkDestroyDescriptorUpdateTemplate)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkDestroyDescriptorUpdateTemplate");
+        backendContext->vkFunctionTable.vkCmdPushDescriptorSetKHR = (PFN_vkCmdPushDescriptorSetKHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdPushDescriptorSetKHR");
+        backendContext->vkFunctionTable.vkCmdPushDescriptorSetWithTemplateKHR = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCmdPushDescriptorSetWithTemplateKHR");
 
-        descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        descriptorPoolCreateInfo.pNext = nullptr;
-        descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-        descriptorPoolCreateInfo.poolSizeCount = 5;
-        descriptorPoolCreateInfo.pPoolSizes = poolSizes;
-        descriptorPoolCreateInfo.maxSets = backendContext->maxEffectContexts * FFX_MAX_PASS_COUNT * MAX_PIPELINE_USAGE_PER_FRAME * FFX_MAX_QUEUED_FRAMES;
+        if (!backendContext->vkFunctionTable.vkCreateDescriptorUpdateTemplate || !backendContext->vkFunctionTable.vkDestroyDescriptorUpdateTemplate) {
+            backendContext->vkFunctionTable.vkCreateDescriptorUpdateTemplate = (PFN_vkCreateDescriptorUpdateTemplate)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkCreateDescriptorUpdateTemplateKHR");
+            backendContext->vkFunctionTable.vkDestroyDescriptorUpdateTemplate = (PFN_vkDestroyDescriptorUpdateTemplate)vkDeviceContext->vkDeviceProcAddr(backendContext->device, "vkDestroyDescriptorUpdateTemplateKHR");
+        }
 
-        if (backendContext->vkFunctionTable.vkCreateDescriptorPool(backendContext->device, &descriptorPoolCreateInfo, nullptr, &backendContext->descriptorPool) != VK_SUCCESS) {
-            return FFX_ERROR_BACKEND_API_ERROR;
+        backendContext->maxPushDescriptors = 0;
+
+        for (uint32_t i = 0; backendContext->pushDescriptorsEnabled && i < backendContext->numDeviceExtensions; i++)
+        {
+            if (strcmp(backendContext->extensionProperties[i].extensionName, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME) != 0)
+                continue;
+
+            if (backendContext->vkFunctionTable.vkCreateDescriptorUpdateTemplate && backendContext->vkFunctionTable.vkDestroyDescriptorUpdateTemplate &&
+                backendContext->vkFunctionTable.vkCmdPushDescriptorSetKHR && backendContext->vkFunctionTable.vkCmdPushDescriptorSetWithTemplateKHR)
+            {
+                VkPhysicalDevicePushDescriptorPropertiesKHR pushDescriptorProperties = {};
+                pushDescriptorProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+
+                VkPhysicalDeviceProperties2 deviceProperties2 = {};
+                deviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                deviceProperties2.pNext = &pushDescriptorProperties;
+                vkGetPhysicalDeviceProperties2(backendContext->physicalDevice, &deviceProperties2);
+
+                backendContext->maxPushDescriptors = pushDescriptorProperties.maxPushDescriptors;
+            }
+            break;
+        }
+
+        // create a global descriptor pool to hold all descriptors we'll need. DLSSG-TO-FSR3: Pipelines that push their
+        // descriptors don't need it. It's created for the first one that doesn't.
+        if (!backendContext->maxPushDescriptors) {
+            FfxErrorCode errorCode = createDescriptorPoolVK(backendContext);
+            if (errorCode != FFX_OK)
+                return errorCode;
+        }
+
+        // DLSSG-TO-FSR3: Sub-allocation of internal resources, see allocateDeviceMemory
+        {
+            VkPhysicalDeviceProperties physicalDeviceProperties = {};
+            vkGetPhysicalDeviceProperties(backendContext->physicalDevice, &physicalDeviceProperties);
+            vkGetPhysicalDeviceMemoryProperties(backendContext->physicalDevice, &backendContext->memoryProperties);
+            backendContext->bufferImageGranularity = physicalDeviceProperties.limits.bufferImageGranularity;
+
+            backendContext->dedicatedAllocationSupported = false;
+
+            for (uint32_t i = 0; i < backendContext->numDeviceExtensions; i++)
+            {
+                if (strcmp(backendContext->extensionProperties[i].extensionName, VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME) == 0) {
+                    backendContext->dedicatedAllocationSupported =
+                        backendContext->vkFunctionTable.vkGetBufferMemoryRequirements2KHR && backendContext->vkFunctionTable.vkGetImageMemoryRequirements2KHR;
+                    break;
+                }
+            }
         }
 
         // set bindless resource view to base
@@ -2103,6 +2571,9 @@ FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 e
     for (uint32_t frameIndex = 0; frameIndex < FFX_MAX_QUEUED_FRAMES; ++frameIndex)
         destroyDynamicViews(backendContext, effectContextId, frameIndex);
 
+    evictCachedImageViews(backendContext, effectContextId, true); // DLSSG-TO-FSR3
+    effectContext.unregisteredFrameCount = 0;
+
     // clean up descriptor set layouts
     if (effectContext.bindlessTextureSrvDescriptorSetLayout)
     {
@@ -2146,11 +2617,21 @@ FfxErrorCode DestroyBackendContextVK(FfxInterface* backendInterface, FfxUInt32 e
     effectContext.nextStaticResource = 0;
     effectContext.active = false;
 
+    // DLSSG-TO-FSR3: Hand back blocks emptied by this context's resources
+    releaseMemoryBlocks(backendContext, false);
+
     // Decrement ref count
     --backendContext->refCount;
 
     if (!backendContext->refCount) {
 
+        // DLSSG-TO-FSR3: clean up memory blocks
+        releaseMemoryBlocks(backendContext, true);
+
+        // DLSSG-TO-FSR3: clean up timestamp queries
+        if (backendContext->gpuPassTimings.queryPool != VK_NULL_HANDLE)
+            backendContext->vkFunctionTable.vkDestroyQueryPool(backendContext->device, backendContext->gpuPassTimings.queryPool, VK_NULL_HANDLE);
+
         // clean up descriptor pool
         backendContext->vkFunctionTable.vkDestroyDescriptorPool(backendContext->device, backendContext->descriptorPool, VK_NULL_HANDLE);
         backendContext->descriptorPool = VK_NULL_HANDLE;
@@ -2265,14 +2746,15 @@ FfxErrorCode CreateResourceVK(
         setVKObjectName(backendContext->vkFunctionTable, backendContext->device, VK_OBJECT_TYPE_BUFFER, (uint64_t)backendResource->bufferResource, backendResource->resourceName);
 #endif
 
-        backendContext->vkFunctionTable.vkGetBufferMemoryRequirements(backendContext->device, backendResource->bufferResource, &memRequirements);
+        bool dedicated = false;
+        getResourceMemoryRequirements(backendContext, backendResource, memRequirements, dedicated);
 
         // allocate the memory
-        FfxErrorCode errorCode = allocateDeviceMemory(backendContext, memRequirements, requiredMemoryProperties, backendResource);
+        FfxErrorCode errorCode = allocateDeviceMemory(backendContext, memRequirements, requiredMemoryProperties, dedicated, backendResource);
         if (FFX_OK != errorCode)
             return errorCode;
 
-        if (backendContext->vkFunctionTable.vkBindBufferMemory(backendContext->device, backendResource->bufferResource, backendResource->deviceMemory, 0) != VK_SUCCESS) {
+        if (backendContext->vkFunctionTable.vkBindBufferMemory(backendContext->device, backendResource->bufferResource, backendResource->deviceMemory, backendResource->memoryOffset) != VK_SUCCESS) {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
 
@@ -2282,7 +2764,7 @@ FfxErrorCode CreateResourceVK(
             // only allow copies directly into mapped memory for buffer resources since all texture resources are in optimal tiling
             void* data = NULL;
 
-            if (backendContext->vkFunctionTable.vkMapMemory(backendContext->device, backendResource->deviceMemory, 0, initData.size, 0, &data) != VK_SUCCESS) {
+            if (backendContext->vkFunctionTable.vkMapMemory(backendContext->device, backendResource->deviceMemory, backendResource->memoryOffset, initData.size, 0, &data) != VK_SUCCESS) {
                 return FFX_ERROR_BACKEND_API_ERROR;
             }
 
@@ -2297,6 +2779,7 @@ FfxErrorCode CreateResourceVK(
                 VkMappedMemoryRange memoryRange = {};
                 memoryRange.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
                 memoryRange.memory = backendResource->deviceMemory;
+                memoryRange.offset = backendResource->memoryOffset;
                 memoryRange.size = initData.size;
 
                 backendContext->vkFunctionTable.vkFlushMappedMemoryRanges(backendContext->device, 1, &memoryRange);
@@ -2345,14 +2828,15 @@ FfxErrorCode CreateResourceVK(
         setVKObjectName(backendContext->vkFunctionTable, backendContext->device, VK_OBJECT_TYPE_IMAGE, (uint64_t)backendResource->imageResource, backendResource->resourceName);
 #endif
 
-        backendContext->vkFunctionTable.vkGetImageMemoryRequirements(backendContext->device, backendResource->imageResource, &memRequirements);
+        bool dedicated = false;
+        getResourceMemoryRequirements(backendContext, backendResource, memRequirements, dedicated);
 
         // allocate the memory
-        FfxErrorCode errorCode = allocateDeviceMemory(backendContext, memRequirements, requiredMemoryProperties, backendResource);
+        FfxErrorCode errorCode = allocateDeviceMemory(backendContext, memRequirements, requiredMemoryProperties, dedicated, backendResource);
         if (FFX_OK != errorCode)
             return errorCode;
 
-        if (backendContext->vkFunctionTable.vkBindImageMemory(backendContext->device, backendResource->imageResource, backendResource->deviceMemory, 0) != VK_SUCCESS) {
+        if (backendContext->vkFunctionTable.vkBindImageMemory(backendContext->device, backendResource->imageResource, backendResource->deviceMemory, backendResource->memoryOffset) != VK_SUCCESS) {
             return FFX_ERROR_BACKEND_API_ERROR;
         }
 
@@ -2548,8 +3032,7 @@ FfxErrorCode DestroyResourceVK(FfxInterface* backendInterface, FfxResourceIntern
 
         if (backgroundResource.deviceMemory)
         {
-            backendContext->vkFunctionTable.vkFreeMemory(backendContext->device, backgroundResource.deviceMemory, nullptr);
-            backgroundResource.deviceMemory = VK_NULL_HANDLE;
+            freeDeviceMemory(backendContext, &backgroundResource); // DLSSG-TO-FSR3
 
             effectContext.vramUsage.totalUsageInBytes -= static_cast<uint64_t>(backgroundResource.allocationSize);
             if ((backendContext->pResources[resource.internalIndex].resourceDescription.flags & FFX_RESOURCE_FLAGS_ALIASABLE) == FFX_RESOURCE_FLAGS_ALIASABLE)
@@ -2571,7 +3054,7 @@ FfxErrorCode MapResourceVK(FfxInterface* backendInterface, FfxResourceInternal r
 
     BackendContext_VK::Resource* res = &backendContext->pResources[resource.internalIndex];
 
-    if ((backendContext->vkFunctionTable.vkMapMemory(backendContext->device, res->deviceMemory, 0, res->resourceDescription.size, 0, ptr) != VK_SUCCESS))
+    if ((backendContext->vkFunctionTable.vkMapMemory(backendContext->device, res->deviceMemory, res->memoryOffset, res->resourceDescription.size, 0, ptr) != VK_SUCCESS))
         return FFX_ERROR_BACKEND_API_ERROR;
 
     return FFX_OK;
@@ -2729,7 +3212,7 @@ FfxErrorCode RegisterResourceVK(
         VkImageViewUsageCreateInfo imageViewUsageCreateInfo = {};
         addMutableViewForSRV(imageViewCreateInfo, imageViewUsageCreateInfo, backendResource->resourceDescription);
 
-        if (backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->srvViewIndex].imageView) != VK_SUCCESS) {
+        if (acquireDynamicImageView(backendContext, effectContextId, backendResource->resourceDescription, imageViewCreateInfo, backendContext->pResourceViews[backendResource->srvViewIndex]) != VK_SUCCESS) { // DLSSG-TO-FSR3
             return FFX_ERROR_BACKEND_API_ERROR;
         }
 #ifdef _DEBUG
@@ -2752,7 +3235,7 @@ FfxErrorCode RegisterResourceVK(
                 imageViewCreateInfo.subresourceRange.levelCount = 1;
                 imageViewCreateInfo.subresourceRange.baseMipLevel = mip;
 
-                if (backendContext->vkFunctionTable.vkCreateImageView(backendContext->device, &imageViewCreateInfo, NULL, &backendContext->pResourceViews[backendResource->uavViewIndex + mip].imageView) != VK_SUCCESS) {
+                if (acquireDynamicImageView(backendContext, effectContextId, backendResource->resourceDescription, imageViewCreateInfo, backendContext->pResourceViews[backendResource->uavViewIndex + mip]) != VK_SUCCESS) { // DLSSG-TO-FSR3
                     return FFX_ERROR_BACKEND_API_ERROR;
                 }
 #ifdef _DEBUG
@@ -2839,6 +3322,10 @@ FfxErrorCode UnregisterResourcesVK(FfxInterface* backendInterface, FfxCommandLis
     effectContext.frameIndex = (effectContext.frameIndex + 1) % FFX_MAX_QUEUED_FRAMES;
     destroyDynamicViews(backendContext, effectContextId, effectContext.frameIndex);
 
+    // DLSSG-TO-FSR3: Same for cached views that went unused for as long
+    effectContext.unregisteredFrameCount++;
+    evictCachedImageViews(backendContext, effectContextId, false);
+
     return FFX_OK;
 }
 
@@ -3245,8 +3732,12 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
 
     //////////////////////////////////////////////////////////////////////////
     // One root signature (or pipeline layout) per pipeline
-    FFX_ASSERT_MESSAGE(effectContext.nextPipelineLayout < (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT, "FFXInterface: Vulkan: Ran out of pipeline layouts. Please increase FFX_MAX_PASS_COUNT");
-    BackendContext_VK::PipelineLayout* pPipelineLayout = &backendContext->pPipelineLayouts[effectContext.nextPipelineLayout++];
+    BackendContext_VK::PipelineLayout* pPipelineLayout = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(backendContext->pipelineMutex); // DLSSG-TO-FSR3
+        FFX_ASSERT_MESSAGE(effectContext.nextPipelineLayout < (effectContextId * FFX_MAX_PASS_COUNT) + FFX_MAX_PASS_COUNT, "FFXInterface: Vulkan: Ran out of pipeline layouts. Please increase FFX_MAX_PASS_COUNT");
+        pPipelineLayout = &backendContext->pPipelineLayouts[effectContext.nextPipelineLayout++];
+    }
 
     // Start by creating samplers
     FFX_ASSERT(pipelineDescription->samplerCount <= FFX_MAX_SAMPLERS);
@@ -3398,9 +3889,20 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
             shaderBlob.boundConstantBufferCounts[cbIndex], shaderStageFlags, nullptr };
     }
 
+    // DLSSG-TO-FSR3: Push set 0 when the device allows it. Bindless sets have to be allocated, so skip those pipelines.
+    uint32_t descriptorCount = 0;
+    for (uint32_t i = 0; i < numLayoutBindings; ++i)
+        descriptorCount += layoutBindings[i].descriptorCount;
+
+    pPipelineLayout->pushDescriptors = backendContext->maxPushDescriptors > 0 && descriptorCount <= backendContext->maxPushDescriptors &&
+        staticTextureSrvCount == 0 && staticBufferSrvCount == 0 && staticTextureUavCount == 0 && staticBufferUavCount == 0;
+    pPipelineLayout->descriptorUpdateTemplate = VK_NULL_HANDLE;
+    pPipelineLayout->descriptorUpdateTemplateEntryCount = 0;
+
     // Create the descriptor layout
     VkDescriptorSetLayoutCreateInfo layoutInfo = {};
     layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.flags = pPipelineLayout->pushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : 0; // DLSSG-TO-FSR3
     layoutInfo.bindingCount = numLayoutBindings;
     layoutInfo.pBindings = layoutBindings;
 
@@ -3410,7 +3912,14 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
 
     // allocate descriptor sets
     pPipelineLayout->descriptorSetIndex = 0;
-    for (uint32_t i = 0; i < (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME); i++)
+    std::unique_lock<std::mutex> descriptorPoolLock(backendContext->pipelineMutex); // DLSSG-TO-FSR3: pools are externally synchronized
+
+    // DLSSG-TO-FSR3: Pushed sets aren't allocated. The pool is created once a pipeline needs it.
+    const uint32_t descriptorSetCount = pPipelineLayout->pushDescriptors ? 0 : (FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME);
+    if (descriptorSetCount > 0 && backendContext->descriptorPool == VK_NULL_HANDLE && createDescriptorPoolVK(backendContext) != FFX_OK)
+        return FFX_ERROR_BACKEND_API_ERROR;
+
+    for (uint32_t i = 0; i < descriptorSetCount; i++)
     {
         VkDescriptorSetAllocateInfo allocateInfo = {};
         allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
@@ -3423,6 +3932,7 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
             return FFX_ERROR_BACKEND_API_ERROR;
         }
     }
+    descriptorPoolLock.unlock();
 
     uint32_t setCount = 0;
 
@@ -3575,6 +4085,55 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
     outPipeline->constCount = shaderBlob.cbvCount;
     FFX_ASSERT(outPipeline->constCount < FFX_MAX_NUM_CONST_BUFFERS);
 
+    // DLSSG-TO-FSR3: One template entry per descriptor in the order executeGpuJobCompute fills DescriptorInfos
+    if (pPipelineLayout->pushDescriptors)
+    {
+        VkDescriptorUpdateTemplateEntry templateEntries[FFX_MAX_RESOURCE_COUNT];
+        uint32_t templateEntryCount = 0;
+        uint32_t imageInfoIndex = 0;
+        uint32_t bufferInfoIndex = 0;
+
+        for (uint32_t i = 0; i < outPipeline->uavTextureCount; ++i)
+            templateEntries[templateEntryCount++] = { outPipeline->uavTextureBindings[i].slotIndex, outPipeline->uavTextureBindings[i].arrayIndex, 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                offsetof(DescriptorInfos, image) + sizeof(VkDescriptorImageInfo) * imageInfoIndex++, 0 };
+
+        for (uint32_t i = 0; i < outPipeline->uavBufferCount; ++i)
+            templateEntries[templateEntryCount++] = { outPipeline->uavBufferBindings[i].slotIndex, outPipeline->uavBufferBindings[i].arrayIndex, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                offsetof(DescriptorInfos, buffer) + sizeof(VkDescriptorBufferInfo) * bufferInfoIndex++, 0 };
+
+        for (uint32_t i = 0; i < outPipeline->srvTextureCount; ++i)
+            templateEntries[templateEntryCount++] = { outPipeline->srvTextureBindings[i].slotIndex, outPipeline->srvTextureBindings[i].arrayIndex, 1, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                offsetof(DescriptorInfos, image) + sizeof(VkDescriptorImageInfo) * imageInfoIndex++, 0 };
+
+        for (uint32_t i = 0; i < outPipeline->srvBufferCount; ++i)
+            templateEntries[templateEntryCount++] = { outPipeline->srvBufferBindings[i].slotIndex, outPipeline->srvBufferBindings[i].arrayIndex, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                offsetof(DescriptorInfos, buffer) + sizeof(VkDescriptorBufferInfo) * bufferInfoIndex++, 0 };
+
+        for (uint32_t i = 0; i < outPipeline->constCount; ++i)
+            templateEntries[templateEntryCount++] = { outPipeline->constantBufferBindings[i].slotIndex, 0, 1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                offsetof(DescriptorInfos, buffer) + sizeof(VkDescriptorBufferInfo) * bufferInfoIndex++, 0 };
+
+        // Templates can't be empty. Pipelines without descriptors have nothing to push.
+        if (templateEntryCount > 0)
+        {
+            VkDescriptorUpdateTemplateCreateInfo templateCreateInfo = {};
+            templateCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+            templateCreateInfo.descriptorUpdateEntryCount = templateEntryCount;
+            templateCreateInfo.pDescriptorUpdateEntries = templateEntries;
+            templateCreateInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+            templateCreateInfo.descriptorSetLayout = pPipelineLayout->descriptorSetLayout;
+            templateCreateInfo.pipelineBindPoint = VK_PIPELINE_BIND_POINT_COMPUTE;
+            templateCreateInfo.pipelineLayout = pPipelineLayout->pipelineLayout;
+            templateCreateInfo.set = 0;
+
+            if (backendContext->vkFunctionTable.vkCreateDescriptorUpdateTemplate(backendContext->device, &templateCreateInfo, nullptr, &pPipelineLayout->descriptorUpdateTemplate) != VK_SUCCESS) {
+                return FFX_ERROR_BACKEND_API_ERROR;
+            }
+
+            pPipelineLayout->descriptorUpdateTemplateEntryCount = templateEntryCount;
+        }
+    }
+
     outPipeline->staticTextureSrvCount = staticTextureSrvCount;
     FFX_ASSERT(outPipeline->staticTextureSrvCount <= effectContext.bindlessTextureSrvHeapSize);
 
@@ -3632,7 +4191,7 @@ FfxErrorCode CreatePipelineVK(FfxInterface* backendInterface,
     pipelineCreateInfo.layout = pPipelineLayout->pipelineLayout;
 
     VkPipeline computePipeline = VK_NULL_HANDLE;
-    if (backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, nullptr, 1, &pipelineCreateInfo, nullptr, &computePipeline) != VK_SUCCESS) {
+    if (backendContext->vkFunctionTable.vkCreateComputePipelines(backendContext->device, backendContext->pipelineCache, 1, &pipelineCreateInfo, nullptr, &computePipeline) != VK_SUCCESS) { // DLSSG-TO-FSR3
         return FFX_ERROR_BACKEND_API_ERROR;
     }
 
@@ -3679,11 +4238,19 @@ FfxErrorCode DestroyPipelineVK(FfxInterface* backendInterface, FfxPipelineState*
         }
 
         // Descriptor sets
+        std::lock_guard<std::mutex> descriptorPoolLock(backendContext->pipelineMutex); // DLSSG-TO-FSR3: pools are externally synchronized
         for (uint32_t i = 0; i < FFX_MAX_QUEUED_FRAMES * MAX_PIPELINE_USAGE_PER_FRAME; i++) {
-            backendContext->vkFunctionTable.vkFreeDescriptorSets(backendContext->device, backendContext->descriptorPool, 1, &pPipelineLayout->descriptorSets[i]);
+            if (pPipelineLayout->descriptorSets[i] != VK_NULL_HANDLE) // DLSSG-TO-FSR3: pushed sets aren't allocated
+                backendContext->vkFunctionTable.vkFreeDescriptorSets(backendContext->device, backendContext->descriptorPool, 1, &pPipelineLayout->descriptorSets[i]);
             pPipelineLayout->descriptorSets[i] = VK_NULL_HANDLE;
         }
 
+        // DLSSG-TO-FSR3: Push descriptor update template
+        if (pPipelineLayout->descriptorUpdateTemplate != VK_NULL_HANDLE) {
+            backendContext->vkFunctionTable.vkDestroyDescriptorUpdateTemplate(backendContext->device, pPipelineLayout->descriptorUpdateTemplate, VK_NULL_HANDLE);
+            pPipelineLayout->descriptorUpdateTemplate = VK_NULL_HANDLE;
+        }
+
         // Descriptor set layout
         if (pPipelineLayout->descriptorSetLayout != VK_NULL_HANDLE) {
             backendContext->vkFunctionTable.vkDestroyDescriptorSetLayout(backendContext->device, pPipelineLayout->descriptorSetLayout, VK_NULL_HANDLE);
@@ -3729,15 +4296,18 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     uint32_t               descriptorWriteIndex = 0;
     VkWriteDescriptorSet   writeDescriptorSets[FFX_MAX_RESOURCE_COUNT];
 
+    // DLSSG-TO-FSR3: Kept together so push descriptor update templates can read them in place
+    DescriptorInfos        descriptorInfos;
+
     // These MUST be initialized
     uint32_t               imageDescriptorIndex = 0;
-    VkDescriptorImageInfo  imageDescriptorInfos[FFX_MAX_RESOURCE_COUNT];
+    VkDescriptorImageInfo* imageDescriptorInfos = descriptorInfos.image;
     for (int i = 0; i < FFX_MAX_RESOURCE_COUNT; ++i)
         imageDescriptorInfos[i] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL };
 
     // These MUST be initialized
     uint32_t               bufferDescriptorIndex = 0;
-    VkDescriptorBufferInfo bufferDescriptorInfos[FFX_MAX_RESOURCE_COUNT];
+    VkDescriptorBufferInfo* bufferDescriptorInfos = descriptorInfos.buffer;
     for (int i = 0; i < FFX_MAX_RESOURCE_COUNT; ++i)
         bufferDescriptorInfos[i] = { VK_NULL_HANDLE, 0, VK_WHOLE_SIZE };
 
@@ -3931,14 +4501,21 @@ static FfxErrorCode executeGpuJobCompute(BackendContext_VK*    backendContext,
     flushBarriers(backendContext, vkCommandBuffer);
 
     // update all uavs and srvs
-    backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, descriptorWriteIndex, writeDescriptorSets, 0, nullptr);
+    if (!pipelineLayout->pushDescriptors) // DLSSG-TO-FSR3
+        backendContext->vkFunctionTable.vkUpdateDescriptorSets(backendContext->device, descriptorWriteIndex, writeDescriptorSets, 0, nullptr);
 
     // bind pipeline
     backendContext->vkFunctionTable.vkCmdBindPipeline(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, reinterpret_cast<VkPipeline>(job->computeJobDescriptor.pipeline.pipeline));
 
     // bind descriptor sets
     {
-        backendContext->vkFunctionTable.vkCmdBindDescriptorSets(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout->pipelineLayout, 0, 1, &pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex], 0, nullptr);
+        // DLSSG-TO-FSR3: Push set 0 instead. The template only fits when no null binding was skipped above.
+        if (!pipelineLayout->pushDescriptors)
+            backendContext->vkFunctionTable.vkCmdBindDescriptorSets(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout->pipelineLayout, 0, 1, &pipelineLayout->descriptorSets[pipelineLayout->descriptorSetIndex], 0, nullptr);
+        else if (pipelineLayout->descriptorUpdateTemplate != VK_NULL_HANDLE && descriptorWriteIndex == pipelineLayout->descriptorUpdateTemplateEntryCount)
+            backendContext->vkFunctionTable.vkCmdPushDescriptorSetWithTemplateKHR(vkCommandBuffer, pipelineLayout->descriptorUpdateTemplate, pipelineLayout->pipelineLayout, 0, &descriptorInfos);
+        else if (descriptorWriteIndex > 0)
+            backendContext->vkFunctionTable.vkCmdPushDescriptorSetKHR(vkCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout->pipelineLayout, 0, descriptorWriteIndex, writeDescriptorSets);
 
         BackendContext_VK::EffectContext& effectContext = backendContext->pEffectContexts[effectContextId];
 
@@ -4097,8 +4674,251 @@ static FfxErrorCode executeGpuJobBarrier(BackendContext_VK* backendContext, FfxG
     return FFX_OK;
 }
 
-static FfxErrorCode executeGpuJobTimestamp(BackendContext_VK* backendContext, FfxGpuJobDescription* job, VkCommandBuffer vkCommandBuffer)
+// DLSSG-TO-FSR3: Per-pass GPU timings
+static bool isGpuJobTimed(const FfxGpuJobDescription* job)
+{
+    return job->jobType == FFX_GPU_JOB_CLEAR_FLOAT || job->jobType == FFX_GPU_JOB_COPY || job->jobType == FFX_GPU_JOB_COMPUTE;
+}
+
+static uint8_t findGpuPassTiming(BackendContext_VK* backendContext, const FfxGpuJobDescription* job)
+{
+    BackendContext_VK::GpuPassTimings& timings = backendContext->gpuPassTimings;
+    const wchar_t* name = job->jobLabel;
+
+    if (!name[0])
+    {
+        if (job->jobType == FFX_GPU_JOB_COMPUTE)
+            name = job->computeJobDescriptor.pipeline.name;
+        else
+            name = (job->jobType == FFX_GPU_JOB_COPY) ? L"Copy" : L"Clear";
+    }
+
+    for (uint32_t i = 0; i < timings.passCount; ++i)
+    {
+        if (wcsncmp(timings.passes[i].name, name, FFX_RESOURCE_NAME_SIZE) == 0)
+            return static_cast<uint8_t>(i);
+    }
+
+    // Names are kept until the backend is reset so that pending slots can refer to them by index
+    if (timings.passCount >= FFX_GPU_PASS_TIMING_MAX_PASSES)
+        return UINT8_MAX;
+
+    BackendContext_VK::GpuPassTimings::Pass& pass = timings.passes[timings.passCount];
+    wcscpy_s(pass.name, name);
+
+    return static_cast<uint8_t>(timings.passCount++);
+}
+
+static void flushGpuPassTimings(BackendContext_VK* backendContext)
+{
+    BackendContext_VK::GpuPassTimings& timings = backendContext->gpuPassTimings;
+
+    FfxGpuPassTimingVK reports[FFX_GPU_PASS_TIMING_MAX_PASSES] = {};
+    uint32_t reportCount = 0;
+
+    for (uint32_t i = 0; i < timings.passCount; ++i)
+    {
+        BackendContext_VK::GpuPassTimings::Pass& pass = timings.passes[i];
+
+        if (pass.sampleCount == 0)
+            continue;
+
+        FfxGpuPassTimingVK& report = reports[reportCount++];
+        report.name = pass.name;
+        report.sampleCount = pass.sampleCount;
+        report.minMilliseconds = pass.minMilliseconds;
+        report.avgMilliseconds = pass.sumMilliseconds / pass.sampleCount;
+        report.maxMilliseconds = pass.maxMilliseconds;
+
+        pass.sampleCount = 0;
+        pass.minMilliseconds = 0.0;
+        pass.maxMilliseconds = 0.0;
+        pass.sumMilliseconds = 0.0;
+    }
+
+    timings.config.callback(reports, reportCount, timings.droppedSubmissions, timings.config.userData);
+
+    timings.resolvedSubmissions = 0;
+    timings.droppedSubmissions = 0;
+}
+
+static uint32_t getGpuPassTimingFirstQuery(uint32_t slotIndex)
+{
+    return slotIndex * FFX_GPU_PASS_TIMING_MAX_JOBS * 2;
+}
+
+static void resetGpuPassTimingSlot(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer, uint32_t slotIndex)
+{
+    BackendContext_VK::GpuPassTimings& timings = backendContext->gpuPassTimings;
+
+    backendContext->vkFunctionTable.vkCmdResetQueryPool(vkCommandBuffer, timings.queryPool, getGpuPassTimingFirstQuery(slotIndex), FFX_GPU_PASS_TIMING_MAX_JOBS * 2);
+    timings.slots[slotIndex].state = BackendContext_VK::GpuPassTimings::SLOT_STATE_RESETTING;
+}
+
+// Reads back every slot the GPU has finished with and queues resets for them on vkCommandBuffer. Never waits.
+static void resolveGpuPassTimings(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer)
+{
+    BackendContext_VK::GpuPassTimings& timings = backendContext->gpuPassTimings;
+    uint64_t results[FFX_GPU_PASS_TIMING_MAX_JOBS * 2][2]; // Value and availability
+
+    // Oldest slot first
+    for (uint32_t i = 0; i < FFX_GPU_PASS_TIMING_SLOT_COUNT; ++i)
+    {
+        const uint32_t slotIndex = (timings.nextSlot + i) % FFX_GPU_PASS_TIMING_SLOT_COUNT;
+        BackendContext_VK::GpuPassTimings::Slot& slot = timings.slots[slotIndex];
+
+        if (slot.state == BackendContext_VK::GpuPassTimings::SLOT_STATE_RESETTING)
+        {
+            // Queries written before the reset stay available until the GPU gets to it
+            results[0][1] = 1;
+            backendContext->vkFunctionTable.vkGetQueryPoolResults(
+                backendContext->device,
+                timings.queryPool,
+                getGpuPassTimingFirstQuery(slotIndex),
+                1,
+                sizeof(results[0]),
+                results,
+                sizeof(results[0]),
+                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+            if (results[0][1] == 0)
+                slot.state = BackendContext_VK::GpuPassTimings::SLOT_STATE_FREE;
+
+            continue;
+        }
+
+        const uint64_t age = timings.submissionCount - slot.submission;
+
+        if (slot.state != BackendContext_VK::GpuPassTimings::SLOT_STATE_RECORDED || age < FFX_GPU_PASS_TIMING_LATENCY)
+            continue;
+
+        const uint32_t queryCount = slot.jobCount * 2;
+        const VkResult result = backendContext->vkFunctionTable.vkGetQueryPoolResults(
+            backendContext->device,
+            timings.queryPool,
+            getGpuPassTimingFirstQuery(slotIndex),
+            queryCount,
+            sizeof(results[0]) * queryCount,
+            results,
+            sizeof(results[0]),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        bool available = (result == VK_SUCCESS);
+
+        for (uint32_t query = 0; available && query < queryCount; ++query)
+            available = (results[query][1] != 0);
+
+        if (!available)
+        {
+            // The command buffer was most likely never submitted. The reset is queued behind it either way.
+            if (age >= FFX_GPU_PASS_TIMING_MAX_AGE)
+            {
+                resetGpuPassTimingSlot(backendContext, vkCommandBuffer, slotIndex);
+                timings.droppedSubmissions++;
+            }
+
+            continue;
+        }
+
+        for (uint32_t job = 0; job < slot.jobCount; ++job)
+        {
+            if (slot.passIndices[job] >= timings.passCount)
+                continue;
+
+            const uint64_t begin = results[job * 2 + 0][0];
+            const uint64_t end = results[job * 2 + 1][0];
+            const double milliseconds = (end > begin) ? (static_cast<double>(end - begin) * timings.timestampPeriod / 1000000.0) : 0.0;
+
+            BackendContext_VK::GpuPassTimings::Pass& pass = timings.passes[slot.passIndices[job]];
+            pass.minMilliseconds = (pass.sampleCount == 0) ? milliseconds : FFX_MINIMUM(pass.minMilliseconds, milliseconds);
+            pass.maxMilliseconds = FFX_MAXIMUM(pass.maxMilliseconds, milliseconds);
+            pass.sumMilliseconds += milliseconds;
+            pass.sampleCount++;
+        }
+
+        resetGpuPassTimingSlot(backendContext, vkCommandBuffer, slotIndex);
+        timings.resolvedSubmissions++;
+    }
+
+    if (timings.resolvedSubmissions >= timings.config.windowSize)
+        flushGpuPassTimings(backendContext);
+}
+
+// Claims a slot of reset queries for the scheduled jobs. Returns nullptr when nothing is measured.
+static BackendContext_VK::GpuPassTimings::Slot* beginGpuPassTimings(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer)
+{
+    BackendContext_VK::GpuPassTimings& timings = backendContext->gpuPassTimings;
+
+    if (!timings.config.callback)
+        return nullptr;
+
+    if (timings.queryPool == VK_NULL_HANDLE)
+    {
+        VkPhysicalDeviceProperties physicalDeviceProperties = {};
+        vkGetPhysicalDeviceProperties(backendContext->physicalDevice, &physicalDeviceProperties);
+
+        VkQueryPoolCreateInfo queryPoolInfo = {};
+        queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queryPoolInfo.queryCount = FFX_GPU_PASS_TIMING_SLOT_COUNT * FFX_GPU_PASS_TIMING_MAX_JOBS * 2;
+
+        if (!physicalDeviceProperties.limits.timestampComputeAndGraphics ||
+            backendContext->vkFunctionTable.vkCreateQueryPool(backendContext->device, &queryPoolInfo, nullptr, &timings.queryPool) != VK_SUCCESS)
+        {
+            timings.config.callback = nullptr;
+            return nullptr;
+        }
+
+        timings.timestampPeriod = physicalDeviceProperties.limits.timestampPeriod;
+
+        // New queries are in an undefined state
+        for (uint32_t i = 0; i < FFX_GPU_PASS_TIMING_SLOT_COUNT; ++i)
+            resetGpuPassTimingSlot(backendContext, vkCommandBuffer, i);
+    }
+
+    timings.submissionCount++;
+    resolveGpuPassTimings(backendContext, vkCommandBuffer);
+
+    uint32_t jobCount = 0;
+
+    for (uint32_t i = 0; i < backendContext->gpuJobCount; ++i)
+    {
+        if (isGpuJobTimed(&backendContext->pGpuJobs[i]))
+            jobCount++;
+    }
+
+    jobCount = FFX_MINIMUM(jobCount, FFX_GPU_PASS_TIMING_MAX_JOBS);
+
+    if (jobCount == 0)
+        return nullptr;
+
+    // The GPU is too far behind, or earlier command buffers were never submitted. Skip rather than overwrite.
+    BackendContext_VK::GpuPassTimings::Slot& slot = timings.slots[timings.nextSlot];
+
+    if (slot.state != BackendContext_VK::GpuPassTimings::SLOT_STATE_FREE)
+    {
+        timings.droppedSubmissions++;
+        return nullptr;
+    }
+
+    timings.nextSlot = (timings.nextSlot + 1) % FFX_GPU_PASS_TIMING_SLOT_COUNT;
+
+    slot.state = BackendContext_VK::GpuPassTimings::SLOT_STATE_RECORDED;
+    slot.submission = timings.submissionCount;
+    slot.jobCount = jobCount;
+
+    return &slot;
+}
+
+static FfxErrorCode executeGpuJobTimestamp(BackendContext_VK* backendContext, VkCommandBuffer vkCommandBuffer, BackendContext_VK::GpuPassTimings::Slot* slot, uint32_t query)
 {
+    BackendContext_VK::GpuPassTimings& timings = backendContext->gpuPassTimings;
+    const uint32_t slotIndex = static_cast<uint32_t>(slot - timings.slots);
+
+    // Both ends wait for all prior work so passes don't overlap in the measurements
+    backendContext->vkFunctionTable.vkCmdWriteTimestamp(
+        vkCommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timings.queryPool, getGpuPassTimingFirstQuery(slotIndex) + query);
+
     return FFX_OK;
 }
 
@@ -4156,16 +4976,26 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
 
     FfxErrorCode errorCode = FFX_OK;
 
+    // DLSSG-TO-FSR3: Time individual passes when requested
+    BackendContext_VK::GpuPassTimings::Slot* timingSlot = beginGpuPassTimings(backendContext, vkCommandBuffer);
+    uint32_t timedJobCount = 0;
+
     // execute all renderjobs
     for (uint32_t i = 0; i < backendContext->gpuJobCount; ++i)
     {
         FfxGpuJobDescription* gpuJob = &backendContext->pGpuJobs[i];
+        const bool timed = timingSlot && timedJobCount < timingSlot->jobCount && isGpuJobTimed(gpuJob); // DLSSG-TO-FSR3
 
         // If we have a label for the job, drop a marker for it
         if (gpuJob->jobLabel[0]) {
             beginMarkerVK(backendContext, vkCommandBuffer, gpuJob->jobLabel);
         }
 
+        if (timed) {
+            timingSlot->passIndices[timedJobCount] = findGpuPassTiming(backendContext, gpuJob);
+            executeGpuJobTimestamp(backendContext, vkCommandBuffer, timingSlot, timedJobCount * 2 + 0);
+        }
+
         
         switch (gpuJob->jobType)
         {
@@ -4192,6 +5022,11 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
         default:;
         }
 
+        if (timed) {
+            executeGpuJobTimestamp(backendContext, vkCommandBuffer, timingSlot, timedJobCount * 2 + 1);
+            timedJobCount++;
+        }
+
         if (gpuJob->jobLabel[0]) {
             endMarkerVK(backendContext, vkCommandBuffer);
         }
@@ -4207,6 +5042,122 @@ FfxErrorCode ExecuteGpuJobsVK(FfxInterface* backendInterface, FfxCommandList com
     return FFX_OK;
 }
 
+FfxErrorCode ffxSetGpuPassTimingCallbackVK(FfxInterface* backendInterface, uint32_t windowSize, FfxGpuPassTimingCallbackVK callback, void* userData)
+{
+    FFX_RETURN_ON_ERROR(
+        backendInterface && backendInterface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+
+    if (callback)
+    {
+        VkDeviceContext* vkDeviceContext = reinterpret_cast<VkDeviceContext*>(backendInterface->device);
+        FFX_RETURN_ON_ERROR(
+            vkDeviceContext && vkDeviceContext->vkPhysicalDevice != VK_NULL_HANDLE,
+            FFX_ERROR_INVALID_POINTER);
+
+        VkPhysicalDeviceProperties physicalDeviceProperties = {};
+        vkGetPhysicalDeviceProperties(vkDeviceContext->vkPhysicalDevice, &physicalDeviceProperties);
+
+        FFX_RETURN_ON_ERROR(
+            physicalDeviceProperties.limits.timestampComputeAndGraphics,
+            FFX_ERROR_BACKEND_API_ERROR);
+    }
+
+    backendContext->gpuPassTimings.config.callback = callback;
+    backendContext->gpuPassTimings.config.userData = userData;
+    backendContext->gpuPassTimings.config.windowSize = FFX_MAXIMUM(windowSize, 1u);
+
+    return FFX_OK;
+}
+
+// DLSSG-TO-FSR3: Pipeline cache used by CreatePipelineVK
+FfxErrorCode ffxSetPipelineCacheVK(FfxInterface* backendInterface, VkPipelineCache pipelineCache)
+{
+    FFX_RETURN_ON_ERROR(
+        backendInterface && backendInterface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    backendContext->pipelineCache = pipelineCache;
+
+    return FFX_OK;
+}
+
+// DLSSG-TO-FSR3: Allow pipelines to push their descriptors
+FfxErrorCode ffxSetPushDescriptorsEnabledVK(FfxInterface* backendInterface, bool enabled)
+{
+    FFX_RETURN_ON_ERROR(
+        backendInterface && backendInterface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    backendContext->pushDescriptorsEnabled = enabled;
+
+    return FFX_OK;
+}
+
+// DLSSG-TO-FSR3: Device memory held by internal resources, at allocation granularity
+FfxErrorCode ffxGetDeviceMemoryStatsVK(FfxInterface* backendInterface, FfxDeviceMemoryStatsVK* outStats)
+{
+    FFX_RETURN_ON_ERROR(
+        backendInterface && backendInterface->scratchBuffer && outStats,
+        FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+    memset(outStats, 0, sizeof(FfxDeviceMemoryStatsVK));
+
+    // Nothing is allocated until the first effect context is created
+    if (!backendContext->refCount)
+        return FFX_OK;
+
+    for (const BackendContext_VK::MemoryBlock& block : backendContext->memoryBlocks)
+    {
+        if (block.memory == VK_NULL_HANDLE)
+            continue;
+
+        VkDeviceSize freeSize = 0;
+        for (uint32_t i = 0; i < block.freeRangeCount; ++i)
+            freeSize += block.freeRanges[i].size;
+
+        outStats->blockCount++;
+        outStats->blockSize += block.size;
+        outStats->blockUsedSize += block.size - freeSize;
+        outStats->blockAllocationCount += block.allocationCount;
+    }
+
+    outStats->dedicatedAllocationCount = backendContext->dedicatedAllocationCount;
+    outStats->dedicatedAllocationSize = backendContext->dedicatedAllocationSize;
+
+    return FFX_OK;
+}
+
+// DLSSG-TO-FSR3: Stop handing out cached views of an image. They're destroyed once they age out.
+FfxErrorCode ffxInvalidateImageViewsVK(FfxInterface* backendInterface, VkImage image)
+{
+    FFX_RETURN_ON_ERROR(
+        backendInterface && backendInterface->scratchBuffer,
+        FFX_ERROR_INVALID_POINTER);
+
+    BackendContext_VK* backendContext = (BackendContext_VK*)backendInterface->scratchBuffer;
+
+    // Nothing is mapped until the first effect context is created
+    if (!backendContext->refCount)
+        return FFX_OK;
+
+    for (uint32_t i = 0; i < backendContext->maxEffectContexts; ++i)
+    {
+        for (BackendContext_VK::CachedImageView& entry : backendContext->pEffectContexts[i].imageViewCache)
+        {
+            if (entry.imageView != VK_NULL_HANDLE && (image == VK_NULL_HANDLE || entry.image == image))
+                entry.invalidated = true;
+        }
+    }
+
+    return FFX_OK;
+}
+
 FfxErrorCode BreadcrumbsAllocBlockVK(
     FfxInterface* backendInterface,
     uint64_t blockBytes,
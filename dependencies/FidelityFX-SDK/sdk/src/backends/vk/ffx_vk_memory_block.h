@@ -0,0 +1,110 @@
+// DLSSG-TO-FSR3: Free list of a device memory block shared by several resources. Only offsets are tracked here, so the
+// bookkeeping can be tested without a device.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+#define FFX_MAX_MEMORY_BLOCK_RANGES       (64) // Free ranges per block, which also caps the allocations in it
+
+typedef struct FfxMemoryRange {
+    uint64_t    offset;
+    uint64_t    size;
+} FfxMemoryRange;
+
+typedef struct FfxMemoryBlockRanges {
+    uint64_t        size;
+    uint32_t        allocationCount;
+    uint32_t        freeRangeCount;
+    FfxMemoryRange  freeRanges[FFX_MAX_MEMORY_BLOCK_RANGES];  // Sorted by offset, never adjacent to each other
+} FfxMemoryBlockRanges;
+
+inline void ffxMemoryBlockReset(FfxMemoryBlockRanges& block, uint64_t size)
+{
+    block.size = size;
+    block.allocationCount = 0;
+    block.freeRangeCount = 1;
+    block.freeRanges[0].offset = 0;
+    block.freeRanges[0].size = size;
+}
+
+// First fit. Ranges start at the resource alignment and end on granularity (bufferImageGranularity), which keeps
+// linear and optimal resources from sharing a page without tracking what's next to what. Alignment and granularity
+// are powers of two.
+inline bool ffxMemoryBlockAllocate(FfxMemoryBlockRanges& block, uint64_t size, uint64_t alignment, uint64_t granularity, uint64_t* outOffset, uint64_t* outRangeSize)
+{
+    // Every allocation adds at most one free range
+    if (block.allocationCount + 1 >= FFX_MAX_MEMORY_BLOCK_RANGES)
+        return false;
+
+    for (uint32_t i = 0; i < block.freeRangeCount; ++i)
+    {
+        const uint64_t rangeOffset = block.freeRanges[i].offset;
+        const uint64_t rangeEnd = rangeOffset + block.freeRanges[i].size;
+        const uint64_t offset = (rangeOffset + alignment - 1) & ~(alignment - 1);
+        const uint64_t end = (offset + size + granularity - 1) & ~(granularity - 1);
+
+        if (end > rangeEnd)
+            continue;
+
+        // Keep the alignment padding in front and the remainder behind as free ranges
+        if (offset > rangeOffset && end < rangeEnd) {
+            memmove(&block.freeRanges[i + 2], &block.freeRanges[i + 1], (block.freeRangeCount - i - 1) * sizeof(FfxMemoryRange));
+            block.freeRanges[i].size = offset - rangeOffset;
+            block.freeRanges[i + 1].offset = end;
+            block.freeRanges[i + 1].size = rangeEnd - end;
+            block.freeRangeCount++;
+        }
+        else if (offset > rangeOffset) {
+            block.freeRanges[i].size = offset - rangeOffset;
+        }
+        else if (end < rangeEnd) {
+            block.freeRanges[i].offset = end;
+            block.freeRanges[i].size = rangeEnd - end;
+        }
+        else {
+            memmove(&block.freeRanges[i], &block.freeRanges[i + 1], (block.freeRangeCount - i - 1) * sizeof(FfxMemoryRange));
+            block.freeRangeCount--;
+        }
+
+        block.allocationCount++;
+        *outOffset = offset;
+        *outRangeSize = end - offset;
+        return true;
+    }
+
+    return false;
+}
+
+// Returns a range handed out by ffxMemoryBlockAllocate and merges it with free neighbours
+inline void ffxMemoryBlockFree(FfxMemoryBlockRanges& block, uint64_t offset, uint64_t size)
+{
+    uint32_t next = 0;
+    while (next < block.freeRangeCount && block.freeRanges[next].offset < offset)
+        next++;
+
+    const bool mergePrevious = next > 0 && block.freeRanges[next - 1].offset + block.freeRanges[next - 1].size == offset;
+    const bool mergeNext = next < block.freeRangeCount && offset + size == block.freeRanges[next].offset;
+
+    if (mergePrevious && mergeNext) {
+        block.freeRanges[next - 1].size += size + block.freeRanges[next].size;
+        memmove(&block.freeRanges[next], &block.freeRanges[next + 1], (block.freeRangeCount - next - 1) * sizeof(FfxMemoryRange));
+        block.freeRangeCount--;
+    }
+    else if (mergePrevious) {
+        block.freeRanges[next - 1].size += size;
+    }
+    else if (mergeNext) {
+        block.freeRanges[next].offset = offset;
+        block.freeRanges[next].size += size;
+    }
+    else {
+        memmove(&block.freeRanges[next + 1], &block.freeRanges[next], (block.freeRangeCount - next) * sizeof(FfxMemoryRange));
+        block.freeRanges[next].offset = offset;
+        block.freeRanges[next].size = size;
+        block.freeRangeCount++;
+    }
+
+    block.allocationCount--;
+}
@@ -287,18 +287,20 @@ static FfxErrorCode createPipelineStates(FfxFrameInterpolationContext_Private* c
     uint32_t contextFlags = context->contextDescription.flags;
 
     // Set up pipeline descriptor (basically RootSignature and binding)
+    // DLSSG-TO-FSR3: Pipelines are queued and built in parallel below
+    FfxPipelineCreationJob pipelineJobs[FFX_FRAMEINTERPOLATION_PASS_COUNT] = {};
+    uint32_t pipelineJobCount = 0;
+
     auto CreateComputePipeline = [&](FfxPass pass, const wchar_t* name, FfxPipelineState* pipeline) -> FfxErrorCode {
+        FFX_ASSERT(pipelineJobCount < FFX_FRAMEINTERPOLATION_PASS_COUNT);
         ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pipeline, context->effectContextId);
         wcscpy_s(pipelineDescription.name, name);
-        FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(
-            &context->contextDescription.backendInterface,
-            FFX_EFFECT_FRAMEINTERPOLATION,
-            pass,
-            getPipelinePermutationFlags(contextFlags, pass, supportedFP16, canForceWave64, useLut),
-            &pipelineDescription,
-            context->effectContextId,
-            pipeline));
-        patchResourceBindings(pipeline);
+
+        FfxPipelineCreationJob& job = pipelineJobs[pipelineJobCount++];
+        job.pass = pass;
+        job.permutationOptions = getPipelinePermutationFlags(contextFlags, pass, supportedFP16, canForceWave64, useLut);
+        job.description = pipelineDescription;
+        job.pipeline = pipeline;
 
         return FFX_OK;
     };
@@ -332,6 +334,17 @@ static FfxErrorCode createPipelineStates(FfxFrameInterpolationContext_Private* c
     CreateComputePipeline(FFX_FRAMEINTERPOLATION_PASS_GAME_VECTOR_FIELD_INPAINTING_PYRAMID, L"GAME_VECTOR_FIELD_INPAINTING_PYRAMID", & context->pipelineGameVectorFieldInpaintingPyramid);
     CreateComputePipeline(FFX_FRAMEINTERPOLATION_PASS_DEBUG_VIEW,                           L"DEBUG_VIEW", &context->pipelineDebugView);
 
+    // DLSSG-TO-FSR3
+    FFX_VALIDATE(ffxCreatePipelinesParallel(
+        &context->contextDescription.backendInterface,
+        FFX_EFFECT_FRAMEINTERPOLATION,
+        context->effectContextId,
+        pipelineJobs,
+        pipelineJobCount));
+
+    for (uint32_t i = 0; i < pipelineJobCount; i++)
+        patchResourceBindings(pipelineJobs[i].pipeline);
+
     return FFX_OK;
 }
 
@@ -964,6 +977,10 @@ FFX_API FfxErrorCode ffxFrameInterpolationDispatch(FfxFrameInterpolationContext*
     const float cameraAngleHorizontal                   = atan(tan(params->cameraFovAngleVertical / 2) * aspectRatio) * 2;
     contextPrivate->constants.fTanHalfFOV               = tanf(cameraAngleHorizontal * 0.5f);
 
+    // DLSSG-TO-FSR3: Arbitrary timestep support for multi frame generation
+    const bool bValidInterpolationFactor                = params->interpolationFactor > 0.0f && params->interpolationFactor < 1.0f;
+    contextPrivate->constants.interpolationFactor       = bValidInterpolationFactor ? params->interpolationFactor : 0.5f;
+
     const bool bUseExternalDistortionFieldResource = !ffxFrameInterpolationResourceIsNull(params->distortionField);
     if (bUseExternalDistortionFieldResource)
     {
@@ -1067,8 +1084,9 @@ FFX_API FfxErrorCode ffxFrameInterpolationDispatch(FfxFrameInterpolationContext*
     uint32_t renderDispatchSizeX = uint32_t(params->renderSize.width + 7) / 8;
     uint32_t renderDispatchSizeY = uint32_t(params->renderSize.height + 7) / 8;
 
-    uint32_t opticalFlowDispatchSizeX = uint32_t(params->displaySize.width / float(params->opticalFlowBlockSize) + 7) / 8;
-    uint32_t opticalFlowDispatchSizeY = uint32_t(params->displaySize.height / float(params->opticalFlowBlockSize) + 7) / 8;
+    // DLSSG-TO-FSR3: Optical flow only covers the interpolation rect
+    uint32_t opticalFlowDispatchSizeX = uint32_t(params->interpolationRect.width / float(params->opticalFlowBlockSize) + 7) / 8;
+    uint32_t opticalFlowDispatchSizeY = uint32_t(params->interpolationRect.height / float(params->opticalFlowBlockSize) + 7) / 8;
 
     const bool bExecutePreparationPasses = (false == contextPrivate->constants.Reset);
 
@@ -1181,6 +1199,7 @@ FFX_API FfxErrorCode ffxFrameInterpolationDispatch(FfxFrameInterpolationContext*
         }
 
         // store current buffer
+        if (!(params->flags & FFX_FRAMEINTERPOLATION_DISPATCH_SKIP_STORE_INTERPOLATION_SOURCE)) // DLSSG-TO-FSR3
         {
             FfxGpuJobDescription copyJobs[] = { {FFX_GPU_JOB_COPY} };
             FfxResourceInternal  copySources[_countof(copyJobs)] = { contextPrivate->srvResources[FFX_FRAMEINTERPOLATION_RESOURCE_IDENTIFIER_CURRENT_INTERPOLATION_SOURCE] };
@@ -77,7 +77,7 @@ typedef struct FrameInterpolationConstants
 
     float    minMaxLuminance[2];
     float    fTanHalfFOV;
-    float   _pad1;
+    float    interpolationFactor; // DLSSG-TO-FSR3: Was _pad1
 
     float   jitter[2];
     float   motionVectorScale[2];
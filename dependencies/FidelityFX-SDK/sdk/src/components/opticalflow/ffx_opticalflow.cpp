@@ -200,19 +200,21 @@ static FfxErrorCode createPipelineStates(FfxOpticalflowContext_Private* context)
 
     uint32_t contextFlags = context->contextDescription.flags;
 
+    // DLSSG-TO-FSR3: Pipelines are queued and built in parallel below
+    FfxPipelineCreationJob pipelineJobs[FFX_OPTICALFLOW_PASS_COUNT] = {};
+    uint32_t pipelineJobCount = 0;
+
     auto CreateComputePipeline = [&](FfxPass pass, const wchar_t* name, FfxPipelineState* pipeline) -> FfxErrorCode {
+        FFX_ASSERT(pipelineJobCount < FFX_OPTICALFLOW_PASS_COUNT);
         ffxSafeReleasePipeline(&context->contextDescription.backendInterface, pipeline, context->effectContextId);
         wcscpy_s(pipelineDescription.name, name);
-        FFX_VALIDATE(context->contextDescription.backendInterface.fpCreatePipeline(
-            &context->contextDescription.backendInterface,
-            FFX_EFFECT_OPTICALFLOW,
-            pass,
-            getPipelinePermutationFlags(contextFlags, pass, supportedFP16, canForceWave64, useLut),
-            &pipelineDescription,
-            context->effectContextId,
-            pipeline));
 
-        patchResourceBindings(pipeline);
+        FfxPipelineCreationJob& job = pipelineJobs[pipelineJobCount++];
+        job.pass = pass;
+        job.permutationOptions = getPipelinePermutationFlags(contextFlags, pass, supportedFP16, canForceWave64, useLut);
+        job.description = pipelineDescription;
+        job.pipeline = pipeline;
+
         return FFX_OK;
     };
 
@@ -225,6 +227,17 @@ static FfxErrorCode createPipelineStates(FfxOpticalflowContext_Private* context)
     CreateComputePipeline(FFX_OPTICALFLOW_PASS_FILTER_OPTICAL_FLOW_V5, L"Opticalflow_Filter", &context->pipelineFilterOpticalFlowV5);
     CreateComputePipeline(FFX_OPTICALFLOW_PASS_SCALE_OPTICAL_FLOW_ADVANCED_V5, L"Opticalflow_Upscale", &context->pipelineScaleOpticalFlowAdvancedV5);
 
+    // DLSSG-TO-FSR3
+    FFX_VALIDATE(ffxCreatePipelinesParallel(
+        &context->contextDescription.backendInterface,
+        FFX_EFFECT_OPTICALFLOW,
+        context->effectContextId,
+        pipelineJobs,
+        pipelineJobCount));
+
+    for (uint32_t i = 0; i < pipelineJobCount; i++)
+        patchResourceBindings(pipelineJobs[i].pipeline);
+
     return FFX_OK;
 }
 
@@ -535,6 +548,13 @@ static FfxErrorCode dispatch(FfxOpticalflowContext_Private* context, const FfxOp
     int advancedAlgorithmIterations = 7;
     uint32_t opticalFlowBlockSize = 8;
 
+    // DLSSG-TO-FSR3: Process the dispatch extent instead of the context extent. Contexts are allocated at a maximum size.
+    const FfxDimensions2D resolution = { params->color.description.width, params->color.description.height };
+    context->constants.inputLumaResolution[0] = resolution.width;
+    context->constants.inputLumaResolution[1] = resolution.height;
+    context->constants.inputColorOffset[0] = params->colorOffset.x;
+    context->constants.inputColorOffset[1] = params->colorOffset.y;
+
     if (context->refreshPipelineStates) {
 
         context->refreshPipelineStates = false;
@@ -629,8 +649,8 @@ static FfxErrorCode dispatch(FfxOpticalflowContext_Private* context, const FfxOp
     FfxUInt32x2 workGroupOffset;
     FfxUInt32x2 numWorkGroupsAndMips;
     FfxUInt32x4 rectInfo = { 0, 0,
-        context->contextDescription.resolution.width * resolutionMultiplier,
-        context->contextDescription.resolution.height * resolutionMultiplier };
+        resolution.width * resolutionMultiplier,
+        resolution.height * resolutionMultiplier };
     ffxSpdSetup(threadGroupSizeOpticalFlowInputPyramid, workGroupOffset, numWorkGroupsAndMips, rectInfo, 4);
 
     OpticalFlowSpdConstants luminancePyramidConstants;
@@ -677,8 +697,8 @@ static FfxErrorCode dispatch(FfxOpticalflowContext_Private* context, const FfxOp
             int32_t threadGroupSizeY = 16;
             uint32_t threadPixelsX = 2;
             uint32_t threadPixelsY = 2;
-            int32_t dispatchX = ((context->contextDescription.resolution.width + (threadPixelsX - 1)) / threadPixelsX + (threadGroupSizeX - 1)) / threadGroupSizeX;
-            int32_t dispatchY = ((context->contextDescription.resolution.height + (threadPixelsY - 1)) / threadPixelsY + (threadGroupSizeY - 1)) / threadGroupSizeY;
+            int32_t dispatchX = ((resolution.width + (threadPixelsX - 1)) / threadPixelsX + (threadGroupSizeX - 1)) / threadGroupSizeX;
+            int32_t dispatchY = ((resolution.height + (threadPixelsY - 1)) / threadPixelsY + (threadGroupSizeY - 1)) / threadGroupSizeY;
             scheduleDispatch(context, &context->pipelinePrepareLuma, L"OF PrepareLuma", dispatchX, dispatchY);
         }
 
@@ -696,8 +716,8 @@ static FfxErrorCode dispatch(FfxOpticalflowContext_Private* context, const FfxOp
                 {
                     const uint32_t threadGroupSizeX = 32;
                     const uint32_t threadGroupSizeY = 8;
-                    const uint32_t strataWidth = (context->contextDescription.resolution.width / 4) / HistogramsPerDim;
-                    const uint32_t strataHeight = context->contextDescription.resolution.height / HistogramsPerDim;
+                    const uint32_t strataWidth = (resolution.width / 4) / HistogramsPerDim;
+                    const uint32_t strataHeight = resolution.height / HistogramsPerDim;
                     const uint32_t dispatchX = (strataWidth + threadGroupSizeX - 1) / threadGroupSizeX;
                     const uint32_t dispatchY = 16;
                     const uint32_t dispatchZ = HistogramsPerDim * HistogramsPerDim;
@@ -714,7 +734,7 @@ static FfxErrorCode dispatch(FfxOpticalflowContext_Private* context, const FfxOp
             const int pyramidMaxIterations = advancedAlgorithmIterations;
             FFX_ASSERT(pyramidMaxIterations <= OpticalFlowMaxPyramidLevels);
 
-            opticalFlowTextureSizes[0] = GetOpticalFlowTextureSize(context->contextDescription.resolution, opticalFlowBlockSize);
+            opticalFlowTextureSizes[0] = GetOpticalFlowTextureSize(resolution, opticalFlowBlockSize);
             for (int i = 1; i < pyramidMaxIterations; i++)
             {
                 opticalFlowTextureSizes[i] = {
@@ -743,8 +763,8 @@ static FfxErrorCode dispatch(FfxOpticalflowContext_Private* context, const FfxOp
                 context->srvBindings[FFX_OF_BINDING_IDENTIFIER_OPTICAL_FLOW_PREVIOUS] = context->resources[opticalFlowResourceIndexB + level];
 
                 {
-                    const FfxUInt32 inputLumaWidth = ffxMax(context->contextDescription.resolution.width >> level, 1);
-                    const FfxUInt32 inputLumaHeight = ffxMax(context->contextDescription.resolution.height >> level, 1);
+                    const FfxUInt32 inputLumaWidth = ffxMax(resolution.width >> level, 1);
+                    const FfxUInt32 inputLumaHeight = ffxMax(resolution.height >> level, 1);
                     std::wstring pipelineName = L"OF " + std::to_wstring(level) + L" Search";
 
                     {
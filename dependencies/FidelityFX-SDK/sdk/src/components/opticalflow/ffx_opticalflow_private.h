@@ -78,6 +78,7 @@ typedef struct OpticalflowConstants
     int32_t frameIndex;
     uint32_t backbufferTransferFunction;
     float minMaxLuminance[2];
+    int32_t inputColorOffset[2]; // DLSSG-TO-FSR3
 } OpticalflowConstants;
 
 typedef struct FfxOpticalflowContext_Private
@@ -23,6 +23,13 @@
 #include <FidelityFX/host/ffx_interface.h>
 #include "ffx_object_management.h"
 
+#include <algorithm>    // DLSSG-TO-FSR3
+#include <atomic>
+#include <future>
+#include <system_error>
+#include <thread>
+#include <vector>
+
 void ffxSafeReleasePipeline(FfxInterface* backendInterface, FfxPipelineState* pipeline, FfxUInt32 effectContextId)
 {
     FFX_ASSERT(pipeline);
@@ -46,3 +53,70 @@ void ffxSafeReleaseResource(FfxInterface* backendInterface, FfxResourceInternal
 
     backendInterface->fpDestroyResource(backendInterface, resource, effectContextId);
 }
+
+// DLSSG-TO-FSR3
+FfxErrorCode ffxCreatePipelinesParallel(FfxInterface* backendInterface, FfxEffect effect, FfxUInt32 effectContextId, FfxPipelineCreationJob* jobs, uint32_t jobCount)
+{
+    FFX_ASSERT(backendInterface->fpCreatePipeline);
+
+    std::vector<FfxErrorCode> results(jobCount, FFX_ERROR_BACKEND_API_ERROR);
+    std::atomic<uint32_t>     nextJob(0);
+
+    auto worker = [&]() {
+        for (uint32_t i = nextJob++; i < jobCount; i = nextJob++)
+        {
+            FfxPipelineCreationJob& job = jobs[i];
+            results[i] = backendInterface->fpCreatePipeline(backendInterface, effect, job.pass, job.permutationOptions, &job.description, effectContextId, job.pipeline);
+        }
+    };
+
+    // The calling thread takes jobs as well. Helpers come out of a budget shared by every concurrent call, so several
+    // contexts being built at once can't oversubscribe the CPU. Whatever helpers can't be had are simply made up for
+    // by the callers. std::async runs them on the process thread pool with MSVC, so no threads are created per call.
+    static std::atomic<uint32_t> availableHelpers(FFX_MAX_PIPELINE_CREATION_THREADS - 1);
+
+    const uint32_t threadCount   = std::min({ jobCount, std::max(std::thread::hardware_concurrency(), 1u), (uint32_t)FFX_MAX_PIPELINE_CREATION_THREADS });
+    const uint32_t wantedHelpers = std::max(threadCount, 1u) - 1;
+    uint32_t       helperCount   = availableHelpers.load();
+
+    while (!availableHelpers.compare_exchange_weak(helperCount, helperCount - std::min(helperCount, wantedHelpers)))
+        ;
+
+    helperCount = std::min(helperCount, wantedHelpers);
+    std::vector<std::future<void>> helpers;
+
+    for (uint32_t i = 0; i < helperCount; i++)
+    {
+        try
+        {
+            helpers.emplace_back(std::async(std::launch::async, worker));
+        }
+        catch (const std::system_error&)
+        {
+            break;
+        }
+    }
+
+    worker();
+
+    for (std::future<void>& helper : helpers)
+        helper.wait();
+
+    availableHelpers += helperCount;
+
+    for (uint32_t i = 0; i < jobCount; i++)
+    {
+        if (results[i] == FFX_OK)
+            continue;
+
+        for (uint32_t j = 0; j < jobCount; j++)
+        {
+            if (results[j] == FFX_OK)
+                ffxSafeReleasePipeline(backendInterface, jobs[j].pipeline, effectContextId);
+        }
+
+        return results[i];
+    }
+
+    return FFX_OK;
+}
@@ -33,6 +33,25 @@ FFX_API void ffxSafeReleasePipeline(FfxInterface* backendInterface, FfxPipelineS
 FFX_API void ffxSafeReleaseCopyResource(FfxInterface* backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId);
 FFX_API void ffxSafeReleaseResource(FfxInterface* backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId);
 
+// DLSSG-TO-FSR3: Upper bound on threads used by ffxCreatePipelinesParallel. Every caller works on its own jobs, and
+// all concurrent calls share FFX_MAX_PIPELINE_CREATION_THREADS - 1 helpers.
+#define FFX_MAX_PIPELINE_CREATION_THREADS 8
+
+// DLSSG-TO-FSR3: A single pipeline built by ffxCreatePipelinesParallel
+typedef struct FfxPipelineCreationJob
+{
+    FfxPass                 pass;
+    uint32_t                permutationOptions;
+    FfxPipelineDescription  description;        // Per job copy. Only the pointed to samplers and root constants are shared.
+    FfxPipelineState*       pipeline;
+} FfxPipelineCreationJob;
+
+// DLSSG-TO-FSR3: Build every pipeline in jobs across a bounded set of threads and wait for them. Backend
+// fpCreatePipeline implementations must be thread-safe, see FfxCreatePipelineFunc. Every pipeline is written to its
+// own job's destination, so the result doesn't depend on scheduling. On failure, the pipelines that were created are released
+// again and the error of the first failing job, in array order, is returned.
+FFX_API FfxErrorCode ffxCreatePipelinesParallel(FfxInterface* backendInterface, FfxEffect effect, FfxUInt32 effectContextId, FfxPipelineCreationJob* jobs, uint32_t jobCount);
+
 #if defined(__cplusplus)
 }
 #endif  // #if defined(__cplusplus)
@@ -0,0 +1,148 @@
+#include <format>
+#include <thread>
+#include <Windows.h>
+#include "Config.h"
+#include "Util.h"
+
+namespace Config
+{
+	constexpr std::wstring_view IniFileName = L"dlssg_to_fsr3.ini";
+
+	static std::atomic<std::shared_ptr<const Configuration>> CurrentConfiguration;
+	static std::mutex ReloadMutex;
+
+	static Configuration LoadFromDisk()
+	{
+		std::string iniText;
+
+		if (std::ifstream file(std::filesystem::path(Util::GetThisDllPath()) / IniFileName, std::ios::binary); file)
+			iniText.assign(std::istreambuf_iterator<char>(file), {});
+
+		return Parse(
+			iniText,
+			[](std::string_view Key) -> std::optional<std::string>
+			{
+				char value[64] = {};
+				const auto name = std::format("DLSSGTOFSR3_{}", Key);
+				const auto length = GetEnvironmentVariableA(name.c_str(), value, static_cast<DWORD>(std::size(value)));
+
+				if (length == 0 || length >= std::size(value))
+					return std::nullopt;
+
+				return std::string(value, length);
+			});
+	}
+
+	std::shared_ptr<const Configuration> Get()
+	{
+		if (auto config = CurrentConfiguration.load(std::memory_order_acquire)) [[likely]]
+			return config;
+
+		Reload();
+		return CurrentConfiguration.load(std::memory_order_acquire);
+	}
+
+	bool Reload()
+	{
+		std::scoped_lock lock(ReloadMutex);
+
+		const auto previous = CurrentConfiguration.load(std::memory_order_relaxed);
+		auto config = std::make_shared<const Configuration>(LoadFromDisk());
+
+		if (previous && *previous == *config)
+			return false;
+
+		CurrentConfiguration.store(std::move(config), std::memory_order_release);
+
+		if (previous)
+			spdlog::info("Configuration changed. Settings read at feature creation apply to new features only.");
+
+		return true;
+	}
+
+	static void HotReloadThread()
+	{
+		const auto directory = CreateFileW(
+			Util::GetThisDllPath().c_str(),
+			FILE_LIST_DIRECTORY,
+			FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_FLAG_BACKUP_SEMANTICS,
+			nullptr);
+
+		if (directory == INVALID_HANDLE_VALUE)
+		{
+			spdlog::error("Failed to watch dlssg_to_fsr3.ini for changes: {:X}", GetLastError());
+			return;
+		}
+
+		alignas(DWORD) uint8_t buffer[4096];
+
+		while (true)
+		{
+			DWORD bytesReturned = 0;
+
+			if (!ReadDirectoryChangesW(
+					directory,
+					buffer,
+					sizeof(buffer),
+					false,
+					FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME,
+					&bytesReturned,
+					nullptr,
+					nullptr))
+			{
+				spdlog::error("Stopped watching dlssg_to_fsr3.ini for changes: {:X}", GetLastError());
+				break;
+			}
+
+			// The log lives in the same directory. Ignore everything but the ini. An empty result means the
+			// notification buffer overflowed.
+			bool iniChanged = bytesReturned == 0;
+
+			for (DWORD offset = 0; !iniChanged && offset < bytesReturned;)
+			{
+				const auto info = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(buffer + offset);
+				const std::wstring_view fileName(info->FileName, info->FileNameLength / sizeof(wchar_t));
+
+				iniChanged = CompareStringOrdinal(
+								 fileName.data(),
+								 static_cast<int>(fileName.size()),
+								 IniFileName.data(),
+								 static_cast<int>(IniFileName.size()),
+								 true) == CSTR_EQUAL;
+
+				if (info->NextEntryOffset == 0)
+					break;
+
+				offset += info->NextEntryOffset;
+			}
+
+			if (!iniChanged)
+				continue;
+
+			// Editors tend to save in several steps
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			Reload();
+		}
+
+		CloseHandle(directory);
+	}
+
+	void StartHotReload()
+	{
+		if (!Get()->EnableConfigurationHotReload)
+			return;
+
+		static bool once = []()
+		{
+			spdlog::info("Watching dlssg_to_fsr3.ini for changes.");
+
+			// Runs until the process exits. It's blocked in ReadDirectoryChangesW and can't be joined from DllMain.
+			Util::PinThisDll();
+			std::thread(HotReloadThread).detach();
+			return true;
+		}();
+	}
+}
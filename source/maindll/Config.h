@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Settings from the [Debug] section of dlssg_to_fsr3.ini. A DLSSGTOFSR3_<Key> environment variable overrides the ini
+// value. See resources/dlssg_to_fsr3.ini for descriptions.
+struct Configuration
+{
+	bool EnableDebugOverlay = false;
+	bool EnableDebugTearLines = false;
+	bool EnableInterpolatedFramesOnly = false;
+	uint32_t MaxDisplayWidth = 0;
+	uint32_t MaxDisplayHeight = 0;
+	bool EnableFrameGenerationGovernor = false;
+	uint32_t GovernorTargetFrameRate = 0;
+	bool EnableHostStageProfiling = false;
+	uint32_t HostStageProfilingFrames = 600;
+	bool EnableGpuPassTimings = false;
+	uint32_t GpuPassTimingsWindow = 600;
+	bool GpuPassTimingsCSV = false;
+	bool EnableTracing = false;
+	bool EnableFrameCapture = false;
+	uint32_t FrameCaptureFrames = 60;
+	bool EnableLiveMetrics = false;
+	bool EnableSynchronousLogging = false;
+	bool EnableConfigurationHotReload = false;
+	bool EnableVulkanPipelineCache = true;
+	bool EnableVulkanPushDescriptors = false;
+	uint32_t MaxCachedInterpolationContexts = 3;
+	uint32_t CachedInterpolationContextVRAMBudget = 512; // MB
+
+	bool operator==(const Configuration&) const = default;
+};
+
+namespace Config
+{
+	// Settings are parsed into immutable snapshots published through an atomic shared pointer. Holders keep their
+	// snapshot alive and consistent across a reload, and the old one is freed once the last holder lets go. Read it once
+	// per operation and keep the pointer rather than calling Get for every value.
+	//
+	// A reload only affects code that reads the snapshot afterwards, so settings apply at different times:
+	//
+	//   Next frame:             EnableDebugOverlay, EnableDebugTearLines, EnableInterpolatedFramesOnly
+	//   Next feature creation:  MaxDisplayWidth, MaxDisplayHeight, EnableFrameGenerationGovernor,
+	//                           GovernorTargetFrameRate, EnableHostStageProfiling, HostStageProfilingFrames,
+	//                           EnableFrameCapture, FrameCaptureFrames, CachedInterpolationContextVRAMBudget
+	//   Next backend interface: EnableVulkanPipelineCache, EnableVulkanPushDescriptors, EnableGpuPassTimings,
+	//                           GpuPassTimingsWindow, MaxCachedInterpolationContexts. Interfaces are shared by every
+	//                           feature on a device and only recreated once all of them are released.
+	//   Process start only:     EnableSynchronousLogging, EnableTracing, EnableLiveMetrics, GpuPassTimingsCSV,
+	//                           EnableConfigurationHotReload
+	//
+	// Creating a feature reloads as well, so hot reload only matters for the per-frame settings.
+	std::shared_ptr<const Configuration> Get();
+
+	// Returns true if any value changed
+	bool Reload();
+
+	// Watches dlssg_to_fsr3.ini and reloads on changes when EnableConfigurationHotReload is set
+	void StartHotReload();
+
+	// Platform independent. GetEnvironmentValue returns the value of DLSSGTOFSR3_<Key> if set.
+	Configuration Parse(
+		std::string_view IniText,
+		const std::function<std::optional<std::string>(std::string_view Key)>& GetEnvironmentValue);
+}
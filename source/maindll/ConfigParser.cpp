@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <charconv>
+#include "Config.h"
+
+// Platform independent half of Config, shared with the host tests
+namespace Config
+{
+	using FieldPointer = std::variant<bool Configuration::*, uint32_t Configuration::*>;
+
+	static const std::pair<std::string_view, FieldPointer> Fields[] = {
+		{ "EnableDebugOverlay", &Configuration::EnableDebugOverlay },
+		{ "EnableDebugTearLines", &Configuration::EnableDebugTearLines },
+		{ "EnableInterpolatedFramesOnly", &Configuration::EnableInterpolatedFramesOnly },
+		{ "MaxDisplayWidth", &Configuration::MaxDisplayWidth },
+		{ "MaxDisplayHeight", &Configuration::MaxDisplayHeight },
+		{ "EnableFrameGenerationGovernor", &Configuration::EnableFrameGenerationGovernor },
+		{ "GovernorTargetFrameRate", &Configuration::GovernorTargetFrameRate },
+		{ "EnableHostStageProfiling", &Configuration::EnableHostStageProfiling },
+		{ "HostStageProfilingFrames", &Configuration::HostStageProfilingFrames },
+		{ "EnableGpuPassTimings", &Configuration::EnableGpuPassTimings },
+		{ "GpuPassTimingsWindow", &Configuration::GpuPassTimingsWindow },
+		{ "GpuPassTimingsCSV", &Configuration::GpuPassTimingsCSV },
+		{ "EnableTracing", &Configuration::EnableTracing },
+		{ "EnableFrameCapture", &Configuration::EnableFrameCapture },
+		{ "FrameCaptureFrames", &Configuration::FrameCaptureFrames },
+		{ "EnableLiveMetrics", &Configuration::EnableLiveMetrics },
+		{ "EnableSynchronousLogging", &Configuration::EnableSynchronousLogging },
+		{ "EnableConfigurationHotReload", &Configuration::EnableConfigurationHotReload },
+		{ "EnableVulkanPipelineCache", &Configuration::EnableVulkanPipelineCache },
+		{ "EnableVulkanPushDescriptors", &Configuration::EnableVulkanPushDescriptors },
+		{ "MaxCachedInterpolationContexts", &Configuration::MaxCachedInterpolationContexts },
+		{ "CachedInterpolationContextVRAMBudget", &Configuration::CachedInterpolationContextVRAMBudget },
+	};
+
+	static std::string_view Trim(std::string_view Text)
+	{
+		const auto start = Text.find_first_not_of(" \t\r");
+
+		if (start == std::string_view::npos)
+			return {};
+
+		return Text.substr(start, Text.find_last_not_of(" \t\r") - start + 1);
+	}
+
+	static bool EqualsIgnoreCase(std::string_view A, std::string_view B)
+	{
+		return std::ranges::equal(A, B, [](char X, char Y) { return std::tolower(static_cast<unsigned char>(X)) == std::tolower(static_cast<unsigned char>(Y)); });
+	}
+
+	// Same results as GetPrivateProfileInt: leading digits only, zero for anything else or negative values
+	static uint32_t ParseIniInteger(std::string_view Text)
+	{
+		uint32_t value = 0;
+		std::from_chars(Text.data(), Text.data() + Text.size(), value);
+
+		return value;
+	}
+
+	Configuration Parse(
+		std::string_view IniText,
+		const std::function<std::optional<std::string>(std::string_view Key)>& GetEnvironmentValue)
+	{
+		// The first occurrence of a key wins, same as GetPrivateProfileInt
+		std::vector<std::pair<std::string_view, std::string_view>> iniValues;
+		bool inDebugSection = false;
+
+		if (IniText.starts_with("\xEF\xBB\xBF"))
+			IniText.remove_prefix(3);
+
+		while (!IniText.empty())
+		{
+			const auto lineEnd = IniText.find('\n');
+			const auto line = Trim(IniText.substr(0, lineEnd));
+			IniText.remove_prefix(lineEnd == std::string_view::npos ? IniText.size() : lineEnd + 1);
+
+			if (line.empty() || line.front() == ';')
+				continue;
+
+			if (line.front() == '[')
+			{
+				inDebugSection = line.ends_with(']') && EqualsIgnoreCase(Trim(line.substr(1, line.size() - 2)), "Debug");
+				continue;
+			}
+
+			if (const auto separator = line.find('='); inDebugSection && separator != std::string_view::npos)
+				iniValues.emplace_back(Trim(line.substr(0, separator)), Trim(line.substr(separator + 1)));
+		}
+
+		Configuration config;
+
+		for (const auto& [key, field] : Fields)
+		{
+			const auto environmentValue = GetEnvironmentValue(key);
+			const auto iniValue = std::ranges::find_if(iniValues, [&](const auto& Entry) { return EqualsIgnoreCase(Entry.first, key); });
+
+			if (auto boolField = std::get_if<bool Configuration::*>(&field))
+			{
+				// Environment overrides are only honored when they're a single character
+				if (environmentValue && environmentValue->size() == 1)
+					config.*(*boolField) = environmentValue->front() == '1';
+				else if (iniValue != iniValues.end())
+					config.*(*boolField) = ParseIniInteger(iniValue->second) != 0;
+			}
+			else if (auto integerField = std::get_if<uint32_t Configuration::*>(&field))
+			{
+				if (environmentValue && !environmentValue->empty())
+					config.*(*integerField) = static_cast<uint32_t>(std::strtoul(environmentValue->c_str(), nullptr, 10));
+				else if (iniValue != iniValues.end())
+					config.*(*integerField) = ParseIniInteger(iniValue->second);
+			}
+		}
+
+		return config;
+	}
+}
@@ -0,0 +1,173 @@
+#include <numbers>
+#include "NGX/NvNGX.h"
+#include "DLSSGFrameInputs.h"
+
+void DLSSGFrameInputs::Load(NGXInstanceParameters *NGXParameters)
+{
+	EnableInterp = NGXParameters->GetUIntOrDefault("DLSSG.EnableInterp", 0) != 0;
+	Reset = NGXParameters->GetUIntOrDefault("DLSSG.Reset", 0) != 0;
+	HDR = NGXParameters->GetUIntOrDefault("DLSSG.ColorBuffersHDR", 0) != 0;
+	MvecJittered = NGXParameters->GetUIntOrDefault("DLSSG.MvecJittered", 0) != 0;
+	MvecDilated = NGXParameters->GetUIntOrDefault("DLSSG.MvecDilated", 0) != 0;
+	DistortionFieldLowPrecision =
+		NGXParameters->GetUIntOrDefault("DLSSG.BidirectionalDistortionFieldLowPrecision.IsLowPrecision", 0) != 0;
+
+	MultiFrameCount = NGXParameters->GetUIntOrDefault("DLSSG.MultiFrameCount", 1);
+	MultiFrameIndex = NGXParameters->GetUIntOrDefault("DLSSG.MultiFrameIndex", 1);
+
+	DepthSubrect = {
+		NGXParameters->GetUIntOrDefault("DLSSG.DepthSubrectWidth", 0),
+		NGXParameters->GetUIntOrDefault("DLSSG.DepthSubrectHeight", 0),
+	};
+
+	HUDLessSubrectBase = {
+		static_cast<int32_t>(NGXParameters->GetUIntOrDefault("DLSSG.HUDLessSubrectBaseX", 0)),
+		static_cast<int32_t>(NGXParameters->GetUIntOrDefault("DLSSG.HUDLessSubrectBaseY", 0)),
+	};
+
+	HUDLessSubrect = {
+		NGXParameters->GetUIntOrDefault("DLSSG.HUDLessSubrectWidth", 0),
+		NGXParameters->GetUIntOrDefault("DLSSG.HUDLessSubrectHeight", 0),
+	};
+
+	MVecsSubrect = {
+		NGXParameters->GetUIntOrDefault("DLSSG.MVecsSubrectWidth", 0),
+		NGXParameters->GetUIntOrDefault("DLSSG.MVecsSubrectHeight", 0),
+	};
+
+	MvecScale = {
+		NGXParameters->GetFloatOrDefault("DLSSG.MvecScaleX", 1.0f),
+		NGXParameters->GetFloatOrDefault("DLSSG.MvecScaleY", 1.0f),
+	};
+
+	JitterOffset = {
+		NGXParameters->GetFloatOrDefault("DLSSG.JitterOffsetX", 0.0f),
+		NGXParameters->GetFloatOrDefault("DLSSG.JitterOffsetY", 0.0f),
+	};
+
+	Camera.OrthoProjection = NGXParameters->GetUIntOrDefault("DLSSG.OrthoProjection", 0) != 0;
+	Camera.DepthInverted = NGXParameters->GetUIntOrDefault("DLSSG.DepthInverted", 0) != 0;
+	Camera.FOV = NGXParameters->GetFloatOrDefault("DLSSG.CameraFOV", 0.0f);
+	Camera.Near = NGXParameters->GetFloatOrDefault("DLSSG.CameraNear", 0.0f);
+	Camera.Far = NGXParameters->GetFloatOrDefault("DLSSG.CameraFar", 0.0f);
+
+	float(*cameraViewToClip)[4] = nullptr;
+	NGXParameters->GetVoidPointer("DLSSG.CameraViewToClip", reinterpret_cast<void **>(&cameraViewToClip));
+
+	Camera.ViewToClipValid = cameraViewToClip != nullptr;
+
+	if (cameraViewToClip)
+		memcpy(Camera.ViewToClip, cameraViewToClip, sizeof(Camera.ViewToClip));
+	else
+		memset(Camera.ViewToClip, 0, sizeof(Camera.ViewToClip));
+
+	// Resources from the previous frame must never leak into this one
+	Backbuffer = {};
+	HUDLess = {};
+	Depth = {};
+	MVecs = {};
+	DistortionField = {};
+	OutputReal = {};
+	OutputInterpolated = {};
+}
+
+const DLSSGFrameInputs::CameraParameters& DLSSGFrameInputs::GetCameraParameters()
+{
+	// Camera inputs rarely change between frames. Skip the decomposition and fixups when they're identical.
+	if (m_CameraParametersSource == Camera)
+		return m_CameraParameters;
+
+	auto& params = m_CameraParameters;
+	params = {};
+
+	if (!DecomposeProjectionMatrix(Camera, &params))
+	{
+		// Some games pass in CameraFOV as degrees. Some games pass in CameraFOV as radians. Which is
+		// correct? Who knows. I sure as hell don't.
+		params.FovAngleVertical = Camera.FOV;
+
+		// BUG: RTX Remix-based games pass in a FOV of 0. This is a kludge.
+		if (params.FovAngleVertical == 0.0f)
+			params.FovAngleVertical = 90.0f;
+
+		if (params.FovAngleVertical > 10.0f)
+			params.FovAngleVertical *= std::numbers::pi_v<float> / 180.0f;
+
+		params.Near = Camera.Near;
+		params.Far = Camera.Far;
+	}
+
+	if (params.Near != 0.0f && params.Far == 0.0f)
+	{
+		// A CameraFar value of zero indicates an infinite far plane. Due to a bug in FSR's
+		// setupDeviceDepthToViewSpaceDepthParams function, CameraFar must always be greater than
+		// CameraNear when in use.
+		params.DepthPlaneInfinite = true;
+		params.Far = params.Near + 1.0f;
+	}
+
+	m_CameraParametersSource = Camera;
+	return m_CameraParameters;
+}
+
+bool DLSSGFrameInputs::DecomposeProjectionMatrix(const CameraInputs& Inputs, CameraParameters *OutParameters)
+{
+	if (Inputs.OrthoProjection || !Inputs.ViewToClipValid)
+		return false;
+
+	float projMatrix[4][4];
+	memcpy(projMatrix, Inputs.ViewToClip, sizeof(projMatrix));
+
+	// BUG: Various RTX Remix-based games pass in an identity matrix which is completely useless. No
+	// idea why.
+	const bool isEmptyOrIdentityMatrix = [&]()
+	{
+		float m[4][4] = {};
+		if (memcmp(projMatrix, m, sizeof(m)) == 0)
+			return true;
+
+		m[0][0] = m[1][1] = m[2][2] = m[3][3] = 1.0f;
+		return memcmp(projMatrix, m, sizeof(m)) == 0;
+	}();
+
+	if (isEmptyOrIdentityMatrix)
+		return false;
+
+	// BUG: Indiana Jones and the Great Circle passes in what appears to be column-major matrices.
+	// Streamline expects row-major and so do we.
+	const static bool isTheGreatCircle = GetModuleHandleW(L"TheGreatCircle.exe") != nullptr;
+
+	for (int i = 0; i < 4 && isTheGreatCircle; i++)
+	{
+		for (int j = i + 1; j < 4; j++)
+			std::swap(projMatrix[i][j], projMatrix[j][i]);
+	}
+
+	// a 0 0 0
+	// 0 b 0 0
+	// 0 0 c e
+	// 0 0 d 0
+	const double b = projMatrix[1][1];
+	const double c = projMatrix[2][2];
+	const double d = projMatrix[3][2];
+	const double e = projMatrix[2][3];
+
+	auto& params = *OutParameters;
+
+	if (e < 0.0)
+	{
+		params.Near = static_cast<float>((c == 0.0) ? 0.0 : (d / c));
+		params.Far = static_cast<float>(d / (c + 1.0));
+	}
+	else
+	{
+		params.Near = static_cast<float>((c == 0.0) ? 0.0 : (-d / c));
+		params.Far = static_cast<float>(-d / (c - 1.0));
+	}
+
+	if (Inputs.DepthInverted)
+		std::swap(params.Near, params.Far);
+
+	params.FovAngleVertical = static_cast<float>(2.0 * std::atan(1.0 / b));
+	return true;
+}
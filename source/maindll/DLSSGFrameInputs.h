@@ -0,0 +1,72 @@
+#pragma once
+
+#include <FidelityFX/host/ffx_types.h>
+
+struct NGXInstanceParameters;
+
+// Typed copy of the DLSSG.* parameters consumed by frame generation. The host parameter map is string keyed and
+// every lookup is a virtual call, so each key is read exactly once per EvaluateFeature and everything else works
+// off this snapshot.
+struct DLSSGFrameInputs
+{
+	struct CameraInputs
+	{
+		bool OrthoProjection = false;
+		bool DepthInverted = false;
+		bool ViewToClipValid = false;
+		float ViewToClip[4][4] = {};
+		float FOV = 0.0f;
+		float Near = 0.0f;
+		float Far = 0.0f;
+
+		bool operator==(const CameraInputs&) const = default;
+	};
+
+	struct CameraParameters
+	{
+		float Near = 0.0f;
+		float Far = 0.0f;
+		float FovAngleVertical = 0.0f;
+		bool DepthPlaneInfinite = false;
+	};
+
+	bool EnableInterp = false;
+	bool Reset = false;
+	bool HDR = false;
+	bool MvecJittered = false;
+	bool MvecDilated = false;
+	bool DistortionFieldLowPrecision = false;
+
+	uint32_t MultiFrameCount = 1;
+	uint32_t MultiFrameIndex = 1;
+
+	FfxDimensions2D DepthSubrect = {};
+	FfxIntCoords2D HUDLessSubrectBase = {};
+	FfxDimensions2D HUDLessSubrect = {};
+	FfxDimensions2D MVecsSubrect = {};
+
+	FfxFloatCoords2D MvecScale = { 1.0f, 1.0f };
+	FfxFloatCoords2D JitterOffset = {};
+
+	CameraInputs Camera;
+
+	// Resources are loaded by the API-specific frame interpolator
+	FfxResource Backbuffer = {};
+	FfxResource HUDLess = {};
+	FfxResource Depth = {};
+	FfxResource MVecs = {};
+	FfxResource DistortionField = {};
+	FfxResource OutputReal = {};
+	FfxResource OutputInterpolated = {};
+
+private:
+	std::optional<CameraInputs> m_CameraParametersSource;
+	CameraParameters m_CameraParameters;
+
+public:
+	void Load(NGXInstanceParameters *NGXParameters);
+	const CameraParameters& GetCameraParameters();
+
+private:
+	static bool DecomposeProjectionMatrix(const CameraInputs& Inputs, CameraParameters *OutParameters);
+};
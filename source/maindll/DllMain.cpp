@@ -1,5 +1,6 @@
 #include <Windows.h>
 #include <charconv>
+#include "Config.h"
 #include "Util.h"
 
 BOOL WINAPI RawDllMain(HINSTANCE hInstDLL, DWORD fdwReason, LPVOID lpvReserved)
@@ -57,6 +58,8 @@ BOOL WINAPI DllMain(HINSTANCE hInstDLL, DWORD fdwReason, LPVOID lpvReserved)
 		spdlog::warn("");
 		spdlog::warn("DO NOT USE IN MULTIPLAYER GAMES.");
 		spdlog::warn("");
+
+		Config::StartHotReload();
 	}
 
 	return TRUE;
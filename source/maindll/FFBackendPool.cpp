@@ -0,0 +1,57 @@
+#include <algorithm>
+#include "Config.h"
+#include "FFBackendPool.h"
+
+static std::mutex PoolLock;
+static std::unordered_map<void *, std::vector<std::weak_ptr<FFBackendInterfaces>>> PoolEntries;
+
+std::shared_ptr<FFBackendInterfaces> FFBackendPool::Acquire(void *Device, const InitializeFunc& Initialize)
+{
+	std::scoped_lock lock(PoolLock);
+
+	// Entries only live as long as their features. A device handle can't be reused while one is still alive.
+	auto& entries = PoolEntries[Device];
+	std::erase_if(entries, [](const auto& Entry) { return Entry.expired(); });
+
+	uint32_t liveFeatureCount = 0;
+
+	for (auto& entry : entries)
+	{
+		auto interfaces = entry.lock();
+
+		if (!interfaces)
+			continue;
+
+		// Our own reference is included in the count
+		if (interfaces.use_count() <= interfaces->FeatureCapacity)
+			return interfaces;
+
+		liveFeatureCount += static_cast<uint32_t>(interfaces.use_count() - 1);
+	}
+
+	// Most games only ever have a single feature alive. Sets are sized for a second one only after a game shows it
+	// keeps more than one around, e.g. by creating the replacement before releasing the old feature on resize.
+	auto interfaces = std::make_shared<FFBackendInterfaces>();
+	interfaces->FeatureCapacity = std::clamp(liveFeatureCount + 1, 1u, MaxFeaturesPerInterface);
+	interfaces->MaxCachedContexts = FFInterpolator::GetMaxCachedContexts(*Config::Get());
+	interfaces->FrameInterpolationContextCount = GetFrameInterpolationBackendContexts(
+		interfaces->FeatureCapacity,
+		interfaces->MaxCachedContexts);
+
+	if (Initialize(&interfaces->Shared, MaxSharedBackendContexts) != FFX_OK ||
+		Initialize(&interfaces->FrameInterpolation, interfaces->FrameInterpolationContextCount) != FFX_OK)
+	{
+		if (entries.empty())
+			PoolEntries.erase(Device);
+
+		return nullptr;
+	}
+
+	entries.emplace_back(interfaces);
+	spdlog::info(
+		"Created backend interfaces for {} feature(s) on device 0x{:X}.",
+		interfaces->FeatureCapacity,
+		reinterpret_cast<uintptr_t>(Device));
+
+	return interfaces;
+}
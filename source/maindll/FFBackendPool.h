@@ -0,0 +1,38 @@
+#pragma once
+
+#include "FFInterfaceWrapper.h"
+#include "FFInterpolator.h"
+
+struct FFBackendInterfaces
+{
+	FFInterfaceWrapper FrameInterpolation;
+	FFInterfaceWrapper Shared;
+
+	// Fixed when the set is created. Later settings changes only apply to new sets.
+	uint32_t FeatureCapacity = 0;
+	uint32_t MaxCachedContexts = 0; // Per feature
+	uint32_t FrameInterpolationContextCount = 0;
+
+	// Backends keep a single job queue and resource table. Every call into either interface must hold this, except
+	// for pipeline creation. See FFInterfaceWrapper::SetPipelineCreationLock.
+	std::mutex Mutex;
+};
+
+// Backend interfaces carry their own scratch memory, descriptor heaps and constant buffer rings. Feature instances
+// created on the same device share a single set and only own the effect contexts within them.
+class FFBackendPool
+{
+public:
+	constexpr static uint32_t MaxFeaturesPerInterface = 2;
+	constexpr static uint32_t MaxSharedBackendContexts = 3;
+
+	// Optical flow, every cached frame interpolation context, and one more under construction, for each feature
+	constexpr static uint32_t GetFrameInterpolationBackendContexts(uint32_t FeatureCapacity, uint32_t MaxCachedContexts)
+	{
+		return FeatureCapacity * (1 + MaxCachedContexts + 1);
+	}
+
+	using InitializeFunc = std::function<FfxErrorCode(FFInterfaceWrapper *BackendInterface, uint32_t MaxContexts)>;
+
+	static std::shared_ptr<FFBackendInterfaces> Acquire(void *Device, const InitializeFunc& Initialize);
+};
@@ -1,25 +1,84 @@
-#include <dxgi1_6.h>
-#include <numbers>
 #include "NGX/NvNGX.h"
+#include "Config.h"
 #include "FFFrameInterpolator.h"
+#include "LiveMetrics.h"
+#include "TraceRecorder.h"
 #include "Util.h"
-
-bool g_EnableDebugOverlay = false;
-bool g_EnableDebugTearLines = false;
-bool g_EnableInterpolatedFramesOnly = false;
+#include "VRAMEstimator.h"
 
 extern "C" void __declspec(dllexport) RefreshGlobalConfiguration()
 {
-	g_EnableDebugOverlay = Util::GetSetting(L"EnableDebugOverlay", false);
-	g_EnableDebugTearLines = Util::GetSetting(L"EnableDebugTearLines", false);
-	g_EnableInterpolatedFramesOnly = Util::GetSetting(L"EnableInterpolatedFramesOnly", false);
+	Config::Reload();
+}
+
+uint64_t FFFrameInterpolator::EstimateVRAMUsage(
+	uint32_t SwapchainBufferCount,
+	uint32_t Width,
+	uint32_t Height,
+	FfxSurfaceFormat BackbufferFormat)
+{
+	// Used until a plausible description is seen
+	static std::atomic<uint64_t> previousEstimate = 300 * 1024 * 1024;
+
+	const auto config = Config::Get();
+
+	VRAMEstimator::Inputs inputs = {
+		.DisplaySize = { Width, Height },
+		.BackbufferFormat = BackbufferFormat,
+		.SharedBackendContexts = FFBackendPool::MaxSharedBackendContexts,
+		.FrameInterpolationBackendContexts = FFBackendPool::GetFrameInterpolationBackendContexts(
+			1,
+			FFInterpolator::GetMaxCachedContexts(*config)),
+	};
+
+	if (!VRAMEstimator::IsPlausibleSwapchain(SwapchainBufferCount, inputs))
+	{
+		LOG_RATE_LIMITED(
+			warn,
+			"Ignoring implausible VRAM estimate request: {} buffers, {}x{}, format {}",
+			SwapchainBufferCount,
+			Width,
+			Height,
+			static_cast<uint32_t>(BackbufferFormat));
+
+		return previousEstimate.load();
+	}
+
+	// Same extent the constructor allocates contexts with
+	inputs.DisplaySize.width = std::max(Width, config->MaxDisplayWidth);
+	inputs.DisplaySize.height = std::max(Height, config->MaxDisplayHeight);
+
+	const auto estimate = VRAMEstimator::EstimateFrameGeneration(inputs);
+	previousEstimate.store(estimate);
+
+	return estimate;
 }
 
 FFFrameInterpolator::FFFrameInterpolator(uint32_t OutputWidth, uint32_t OutputHeight)
 	: m_SwapchainWidth(OutputWidth),
 	  m_SwapchainHeight(OutputHeight)
 {
-	RefreshGlobalConfiguration();
+	// Pick up ini edits made since the last feature was created
+	Config::Reload();
+	const auto config = Config::Get();
+
+	// Contexts are allocated once at the largest expected extent so window resizes only cost a reset
+	m_MaxSwapchainWidth = std::max(OutputWidth, config->MaxDisplayWidth);
+	m_MaxSwapchainHeight = std::max(OutputHeight, config->MaxDisplayHeight);
+
+	if (config->EnableFrameGenerationGovernor)
+	{
+		FrameGenerationGovernor::Settings settings = {};
+		settings.TargetFrameRate = config->GovernorTargetFrameRate;
+
+		m_Governor.emplace(settings);
+	}
+
+	if (config->EnableHostStageProfiling)
+		m_HostStageProfiler.emplace(config->HostStageProfilingFrames);
+
+	if (config->EnableFrameCapture)
+		m_FrameCapture.emplace(Util::GetThisDllPath() + L"\\dlssg_to_fsr3_capture.bin", config->FrameCaptureFrames);
 }
 
 FFFrameInterpolator::~FFFrameInterpolator()
@@ -28,121 +87,398 @@ FFFrameInterpolator::~FFFrameInterpolator()
 
 FfxErrorCode FFFrameInterpolator::Dispatch(void *CommandList, NGXInstanceParameters *NGXParameters)
 {
-	if (NGXParameters->GetUIntOrDefault("DLSSG.MultiFrameCount", 0) > 1 ||
-		NGXParameters->GetUIntOrDefault("DLSSG.MultiFrameIndex", 0) > 1)
+	using enum HostStageProfiler::Stage;
+	TRACE_ZONE("dispatch", "Dispatch");
+
+	const auto config = Config::Get();
+	const auto dispatchStartTime = std::chrono::steady_clock::now();
+
+	if (m_HostStageProfiler)
+		m_HostStageProfiler->BeginFrame();
+
+	std::optional<HostStageProfiler::ScopedSample> loadInputsSample;
+	loadInputsSample.emplace(m_HostStageProfiler, LoadInputs);
+
+	m_FrameInputs.Load(NGXParameters);
+
+	// Multi frame generation calls us once per interpolated frame with MultiFrameIndex in [1, MultiFrameCount]. Optical
+	// flow and input preparation only depend on the real frames and are recorded on the first call.
+	auto multiFrameCount = std::max(m_FrameInputs.MultiFrameCount, 1u);
+	auto multiFrameIndex = std::max(m_FrameInputs.MultiFrameIndex, 1u);
+
+	if (multiFrameCount > MaxMultiFrameCount || multiFrameIndex > multiFrameCount)
 	{
 		const static bool once = []()
 		{
-			spdlog::error("Generating multiple interpolated frames is unsupported.");
+			spdlog::error("Requested an unsupported number of interpolated frames. Clamping.");
 			return true;
 		}();
+
+		multiFrameCount = std::min(multiFrameCount, MaxMultiFrameCount);
+		multiFrameIndex = std::min(multiFrameIndex, multiFrameCount);
 	}
 
-	FfxResource gameBackBufferResource = {};
-	FfxResource gameRealOutputResource = {};
+	const bool isFirstInterpolatedFrame = multiFrameIndex == 1;
 
-	const auto dispatchStatus = [&]() -> FfxErrorCode
+	if (isFirstInterpolatedFrame)
 	{
-		const bool enableInterpolation = NGXParameters->GetUIntOrDefault("DLSSG.EnableInterp", 0) != 0;
+		m_RealFrameResetHistory = false;
+		m_RealFrameInputsPrepared = false;
+	}
+
+	LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Backbuffer", &m_FrameInputs.Backbuffer, FFX_RESOURCE_STATE_COMPUTE_READ);
+	LoadTextureFromNGXParameters(NGXParameters, "DLSSG.OutputReal", &m_FrameInputs.OutputReal, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+	LoadTextureFromNGXParameters(NGXParameters, "DLSSG.OutputInterpolated", &m_FrameInputs.OutputInterpolated, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+	loadInputsSample.reset();
 
-		LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Backbuffer", &gameBackBufferResource, FFX_RESOURCE_STATE_COMPUTE_READ);
-		LoadTextureFromNGXParameters(NGXParameters, "DLSSG.OutputReal", &gameRealOutputResource, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+	FfxResource gameBackBufferResource = m_FrameInputs.Backbuffer;
+	bool passThroughFrame = false;
 
-		if (!enableInterpolation)
+	const auto dispatchStatus = [&]() -> FfxErrorCode
+	{
+		if (!m_FrameInputs.EnableInterp)
 			return FFX_OK;
 
-		if (!CalculateResourceDimensions(NGXParameters))
+		if (m_Governor)
+		{
+			if (isFirstInterpolatedFrame)
+			{
+				const auto now = std::chrono::steady_clock::now().time_since_epoch();
+				m_Governor->OnRealFrame(std::chrono::duration<double>(now).count(), multiFrameCount + 1);
+			}
+
+			// Present the real frame again in place of an interpolated one
+			if (m_Governor->GetDecision() == FrameGenerationGovernor::Decision::PassThrough)
+			{
+				passThroughFrame = true;
+				return FFX_OK;
+			}
+		}
+
+		// Nothing to interpolate with until our own context is built. Other features' workers only hold the lock
+		// briefly.
+		if (m_FrameInterpolatorContext->IsContextCreationPending())
+			return FFX_EOF;
+
+		std::scoped_lock lock(m_Backend->Mutex);
+
+		// Also retried at the same size after a resize failed to recreate the contexts
+		const bool swapchainResized = gameBackBufferResource.resource &&
+			(gameBackBufferResource.description.width != m_SwapchainWidth || gameBackBufferResource.description.height != m_SwapchainHeight ||
+			 !m_OpticalFlowContext);
+
+		if (swapchainResized)
+		{
+			if (auto status = ResizeSwapchain(gameBackBufferResource.description.width, gameBackBufferResource.description.height); status != FFX_OK)
+				return status;
+
+			// A resize that lands on a later interpolated frame, e.g. after the flush above, leaves nothing prepared
+			// at the new size
+			m_RealFrameInputsPrepared = false;
+		}
+
+		if (!m_OpticalFlowContext)
+			return FFX_EOF;
+
+		loadInputsSample.emplace(m_HostStageProfiler, LoadInputs);
+		LoadTextureFromNGXParameters(NGXParameters, "DLSSG.HUDLess", &m_FrameInputs.HUDLess, FFX_RESOURCE_STATE_COPY_DEST);
+		LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Depth", &m_FrameInputs.Depth, FFX_RESOURCE_STATE_COPY_DEST);
+		LoadTextureFromNGXParameters(NGXParameters, "DLSSG.MVecs", &m_FrameInputs.MVecs, FFX_RESOURCE_STATE_COPY_DEST);
+		LoadTextureFromNGXParameters(
+			NGXParameters,
+			"DLSSG.BidirectionalDistortionField",
+			&m_FrameInputs.DistortionField,
+			FFX_RESOURCE_STATE_COPY_DEST);
+		OnFrameTexturesLoaded(*m_Backend, m_FrameInputs.Reset);
+		loadInputsSample.reset();
+
+		if (m_FrameCapture && isFirstInterpolatedFrame)
+			CaptureFrameInputs();
+
+		std::optional<HostStageProfiler::ScopedSample> buildParametersSample;
+		buildParametersSample.emplace(m_HostStageProfiler, BuildParameters);
+
+		const auto previousInterpolationRect = std::tuple(
+			m_PostUpscaleRenderOffsetX,
+			m_PostUpscaleRenderOffsetY,
+			m_PostUpscaleRenderWidth,
+			m_PostUpscaleRenderHeight);
+
+		if (!CalculateResourceDimensions())
 			return FFX_ERROR_INVALID_ARGUMENT;
 
-		QueryHDRLuminanceRange(NGXParameters);
+		// Optical flow and interpolation history don't carry over when letterboxing changes
+		const bool interpolationRectChanged = previousInterpolationRect != std::tuple(
+			m_PostUpscaleRenderOffsetX,
+			m_PostUpscaleRenderOffsetY,
+			m_PostUpscaleRenderWidth,
+			m_PostUpscaleRenderHeight);
+		const bool resetHistory = swapchainResized || interpolationRectChanged || (m_Governor && m_Governor->ConsumeResetRequest());
+
+		QueryHDRLuminanceRange();
 
 		// Parameter setup
 		FfxOpticalflowDispatchDescription fsrOfDispatchDesc = {};
 		FFInterpolatorDispatchParameters fsrFiDispatchDesc = {};
 
-		if (!BuildOpticalFlowParameters(&fsrOfDispatchDesc, NGXParameters))
+		if (!BuildOpticalFlowParameters(&fsrOfDispatchDesc))
 			return FFX_ERROR_INVALID_ARGUMENT;
 
-		if (!BuildFrameInterpolationParameters(&fsrFiDispatchDesc, NGXParameters))
+		if (!BuildFrameInterpolationParameters(&fsrFiDispatchDesc))
 			return FFX_ERROR_INVALID_ARGUMENT;
 
-		fsrFiDispatchDesc.DebugView = g_EnableDebugOverlay;
-		fsrFiDispatchDesc.DebugTearLines = g_EnableDebugTearLines;
+		fsrFiDispatchDesc.DebugView = config->EnableDebugOverlay;
+		fsrFiDispatchDesc.DebugTearLines = config->EnableDebugTearLines;
+
+		fsrFiDispatchDesc.InterpolationFactor = static_cast<float>(multiFrameIndex) / (multiFrameCount + 1);
+		fsrFiDispatchDesc.PrepareInputs = !m_RealFrameInputsPrepared;
+		fsrFiDispatchDesc.StoreInterpolationSource = multiFrameIndex == multiFrameCount;
+
+		// Every interpolated frame of a reset real frame would otherwise blend stale history
+		m_RealFrameResetHistory = m_RealFrameResetHistory || fsrFiDispatchDesc.Reset || resetHistory;
+		fsrFiDispatchDesc.Reset = m_RealFrameResetHistory;
+		fsrOfDispatchDesc.reset = fsrOfDispatchDesc.reset || m_RealFrameResetHistory;
+		buildParametersSample.reset();
 
 		// Record commands
-		if (auto status = ffxOpticalflowContextDispatch(&m_OpticalFlowContext.value(), &fsrOfDispatchDesc); status != FFX_OK)
-			return status;
+		if (fsrFiDispatchDesc.PrepareInputs)
+		{
+			HostStageProfiler::ScopedSample opticalFlowSample(m_HostStageProfiler, OpticalFlow);
+			TRACE_ZONE("dispatch", "OpticalFlow");
 
-		if (auto status = m_FrameInterpolatorContext->Dispatch(fsrFiDispatchDesc); status != FFX_OK)
-			return status;
+			if (auto status = ffxOpticalflowContextDispatch(&m_OpticalFlowContext.value(), &fsrOfDispatchDesc); status != FFX_OK)
+				return status;
+		}
+
+		{
+			HostStageProfiler::ScopedSample frameInterpolationSample(m_HostStageProfiler, FrameInterpolation);
+			TRACE_ZONE("dispatch", "FrameInterpolation");
 
-		if (fsrFiDispatchDesc.DebugView || g_EnableInterpolatedFramesOnly)
+			if (auto status = m_FrameInterpolatorContext->Dispatch(fsrFiDispatchDesc); status != FFX_OK)
+				return status;
+
+			m_RealFrameInputsPrepared = true;
+		}
+
+		if (fsrFiDispatchDesc.DebugView || config->EnableInterpolatedFramesOnly)
 			gameBackBufferResource = fsrFiDispatchDesc.OutputInterpolatedColorBuffer;
 
+		// Walking every effect context is cheap but not free
+		if (LiveMetrics::IsEnabled() && (m_LiveMetricsFrameCount++ % 64) == 0)
+			m_BackendVRAMUsage = QueryBackendVRAMUsage();
+
 		return FFX_OK;
 	}();
 
 	if ((dispatchStatus == FFX_OK || dispatchStatus == FFX_EOF) && gameBackBufferResource.resource)
 	{
-		if (gameRealOutputResource.resource)
-			CopyTexture(GetActiveCommandList(), &gameRealOutputResource, &gameBackBufferResource);
+		HostStageProfiler::ScopedSample outputCopiesSample(m_HostStageProfiler, OutputCopies);
+		TRACE_ZONE("dispatch", "OutputCopies");
 
-		if (dispatchStatus == FFX_EOF) // Flush required and no commands were queued. Still have to prevent flickering.
-		{
-			FfxResource outputInterp = {};
+		// The real frame only has to be copied once. Skip it when the host aliases both images or when an earlier
+		// call for the same real frame already copied it. Debug views replace the source and are always copied.
+		const std::pair outputRealCopy(m_FrameInputs.OutputReal.resource, gameBackBufferResource.resource);
+		const bool isRealFrameSource = gameBackBufferResource.resource == m_FrameInputs.Backbuffer.resource;
 
-			if (LoadTextureFromNGXParameters(NGXParameters, "DLSSG.OutputInterpolated", &outputInterp, FFX_RESOURCE_STATE_UNORDERED_ACCESS))
-				CopyTexture(GetActiveCommandList(), &outputInterp, &gameBackBufferResource);
-		}
+		const bool skipOutputRealCopy = outputRealCopy.first == outputRealCopy.second ||
+			(isRealFrameSource && !isFirstInterpolatedFrame && outputRealCopy == m_LastOutputRealCopy);
+
+		if (m_FrameInputs.OutputReal.resource && !skipOutputRealCopy)
+			CopyTexture(GetActiveCommandList(), &m_FrameInputs.OutputReal, &gameBackBufferResource);
+
+		m_LastOutputRealCopy = isRealFrameSource ? outputRealCopy : decltype(m_LastOutputRealCopy) {};
+
+		// Flush required or pass through requested and no commands were queued. Still have to prevent flickering.
+		if ((dispatchStatus == FFX_EOF || passThroughFrame) && m_FrameInputs.OutputInterpolated.resource &&
+			m_FrameInputs.OutputInterpolated.resource != gameBackBufferResource.resource)
+			CopyTexture(GetActiveCommandList(), &m_FrameInputs.OutputInterpolated, &gameBackBufferResource);
+	}
+	else
+	{
+		m_LastOutputRealCopy = {};
+	}
+
+	if (dispatchStatus == FFX_EOF)
+		TRACE_INSTANT("dispatch", "FFX_EOF");
+
+	if (m_HostStageProfiler)
+	{
+		m_HostStageProfiler->EndFrame({
+			.Width = m_SwapchainWidth,
+			.Height = m_SwapchainHeight,
+			.MultiFrameCount = multiFrameCount,
+			.HDR = m_FrameInputs.HDR,
+			.HUDLess = m_FrameInputs.HUDLess.resource != nullptr,
+			.DistortionField = m_FrameInputs.DistortionField.resource != nullptr,
+		});
+	}
+
+	if (LiveMetrics::IsEnabled())
+	{
+		uint32_t flags = 0;
+
+		if (dispatchStatus == FFX_OK && m_FrameInputs.EnableInterp && !passThroughFrame)
+			flags |= LiveMetrics::FlagInterpolated;
+
+		if (passThroughFrame)
+			flags |= LiveMetrics::FlagPassThrough;
+
+		if (dispatchStatus == FFX_EOF)
+			flags |= LiveMetrics::FlagFlush;
+		else if (dispatchStatus != FFX_OK)
+			flags |= LiveMetrics::FlagError;
+
+		if (std::exchange(m_ContextsRecreated, false))
+			flags |= LiveMetrics::FlagContextsRecreated;
+
+		LiveMetrics::Publish({
+			.BackendVRAMBytes = m_BackendVRAMUsage,
+			.Flags = flags,
+			.Width = m_SwapchainWidth,
+			.Height = m_SwapchainHeight,
+			.MultiFrameIndex = multiFrameIndex,
+			.MultiFrameCount = multiFrameCount,
+			.CpuDispatchMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - dispatchStartTime).count(),
+		});
 	}
 
+	// Passing frames through during context creation isn't an error
+	if (dispatchStatus == FFX_EOF && m_FrameInterpolatorContext && m_FrameInterpolatorContext->IsContextCreationPending())
+		return FFX_OK;
+
  	return dispatchStatus;
 }
 
 void FFFrameInterpolator::Create(NGXInstanceParameters *NGXParameters)
 {
-	if (CreateBackend(NGXParameters) != FFX_OK)
+	TRACE_ZONE("context", "CreateFeatureContexts");
+
+	m_Backend = FFBackendPool::Acquire(
+		GetBackendDevice(),
+		[&](FFInterfaceWrapper *BackendInterface, uint32_t MaxContexts)
+		{
+			return InitializeBackendInterface(BackendInterface, MaxContexts, NGXParameters);
+		});
+
+	if (!m_Backend)
+		throw std::runtime_error("Failed to create backend interfaces.");
+
+	std::unique_lock lock(m_Backend->Mutex);
+
+	if (CreateBackend() != FFX_OK)
 	{
+		lock.unlock();
 		Destroy();
 		throw std::runtime_error("Failed to create backend context.");
 	}
 
-	if (CreateOpticalFlowContext() != FFX_OK)
+	if (CreateOpticalFlowContext(m_MaxSwapchainWidth, m_MaxSwapchainHeight) != FFX_OK)
 	{
+		lock.unlock();
 		Destroy();
 		throw std::runtime_error("Failed to create optical flow context.");
 	}
 
 	m_FrameInterpolatorContext.emplace(
-		m_FrameInterpolationBackendInterface,
-		m_SharedBackendInterface,
+		*m_Backend,
 		*m_SharedEffectContextId,
-		m_SwapchainWidth,
-		m_SwapchainHeight);
+		m_MaxSwapchainWidth,
+		m_MaxSwapchainHeight);
+
+	// Start building pipelines before the first frame arrives. Anything mispredicted here is corrected by a rebuild
+	// once real parameters are known.
+	m_FrameInputs.Load(NGXParameters);
+
+	FFInterpolatorDispatchParameters predictedParameters = {};
+	predictedParameters.InputColorBuffer.description.format = GetBackBufferFormatFromNGXParameters(NGXParameters);
+	predictedParameters.HDR = m_FrameInputs.HDR;
+	predictedParameters.DepthInverted = m_FrameInputs.Camera.DepthInverted;
+	predictedParameters.MotionVectorJitterCancellation = m_FrameInputs.MvecJittered;
+	predictedParameters.MotionVectorsDilated = m_FrameInputs.MvecDilated;
+
+	if (predictedParameters.InputColorBuffer.description.format != FFX_SURFACE_FORMAT_UNKNOWN)
+		m_FrameInterpolatorContext->CreateContextAsync(predictedParameters);
 }
 
 void FFFrameInterpolator::Destroy()
 {
+	if (m_FrameCapture)
+		m_FrameCapture->Stop([&](const FrameCapture::ReadbackBuffer& Buffer) { DestroyReadbackBuffer(Buffer); });
+
+	if (!m_Backend)
+		return;
+
+	// Context creation workers take the backend lock themselves
+	WaitForContextCreation();
+
+	std::scoped_lock lock(m_Backend->Mutex);
+
 	m_FrameInterpolatorContext.reset();
 	DestroyOpticalFlowContext();
 	DestroyBackend();
 }
 
-bool FFFrameInterpolator::CalculateResourceDimensions(NGXInstanceParameters *NGXParameters)
+void FFFrameInterpolator::WaitForContextCreation() const
+{
+	if (m_FrameInterpolatorContext)
+		m_FrameInterpolatorContext->WaitForContextCreation();
+}
+
+FfxErrorCode FFFrameInterpolator::ResizeSwapchain(uint32_t Width, uint32_t Height)
+{
+	// A failed resize leaves no optical flow context behind. Keep retrying even if the swapchain shrinks back.
+	if (Width <= m_MaxSwapchainWidth && Height <= m_MaxSwapchainHeight && m_OpticalFlowContext)
+	{
+		m_SwapchainWidth = Width;
+		m_SwapchainHeight = Height;
+
+		return FFX_OK;
+	}
+
+	// Growing past the allocated extent requires new contexts. Request a flush first since the old ones may still
+	// be in use by the GPU.
+	if (!std::exchange(m_ContextResizePending, true))
+		return FFX_EOF;
+
+	m_ContextResizePending = false;
+	spdlog::info("Swapchain grew to {}x{}. Recreating contexts.", Width, Height);
+	TRACE_ZONE("context", "RecreateContexts");
+
+	m_ContextsRecreated = true;
+
+	m_FrameInterpolatorContext.reset();
+	DestroyOpticalFlowContext();
+
+	const uint32_t maxWidth = std::max(m_MaxSwapchainWidth, Width);
+	const uint32_t maxHeight = std::max(m_MaxSwapchainHeight, Height);
+
+	m_FrameInterpolatorContext.emplace(*m_Backend, *m_SharedEffectContextId, maxWidth, maxHeight);
+
+	// Leave every dimension untouched on failure so the next frame retries
+	if (auto status = CreateOpticalFlowContext(maxWidth, maxHeight); status != FFX_OK)
+		return status;
+
+	m_MaxSwapchainWidth = maxWidth;
+	m_MaxSwapchainHeight = maxHeight;
+	m_SwapchainWidth = Width;
+	m_SwapchainHeight = Height;
+
+	return FFX_OK;
+}
+
+bool FFFrameInterpolator::CalculateResourceDimensions()
 {
 	// NGX doesn't provide a direct method to query current gbuffer dimensions so we'll grab them
 	// from the depth buffer instead. Depth is suitable because it's the one resource guaranteed to
 	// be the same size as the gbuffer. Hopefully.
-	FfxResource temp = {};
 	{
-		auto width = NGXParameters->GetUIntOrDefault("DLSSG.DepthSubrectWidth", 0);
-		auto height = NGXParameters->GetUIntOrDefault("DLSSG.DepthSubrectHeight", 0);
+		auto width = m_FrameInputs.DepthSubrect.width;
+		auto height = m_FrameInputs.DepthSubrect.height;
 
 		if (width == 0 || height == 0)
 		{
-			LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Depth", &temp, FFX_RESOURCE_STATE_COPY_DEST);
-			width = temp.description.width;
-			height = temp.description.height;
+			width = m_FrameInputs.Depth.description.width;
+			height = m_FrameInputs.Depth.description.height;
 		}
 
 		m_PreUpscaleRenderWidth = width;
@@ -154,25 +490,34 @@ bool FFFrameInterpolator::CalculateResourceDimensions(NGXInstanceParameters *NGX
 
 	// HUD-less dimensions are the "ground truth" final render resolution. These aren't necessarily
 	// equal to back buffer dimensions. Letterboxing in The Witcher 3 is a good test case.
-#if 0
-	if (LoadTextureFromNGXParameters(NGXParameters, "DLSSG.HUDLess", &temp, FFX_RESOURCE_STATE_COPY_DEST))
+	//
+	// Only subrects are honored. The interpolation shaders address HUD-less and back buffer with the
+	// same coordinates, so a HUD-less resource with mismatched dimensions can't be used as-is.
+	const auto& subrectBase = m_FrameInputs.HUDLessSubrectBase;
+	const auto& subrect = m_FrameInputs.HUDLessSubrect;
+
+	const bool useHUDLessSubrect = m_FrameInputs.HUDLess.resource &&
+		m_FrameInputs.HUDLess.description.width == m_SwapchainWidth &&
+		m_FrameInputs.HUDLess.description.height == m_SwapchainHeight &&
+		subrectBase.x >= 0 &&
+		subrectBase.y >= 0 &&
+		subrect.width != 0 &&
+		subrect.height != 0 &&
+		subrectBase.x + subrect.width <= m_SwapchainWidth &&
+		subrectBase.y + subrect.height <= m_SwapchainHeight;
+
+	if (useHUDLessSubrect)
 	{
-		auto width = NGXParameters->GetUIntOrDefault("DLSSG.HUDLessSubrectWidth", 0);
-		auto height = NGXParameters->GetUIntOrDefault("DLSSG.HUDLessSubrectHeight", 0);
-
-		if (width == 0 || height == 0)
-		{
-			width = temp.description.width;
-			height = temp.description.height;
-		}
-
-		m_PostUpscaleRenderWidth = width;
-		m_PostUpscaleRenderHeight = height;
+		m_PostUpscaleRenderOffsetX = subrectBase.x;
+		m_PostUpscaleRenderOffsetY = subrectBase.y;
+		m_PostUpscaleRenderWidth = subrect.width;
+		m_PostUpscaleRenderHeight = subrect.height;
 	}
 	else
-#endif
 	{
-		// No HUD-less resource. Default to back buffer resolution.
+		// No usable HUD-less subrect. Default to back buffer resolution.
+		m_PostUpscaleRenderOffsetX = 0;
+		m_PostUpscaleRenderOffsetY = 0;
 		m_PostUpscaleRenderWidth = m_SwapchainWidth;
 		m_PostUpscaleRenderHeight = m_SwapchainHeight;
 	}
@@ -193,7 +538,9 @@ bool FFFrameInterpolator::CalculateResourceDimensions(NGXInstanceParameters *NGX
 
 	if (isDyingLight2)
 	{
-		NGXParameters->SetVoidPointer("DLSSG.HUDLess", nullptr);
+		m_FrameInputs.HUDLess = {};
+		m_PostUpscaleRenderOffsetX = 0;
+		m_PostUpscaleRenderOffsetY = 0;
 		m_PostUpscaleRenderWidth = m_SwapchainWidth;
 		m_PostUpscaleRenderHeight = m_SwapchainHeight;
 	}
@@ -201,59 +548,16 @@ bool FFFrameInterpolator::CalculateResourceDimensions(NGXInstanceParameters *NGX
 	return true;
 }
 
-void FFFrameInterpolator::QueryHDRLuminanceRange(NGXInstanceParameters *NGXParameters)
+void FFFrameInterpolator::QueryHDRLuminanceRange()
 {
-	if (NGXParameters->GetUIntOrDefault("DLSSG.ColorBuffersHDR", 0) == 0)
+	if (!m_FrameInputs.HDR)
 		return;
 
 	if (m_HDRLuminanceRangeSet)
 		return;
 
-	// Microsoft DirectX 12 HDR sample
-	// https://github.com/microsoft/DirectX-Graphics-Samples/blob/b5f92e2251ee83db4d4c795b3cba5d470c52eaf8/Samples/Desktop/D3D12HDR/src/D3D12HDR.cpp#L1064
-	const auto luid = GetActiveAdapterLUID();
-
-	IDXGIFactory1 *factory = nullptr;
-	IDXGIAdapter1 *adapter = nullptr;
-	IDXGIOutput *output = nullptr;
-
-	if (CreateDXGIFactory1(IID_PPV_ARGS(&factory)) == S_OK)
-	{
-		// Match the active DXGI adapter
-		for (uint32_t i = 0; factory->EnumAdapters1(i, &adapter) == S_OK; i++)
-		{
-			DXGI_ADAPTER_DESC desc = {};
-			adapter->GetDesc(&desc);
-
-			static_assert(luid.size() == sizeof(desc.AdapterLuid));
-
-			if (memcmp(&desc.AdapterLuid, luid.data(), luid.size()) == 0)
-			{
-				// Then check the first HDR-capable output
-				for (uint32_t j = 0; adapter->EnumOutputs(j, &output) == S_OK; j++)
-				{
-					if (IDXGIOutput6 *output6; output->QueryInterface(IID_PPV_ARGS(&output6)) == S_OK)
-					{
-						DXGI_OUTPUT_DESC1 outputDesc = {};
-						output6->GetDesc1(&outputDesc);
-						output6->Release();
-
-						if (outputDesc.ColorSpace == DXGI_COLOR_SPACE_RGB_FULL_G2084_NONE_P2020 && !m_HDRLuminanceRangeSet)
-						{
-							m_HDRLuminanceRange = { outputDesc.MinLuminance, outputDesc.MaxLuminance };
-							m_HDRLuminanceRangeSet = true;
-						}
-					}
-
-					output->Release();
-				}
-			}
-
-			adapter->Release();
-		}
-
-		factory->Release();
-	}
+	if (const auto range = Util::FindHDROutputLuminanceRange(GetActiveAdapterLUID()))
+		m_HDRLuminanceRange = { range->first, range->second };
 
 	// Keep using hardcoded defaults even if we didn't find a valid output
 	m_HDRLuminanceRangeSet = true;
@@ -261,26 +565,26 @@ void FFFrameInterpolator::QueryHDRLuminanceRange(NGXInstanceParameters *NGXParam
 	spdlog::info("Using assumed HDR luminance range: {} to {} nits", m_HDRLuminanceRange.x, m_HDRLuminanceRange.y);
 }
 
-bool FFFrameInterpolator::BuildOpticalFlowParameters(
-	FfxOpticalflowDispatchDescription *OutParameters,
-	NGXInstanceParameters *NGXParameters)
+bool FFFrameInterpolator::BuildOpticalFlowParameters(FfxOpticalflowDispatchDescription *OutParameters)
 {
 	auto& desc = *OutParameters;
 	desc.commandList = GetActiveCommandList();
 
-	if (!LoadTextureFromNGXParameters(NGXParameters, "DLSSG.HUDLess", &desc.color, FFX_RESOURCE_STATE_COPY_DEST) &&
-		!LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Backbuffer", &desc.color, FFX_RESOURCE_STATE_COMPUTE_READ))
+	desc.color = m_FrameInputs.HUDLess.resource ? m_FrameInputs.HUDLess : m_FrameInputs.Backbuffer;
+
+	if (!desc.color.resource)
 		return false;
 
 	desc.color.description.width = m_PostUpscaleRenderWidth; // Explicit override
 	desc.color.description.height = m_PostUpscaleRenderHeight;
+	desc.colorOffset = { static_cast<int32_t>(m_PostUpscaleRenderOffsetX), static_cast<int32_t>(m_PostUpscaleRenderOffsetY) };
 
-	desc.opticalFlowVector = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_TexSharedOpticalFlowVector);
-	desc.opticalFlowSCD = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_TexSharedOpticalFlowSCD);
+	desc.opticalFlowVector = m_Backend->Shared.fpGetResource(&m_Backend->Shared, *m_TexSharedOpticalFlowVector);
+	desc.opticalFlowSCD = m_Backend->Shared.fpGetResource(&m_Backend->Shared, *m_TexSharedOpticalFlowSCD);
 
-	desc.reset = NGXParameters->GetUIntOrDefault("DLSSG.Reset", 0) != 0;
+	desc.reset = m_FrameInputs.Reset;
 
-	if (NGXParameters->GetUIntOrDefault("DLSSG.ColorBuffersHDR", 0) == 0)
+	if (!m_FrameInputs.HDR)
 		desc.backbufferTransferFunction = FFX_BACKBUFFER_TRANSFER_FUNCTION_SRGB;
 	else
 		desc.backbufferTransferFunction = FFX_BACKBUFFER_TRANSFER_FUNCTION_PQ;
@@ -290,40 +594,38 @@ bool FFFrameInterpolator::BuildOpticalFlowParameters(
 	return true;
 }
 
-bool FFFrameInterpolator::BuildFrameInterpolationParameters(
-	FFInterpolatorDispatchParameters *OutParameters,
-	NGXInstanceParameters *NGXParameters)
+bool FFFrameInterpolator::BuildFrameInterpolationParameters(FFInterpolatorDispatchParameters *OutParameters)
 {
 	auto& desc = *OutParameters;
 	desc.CommandList = GetActiveCommandList();
 
 	desc.RenderSize = { m_PreUpscaleRenderWidth, m_PreUpscaleRenderHeight };
 	desc.OutputSize = { m_SwapchainWidth, m_SwapchainHeight };
+	desc.InterpolationRect = {
+		static_cast<int32_t>(m_PostUpscaleRenderOffsetX),
+		static_cast<int32_t>(m_PostUpscaleRenderOffsetY),
+		static_cast<int32_t>(m_PostUpscaleRenderWidth),
+		static_cast<int32_t>(m_PostUpscaleRenderHeight),
+	};
 
-	LoadTextureFromNGXParameters(NGXParameters, "DLSSG.HUDLess", &desc.InputHUDLessColorBuffer, FFX_RESOURCE_STATE_COPY_DEST);
+	desc.InputHUDLessColorBuffer = m_FrameInputs.HUDLess;
+	desc.InputColorBuffer = m_FrameInputs.Backbuffer;
 
-	if (!LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Backbuffer", &desc.InputColorBuffer, FFX_RESOURCE_STATE_COMPUTE_READ) &&
-		!desc.InputHUDLessColorBuffer.resource)
+	if (!desc.InputColorBuffer.resource && !desc.InputHUDLessColorBuffer.resource)
 		return false;
 
-	if (!LoadTextureFromNGXParameters(
-			NGXParameters,
-			"DLSSG.OutputInterpolated",
-			&desc.OutputInterpolatedColorBuffer,
-			FFX_RESOURCE_STATE_UNORDERED_ACCESS))
-		return false;
-
-	if (!LoadTextureFromNGXParameters(NGXParameters, "DLSSG.Depth", &desc.InputDepth, FFX_RESOURCE_STATE_COPY_DEST))
-		return false;
+	desc.OutputInterpolatedColorBuffer = m_FrameInputs.OutputInterpolated;
+	desc.InputDepth = m_FrameInputs.Depth;
+	desc.InputMotionVectors = m_FrameInputs.MVecs;
 
-	if (!LoadTextureFromNGXParameters(NGXParameters, "DLSSG.MVecs", &desc.InputMotionVectors, FFX_RESOURCE_STATE_COPY_DEST))
+	if (!desc.OutputInterpolatedColorBuffer.resource || !desc.InputDepth.resource || !desc.InputMotionVectors.resource)
 		return false;
 
-	if (LoadTextureFromNGXParameters(NGXParameters, "DLSSG.BidirectionalDistortionField", &desc.InputDistortionField, FFX_RESOURCE_STATE_COPY_DEST))
+	if (m_FrameInputs.DistortionField.resource)
 	{
-		const bool isLowRes = NGXParameters->GetUIntOrDefault("DLSSG.BidirectionalDistortionFieldLowPrecision.IsLowPrecision", 0) != 0;
+		desc.InputDistortionField = m_FrameInputs.DistortionField;
 
-		if (isLowRes)
+		if (m_FrameInputs.DistortionFieldLowPrecision)
 		{
 			desc.InputDistortionField = {};
 
@@ -339,16 +641,13 @@ bool FFFrameInterpolator::BuildFrameInterpolationParameters(
 		// DLSSG.BidirectionalDistortionFieldSubrectWidth, DLSSG.BidirectionalDistortionFieldSubrectHeight
 	}
 
-	desc.InputOpticalFlowVector = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_TexSharedOpticalFlowVector);
-	desc.InputOpticalFlowSceneChangeDetection = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_TexSharedOpticalFlowSCD);
+	desc.InputOpticalFlowVector = m_Backend->Shared.fpGetResource(&m_Backend->Shared, *m_TexSharedOpticalFlowVector);
+	desc.InputOpticalFlowSceneChangeDetection = m_Backend->Shared.fpGetResource(&m_Backend->Shared, *m_TexSharedOpticalFlowSCD);
 
 	desc.OpticalFlowScale = { 1.0f / m_PostUpscaleRenderWidth, 1.0f / m_PostUpscaleRenderHeight };
 	desc.OpticalFlowBlockSize = 8;
 
-	FfxDimensions2D mvecExtents = {
-		NGXParameters->GetUIntOrDefault("DLSSG.MVecsSubrectWidth", 0),
-		NGXParameters->GetUIntOrDefault("DLSSG.MVecsSubrectHeight", 0),
-	};
+	FfxDimensions2D mvecExtents = m_FrameInputs.MVecsSubrect;
 
 	if (mvecExtents.width == 0 ||
 		mvecExtents.width > desc.InputMotionVectors.description.width ||
@@ -360,138 +659,86 @@ bool FFFrameInterpolator::BuildFrameInterpolationParameters(
 	}
 
 	desc.MotionVectorsFullResolution = m_PostUpscaleRenderWidth == mvecExtents.width && m_PostUpscaleRenderHeight == mvecExtents.height;
-	desc.MotionVectorJitterCancellation = NGXParameters->GetUIntOrDefault("DLSSG.MvecJittered", 0) != 0;
-	desc.MotionVectorsDilated = NGXParameters->GetUIntOrDefault("DLSSG.MvecDilated", 0) != 0;
+	desc.MotionVectorJitterCancellation = m_FrameInputs.MvecJittered;
+	desc.MotionVectorsDilated = m_FrameInputs.MvecDilated;
+	desc.MotionVectorScale = m_FrameInputs.MvecScale;
+	desc.MotionVectorJitterOffsets = m_FrameInputs.JitterOffset;
 
-	desc.MotionVectorScale = {
-		NGXParameters->GetFloatOrDefault("DLSSG.MvecScaleX", 1.0f),
-		NGXParameters->GetFloatOrDefault("DLSSG.MvecScaleY", 1.0f),
-	};
+	desc.HDR = m_FrameInputs.HDR;
+	desc.DepthInverted = m_FrameInputs.Camera.DepthInverted;
+	desc.Reset = m_FrameInputs.Reset;
 
-	desc.MotionVectorJitterOffsets = {
-		NGXParameters->GetFloatOrDefault("DLSSG.JitterOffsetX", 0.0f),
-		NGXParameters->GetFloatOrDefault("DLSSG.JitterOffsetY", 0.0f),
-	};
-
-	desc.HDR = NGXParameters->GetUIntOrDefault("DLSSG.ColorBuffersHDR", 0) != 0;
-	desc.DepthInverted = NGXParameters->GetUIntOrDefault("DLSSG.DepthInverted", 0) != 0;
-	desc.Reset = NGXParameters->GetUIntOrDefault("DLSSG.Reset", 0) != 0;
-
-	auto loadCameraMatrix = [&]()
-	{
-		const bool isOrthographicProjection = NGXParameters->GetUIntOrDefault("DLSSG.OrthoProjection", 0) != 0;
+	const auto& camera = m_FrameInputs.GetCameraParameters();
+	desc.CameraNear = camera.Near;
+	desc.CameraFar = camera.Far;
+	desc.CameraFovAngleVertical = camera.FovAngleVertical;
+	desc.DepthPlaneInfinite = camera.DepthPlaneInfinite;
 
-		if (isOrthographicProjection)
-			return false;
+	desc.MinMaxLuminance = m_HDRLuminanceRange;
 
-		float(*cameraViewToClip)[4] = nullptr;
-		NGXParameters->GetVoidPointer("DLSSG.CameraViewToClip", reinterpret_cast<void **>(&cameraViewToClip));
+	return true;
+}
 
-		if (!cameraViewToClip)
-			return false;
+void FFFrameInterpolator::CaptureFrameInputs()
+{
+	TRACE_ZONE("capture", "CaptureFrameInputs");
 
-		float projMatrix[4][4];
-		memcpy(projMatrix, cameraViewToClip, sizeof(projMatrix));
+	const std::array<const FfxResource *, FrameCapture::TextureCount> textures = {
+		&m_FrameInputs.Backbuffer,
+		&m_FrameInputs.HUDLess,
+		&m_FrameInputs.Depth,
+		&m_FrameInputs.MVecs,
+	};
 
-		// BUG: Various RTX Remix-based games pass in an identity matrix which is completely useless. No
-		// idea why.
-		const bool isEmptyOrIdentityMatrix = [&]()
-		{
-			float m[4][4] = {};
-			if (memcmp(projMatrix, m, sizeof(m)) == 0)
-				return true;
+	auto frame = m_FrameCapture->BeginFrame(m_FrameInputs, textures);
 
-			m[0][0] = m[1][1] = m[2][2] = m[3][3] = 1.0f;
-			return memcmp(projMatrix, m, sizeof(m)) == 0;
-		}();
+	if (!frame)
+		return;
 
-		if (isEmptyOrIdentityMatrix)
-			return false;
+	// Readback buffers only grow. Free slots are never in use by the GPU.
+	if (frame->Buffer.Size < frame->RequiredSize)
+	{
+		if (frame->Buffer.Handle)
+			DestroyReadbackBuffer(frame->Buffer);
 
-		// BUG: Indiana Jones and the Great Circle passes in what appears to be column-major matrices.
-		// Streamline expects row-major and so do we.
-		const static bool isTheGreatCircle = GetModuleHandleW(L"TheGreatCircle.exe") != nullptr;
+		frame->Buffer = {};
 
-		for (int i = 0; i < 4 && isTheGreatCircle; i++)
+		if (!CreateReadbackBuffer(frame->RequiredSize, &frame->Buffer))
 		{
-			for (int j = i + 1; j < 4; j++)
-				std::swap(projMatrix[i][j], projMatrix[j][i]);
-		}
-
-		// a 0 0 0
-		// 0 b 0 0
-		// 0 0 c e
-		// 0 0 d 0
-		const double b = projMatrix[1][1];
-		const double c = projMatrix[2][2];
-		const double d = projMatrix[3][2];
-		const double e = projMatrix[2][3];
+			const static bool once = [&]()
+			{
+				spdlog::error("Failed to create a {} byte frame capture readback buffer.", frame->RequiredSize);
+				return true;
+			}();
 
-		if (e < 0.0)
-		{
-			desc.CameraNear = static_cast<float>((c == 0.0) ? 0.0 : (d / c));
-			desc.CameraFar = static_cast<float>(d / (c + 1.0));
+			m_FrameCapture->CancelFrame(frame);
+			return;
 		}
-		else
-		{
-			desc.CameraNear = static_cast<float>((c == 0.0) ? 0.0 : (-d / c));
-			desc.CameraFar = static_cast<float>(-d / (c - 1.0));
-		}
-
-		if (desc.DepthInverted)
-			std::swap(desc.CameraNear, desc.CameraFar);
-
-		desc.CameraFovAngleVertical = static_cast<float>(2.0 * std::atan(1.0 / b));
-		return true;
-	};
-
-	if (!loadCameraMatrix())
-	{
-		// Some games pass in CameraFOV as degrees. Some games pass in CameraFOV as radians. Which is
-		// correct? Who knows. I sure as hell don't.
-		desc.CameraFovAngleVertical = NGXParameters->GetFloatOrDefault("DLSSG.CameraFOV", 0.0f);
-
-		// BUG: RTX Remix-based games pass in a FOV of 0. This is a kludge.
-		if (desc.CameraFovAngleVertical == 0.0f)
-			desc.CameraFovAngleVertical = 90.0f;
-
-		if (desc.CameraFovAngleVertical > 10.0f)
-			desc.CameraFovAngleVertical *= std::numbers::pi_v<float> / 180.0f;
-
-		desc.CameraNear = NGXParameters->GetFloatOrDefault("DLSSG.CameraNear", 0.0f);
-		desc.CameraFar = NGXParameters->GetFloatOrDefault("DLSSG.CameraFar", 0.0f);
 	}
 
-	if (desc.CameraNear != 0.0f && desc.CameraFar == 0.0f)
+	for (uint32_t i = 0; i < textures.size(); i++)
 	{
-		// A CameraFar value of zero indicates an infinite far plane. Due to a bug in FSR's
-		// setupDeviceDepthToViewSpaceDepthParams function, CameraFar must always be greater than
-		// CameraNear when in use.
-		desc.DepthPlaneInfinite = true;
-		desc.CameraFar = desc.CameraNear + 1.0f;
-	}
+		const auto& layout = frame->Layouts[i];
 
-	desc.MinMaxLuminance = m_HDRLuminanceRange;
+		if (layout.RowPitch != 0)
+			CopyTextureToReadback(GetActiveCommandList(), frame->Buffer, layout.Offset, layout.RowPitch, textures[i]);
+	}
 
-	return true;
+	WriteReadbackMarker(GetActiveCommandList(), frame->Buffer, FrameCapture::MarkerOffset, frame->Serial);
+	m_FrameCapture->SubmitFrame(frame);
 }
 
-FfxErrorCode FFFrameInterpolator::CreateBackend(NGXInstanceParameters *NGXParameters)
+uint64_t FFFrameInterpolator::QueryBackendVRAMUsage()
 {
-	const uint32_t maxContexts = 3; // Assume 3 contexts per interface
-
-	auto status = InitializeBackendInterface(&m_SharedBackendInterface, maxContexts, NGXParameters);
-
-	if (status != FFX_OK)
-		return status;
-
-	status = InitializeBackendInterface(&m_FrameInterpolationBackendInterface, maxContexts, NGXParameters);
-
-	if (status != FFX_OK)
-		return status;
+	// Interfaces are shared, so this includes every feature on the device
+	return m_Backend->Shared.QueryVRAMUsage(FFBackendPool::MaxSharedBackendContexts) +
+		   m_Backend->FrameInterpolation.QueryVRAMUsage(m_Backend->FrameInterpolationContextCount);
+}
 
-	status = m_SharedBackendInterface.fpCreateBackendContext(
-		&m_SharedBackendInterface,
+FfxErrorCode FFFrameInterpolator::CreateBackend()
+{
+	auto status = m_Backend->Shared.fpCreateBackendContext(
+		&m_Backend->Shared,
 		FFX_EFFECT_FRAMEINTERPOLATION,
 		nullptr,
 		&m_SharedEffectContextId.emplace());
@@ -508,17 +755,19 @@ FfxErrorCode FFFrameInterpolator::CreateBackend(NGXInstanceParameters *NGXParame
 void FFFrameInterpolator::DestroyBackend()
 {
 	if (m_SharedEffectContextId)
-		m_SharedBackendInterface.fpDestroyBackendContext(&m_SharedBackendInterface, *m_SharedEffectContextId);
+		m_Backend->Shared.fpDestroyBackendContext(&m_Backend->Shared, *m_SharedEffectContextId);
 
 	m_SharedEffectContextId.reset();
 }
 
-FfxErrorCode FFFrameInterpolator::CreateOpticalFlowContext()
+FfxErrorCode FFFrameInterpolator::CreateOpticalFlowContext(uint32_t Width, uint32_t Height)
 {
+	TRACE_ZONE("context", "CreateOpticalFlowContext");
+
 	FfxOpticalflowContextDescription fsrOfDescription = {
-		.backendInterface = m_FrameInterpolationBackendInterface,
+		.backendInterface = m_Backend->FrameInterpolation,
 		.flags = 0,
-		.resolution = { m_SwapchainWidth, m_SwapchainHeight },
+		.resolution = { Width, Height },
 	};
 
 	auto status = ffxOpticalflowContextCreate(&m_OpticalFlowContext.emplace(), &fsrOfDescription);
@@ -538,8 +787,8 @@ FfxErrorCode FFFrameInterpolator::CreateOpticalFlowContext()
 		return status;
 	}
 
-	status = m_SharedBackendInterface.fpCreateResource(
-		&m_SharedBackendInterface,
+	status = m_Backend->Shared.fpCreateResource(
+		&m_Backend->Shared,
 		&fsrOfSharedDescriptions.opticalFlowVector,
 		*m_SharedEffectContextId,
 		&m_TexSharedOpticalFlowVector.emplace());
@@ -552,8 +801,8 @@ FfxErrorCode FFFrameInterpolator::CreateOpticalFlowContext()
 		return status;
 	}
 
-	status = m_SharedBackendInterface.fpCreateResource(
-		&m_SharedBackendInterface,
+	status = m_Backend->Shared.fpCreateResource(
+		&m_Backend->Shared,
 		&fsrOfSharedDescriptions.opticalFlowSCD,
 		*m_SharedEffectContextId,
 		&m_TexSharedOpticalFlowSCD.emplace());
@@ -575,10 +824,10 @@ void FFFrameInterpolator::DestroyOpticalFlowContext()
 		ffxOpticalflowContextDestroy(&m_OpticalFlowContext.value());
 
 	if (m_TexSharedOpticalFlowVector)
-		m_SharedBackendInterface.fpDestroyResource(&m_SharedBackendInterface, *m_TexSharedOpticalFlowVector, *m_SharedEffectContextId);
+		m_Backend->Shared.fpDestroyResource(&m_Backend->Shared, *m_TexSharedOpticalFlowVector, *m_SharedEffectContextId);
 
 	if (m_TexSharedOpticalFlowSCD)
-		m_SharedBackendInterface.fpDestroyResource(&m_SharedBackendInterface, *m_TexSharedOpticalFlowSCD, *m_SharedEffectContextId);
+		m_Backend->Shared.fpDestroyResource(&m_Backend->Shared, *m_TexSharedOpticalFlowSCD, *m_SharedEffectContextId);
 
 	m_OpticalFlowContext.reset();
 	m_TexSharedOpticalFlowVector.reset();
@@ -1,29 +1,45 @@
 #pragma once
 
 #include <FidelityFX/host/ffx_opticalflow.h>
-#include "FFInterfaceWrapper.h"
+#include "FFBackendPool.h"
 #include "FFInterpolator.h"
+#include "DLSSGFrameInputs.h"
+#include "FrameCapture.h"
+#include "FrameGenerationGovernor.h"
+#include "HostStageProfiler.h"
 
 struct NGXInstanceParameters;
 
 class FFFrameInterpolator
 {
 private:
-	FFInterfaceWrapper m_FrameInterpolationBackendInterface;
-	FFInterfaceWrapper m_SharedBackendInterface;
+	std::shared_ptr<FFBackendInterfaces> m_Backend; // Shared with every other feature on the same device
 	std::optional<FfxUInt32> m_SharedEffectContextId;
 
 	std::optional<FfxOpticalflowContext> m_OpticalFlowContext;
 	std::optional<FFInterpolator> m_FrameInterpolatorContext;
 
-	std::optional<FfxResourceInternal> m_TexSharedDilatedDepth;
-	std::optional<FfxResourceInternal> m_TexSharedDilatedMotionVectors;
-	std::optional<FfxResourceInternal> m_TexSharedPreviousNearestDepth;
 	std::optional<FfxResourceInternal> m_TexSharedOpticalFlowVector;
 	std::optional<FfxResourceInternal> m_TexSharedOpticalFlowSCD;
 
-	const uint32_t m_SwapchainWidth; // Final image presented to the screen dimensions
-	const uint32_t m_SwapchainHeight;
+	uint32_t m_SwapchainWidth; // Final image presented to the screen dimensions
+	uint32_t m_SwapchainHeight;
+
+	uint32_t m_MaxSwapchainWidth; // Dimensions all contexts are allocated with
+	uint32_t m_MaxSwapchainHeight;
+	bool m_ContextResizePending = false;
+
+	DLSSGFrameInputs m_FrameInputs;
+	std::optional<FrameGenerationGovernor> m_Governor;
+	std::optional<HostStageProfiler> m_HostStageProfiler;
+	std::optional<FrameCapture> m_FrameCapture;
+	std::pair<void *, void *> m_LastOutputRealCopy; // Destination and source of the previous OutputReal copy
+	bool m_RealFrameResetHistory = false; // Applies to every interpolated frame of the current real frame
+	bool m_RealFrameInputsPrepared = false; // Optical flow and input preparation ran for the current real frame
+
+	bool m_ContextsRecreated = false; // Live metrics
+	uint32_t m_LiveMetricsFrameCount = 0;
+	uint64_t m_BackendVRAMUsage = 0;
 
 	FfxFloatCoords2D m_HDRLuminanceRange = { 0.0001f, 1000.0f };
 	bool m_HDRLuminanceRangeSet = false;
@@ -32,10 +48,14 @@ private:
 	uint32_t m_PreUpscaleRenderWidth = 0; // GBuffer dimensions
 	uint32_t m_PreUpscaleRenderHeight = 0;
 
+	uint32_t m_PostUpscaleRenderOffsetX = 0; // Active (non-letterboxed) region of the swapchain
+	uint32_t m_PostUpscaleRenderOffsetY = 0;
 	uint32_t m_PostUpscaleRenderWidth = 0;
 	uint32_t m_PostUpscaleRenderHeight = 0;
 
 public:
+	constexpr static uint32_t MaxMultiFrameCount = 3; // Interpolated frames generated between each pair of real frames
+
 	FFFrameInterpolator(uint32_t OutputWidth, uint32_t OutputHeight);
 	FFFrameInterpolator(const FFFrameInterpolator&) = delete;
 	FFFrameInterpolator& operator=(const FFFrameInterpolator&) = delete;
@@ -43,16 +63,33 @@ public:
 
 	virtual FfxErrorCode Dispatch(void *CommandList, NGXInstanceParameters *NGXParameters);
 
+	// Predicts what a feature created for this swapchain would allocate. Implausible descriptions return the previous
+	// estimate.
+	static uint64_t EstimateVRAMUsage(uint32_t SwapchainBufferCount, uint32_t Width, uint32_t Height, FfxSurfaceFormat BackbufferFormat);
+
 protected:
 	virtual FfxErrorCode InitializeBackendInterface(
 		FFInterfaceWrapper *BackendInterface,
 		uint32_t MaxContexts,
 		NGXInstanceParameters *NGXParameters) = 0;
 
+	virtual void *GetBackendDevice() const = 0;
 	virtual std::array<uint8_t, 8> GetActiveAdapterLUID() const = 0;
 	virtual FfxCommandList GetActiveCommandList() const = 0;
 
 	virtual void CopyTexture(FfxCommandList CommandList, const FfxResource *Destination, const FfxResource *Source) = 0;
+	virtual FfxSurfaceFormat GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const = 0;
+
+	virtual bool CreateReadbackBuffer(uint64_t Size, FrameCapture::ReadbackBuffer *OutBuffer) = 0;
+	virtual void DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer& Buffer) = 0;
+
+	virtual void CopyTextureToReadback(
+		FfxCommandList CommandList,
+		const FrameCapture::ReadbackBuffer& Destination,
+		uint64_t Offset,
+		uint32_t RowPitch,
+		const FfxResource *Source) = 0;
+	virtual void WriteReadbackMarker(FfxCommandList CommandList, const FrameCapture::ReadbackBuffer& Destination, uint64_t Offset, uint32_t Value) = 0;
 
 	virtual bool LoadTextureFromNGXParameters(
 		NGXInstanceParameters *NGXParameters,
@@ -60,18 +97,28 @@ protected:
 		FfxResource *OutFfxResource,
 		FfxResourceStates State) = 0;
 
+	// Called with the backend locked once every texture of the frame is loaded, before any of them are used. Reset is
+	// DLSSG.Reset, which games tend to set when they recreate their render targets.
+	virtual void OnFrameTexturesLoaded(FFBackendInterfaces& Backend, bool Reset) = 0;
+
 protected:
 	void Create(NGXInstanceParameters *NGXParameters);
 	void Destroy();
 
-private:
-	bool CalculateResourceDimensions(NGXInstanceParameters *NGXParameters);
-	void QueryHDRLuminanceRange(NGXInstanceParameters *NGXParameters);
-	bool BuildOpticalFlowParameters(FfxOpticalflowDispatchDescription *OutParameters, NGXInstanceParameters *NGXParameters);
-	bool BuildFrameInterpolationParameters(FFInterpolatorDispatchParameters *OutParameters, NGXInstanceParameters *NGXParameters);
+	// Blocks until the context predicted by Create is built. Games pass frames through in the meantime instead.
+	void WaitForContextCreation() const;
 
-	FfxErrorCode CreateBackend(NGXInstanceParameters *NGXParameters);
+private:
+	FfxErrorCode ResizeSwapchain(uint32_t Width, uint32_t Height);
+	bool CalculateResourceDimensions();
+	void QueryHDRLuminanceRange();
+	bool BuildOpticalFlowParameters(FfxOpticalflowDispatchDescription *OutParameters);
+	bool BuildFrameInterpolationParameters(FFInterpolatorDispatchParameters *OutParameters);
+	void CaptureFrameInputs();
+	uint64_t QueryBackendVRAMUsage();
+
+	FfxErrorCode CreateBackend();
 	void DestroyBackend();
-	FfxErrorCode CreateOpticalFlowContext();
+	FfxErrorCode CreateOpticalFlowContext(uint32_t Width, uint32_t Height);
 	void DestroyOpticalFlowContext();
 };
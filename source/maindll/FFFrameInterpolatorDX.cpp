@@ -59,6 +59,11 @@ FfxErrorCode FFFrameInterpolatorDX::InitializeBackendInterface(
 	return BackendInterface->Initialize(m_Device, MaxContexts, NGXParameters);
 }
 
+void *FFFrameInterpolatorDX::GetBackendDevice() const
+{
+	return m_Device;
+}
+
 FfxCommandList FFFrameInterpolatorDX::GetActiveCommandList() const
 {
 	return m_ActiveCommandList;
@@ -98,6 +103,134 @@ void FFFrameInterpolatorDX::CopyTexture(FfxCommandList CommandList, const FfxRes
 	cmdList12->ResourceBarrier(2, barriers);
 }
 
+FfxSurfaceFormat FFFrameInterpolatorDX::GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const
+{
+	const auto format = NGXParameters->GetUIntOrDefault("DLSSG.BackbufferFormat", DXGI_FORMAT_UNKNOWN);
+	return ffxGetSurfaceFormatDX12(static_cast<DXGI_FORMAT>(format));
+}
+
+bool FFFrameInterpolatorDX::CreateReadbackBuffer(uint64_t Size, FrameCapture::ReadbackBuffer *OutBuffer)
+{
+	const D3D12_HEAP_PROPERTIES heapProperties = {
+		.Type = D3D12_HEAP_TYPE_READBACK,
+	};
+
+	const D3D12_RESOURCE_DESC description = {
+		.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER,
+		.Width = Size,
+		.Height = 1,
+		.DepthOrArraySize = 1,
+		.MipLevels = 1,
+		.SampleDesc = { 1, 0 },
+		.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR,
+	};
+
+	ID3D12Resource *buffer = nullptr;
+
+	if (FAILED(m_Device->CreateCommittedResource(
+			&heapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&description,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(&buffer))))
+		return false;
+
+	// Readback heaps stay mapped for the buffer's lifetime
+	void *data = nullptr;
+
+	if (FAILED(buffer->Map(0, nullptr, &data)))
+	{
+		buffer->Release();
+		return false;
+	}
+
+	memset(static_cast<uint8_t *>(data) + FrameCapture::MarkerOffset, 0, sizeof(uint32_t));
+
+	*OutBuffer = {
+		.Handle = buffer,
+		.Data = static_cast<const uint8_t *>(data),
+		.Size = Size,
+	};
+
+	return true;
+}
+
+void FFFrameInterpolatorDX::DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer& Buffer)
+{
+	static_cast<ID3D12Resource *>(Buffer.Handle)->Release();
+}
+
+void FFFrameInterpolatorDX::CopyTextureToReadback(
+	FfxCommandList CommandList,
+	const FrameCapture::ReadbackBuffer& Destination,
+	uint64_t Offset,
+	uint32_t RowPitch,
+	const FfxResource *Source)
+{
+	const auto cmdList12 = reinterpret_cast<ID3D12GraphicsCommandList *>(CommandList);
+	const auto sourceResource = static_cast<ID3D12Resource *>(Source->resource);
+	const auto sourceDescription = sourceResource->GetDesc();
+
+	D3D12_RESOURCE_BARRIER barrier = {};
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.Transition.pResource = sourceResource;
+	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+	barrier.Transition.StateBefore = ffxGetDX12StateFromResourceState(Source->state);
+	barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+
+	// Depth-stencil formats copy their depth plane. The footprint provides the matching plane format.
+	D3D12_TEXTURE_COPY_LOCATION destinationLocation = {};
+	destinationLocation.pResource = static_cast<ID3D12Resource *>(Destination.Handle);
+	destinationLocation.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+	m_Device->GetCopyableFootprints(&sourceDescription, 0, 1, Offset, &destinationLocation.PlacedFootprint, nullptr, nullptr, nullptr);
+	destinationLocation.PlacedFootprint.Footprint.RowPitch = RowPitch;
+
+	D3D12_TEXTURE_COPY_LOCATION sourceLocation = {};
+	sourceLocation.pResource = sourceResource;
+	sourceLocation.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+	sourceLocation.SubresourceIndex = 0;
+
+	cmdList12->ResourceBarrier(1, &barrier);
+	cmdList12->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+	std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+	cmdList12->ResourceBarrier(1, &barrier);
+}
+
+void FFFrameInterpolatorDX::WriteReadbackMarker(
+	FfxCommandList CommandList,
+	const FrameCapture::ReadbackBuffer& Destination,
+	uint64_t Offset,
+	uint32_t Value)
+{
+	const auto cmdList12 = reinterpret_cast<ID3D12GraphicsCommandList *>(CommandList);
+
+	ID3D12GraphicsCommandList2 *cmdList2 = nullptr;
+
+	if (FAILED(cmdList12->QueryInterface(IID_PPV_ARGS(&cmdList2))))
+	{
+		const static bool once = []()
+		{
+			spdlog::error("ID3D12GraphicsCommandList2 is unavailable. Captured frames will never complete.");
+			return true;
+		}();
+
+		return;
+	}
+
+	// Marker writes land after all preceding work on the command list completes
+	const D3D12_WRITEBUFFERIMMEDIATE_PARAMETER parameter = {
+		.Dest = static_cast<ID3D12Resource *>(Destination.Handle)->GetGPUVirtualAddress() + Offset,
+		.Value = Value,
+	};
+
+	const auto mode = D3D12_WRITEBUFFERIMMEDIATE_MODE_MARKER_OUT;
+
+	cmdList2->WriteBufferImmediate(1, &parameter, &mode);
+	cmdList2->Release();
+}
+
 bool FFFrameInterpolatorDX::LoadTextureFromNGXParameters(
 	NGXInstanceParameters *NGXParameters,
 	const char *Name,
@@ -116,3 +249,8 @@ bool FFFrameInterpolatorDX::LoadTextureFromNGXParameters(
 	*OutFfxResource = ffxGetResourceDX12(resource, ffxGetResourceDescriptionDX12(resource), nullptr, State);
 	return true;
 }
+
+void FFFrameInterpolatorDX::OnFrameTexturesLoaded(FFBackendInterfaces&, bool)
+{
+	// Descriptors are written from scratch every frame. Nothing outlives the resources they point to.
+}
@@ -26,14 +26,29 @@ private:
 		uint32_t MaxContexts,
 		NGXInstanceParameters *NGXParameters) override;
 
+	void *GetBackendDevice() const override;
 	std::array<uint8_t, 8> GetActiveAdapterLUID() const override;
 	FfxCommandList GetActiveCommandList() const override;
 
 	void CopyTexture(FfxCommandList CommandList, const FfxResource *Destination, const FfxResource *Source) override;
+	FfxSurfaceFormat GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const override;
+
+	bool CreateReadbackBuffer(uint64_t Size, FrameCapture::ReadbackBuffer *OutBuffer) override;
+	void DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer& Buffer) override;
+
+	void CopyTextureToReadback(
+		FfxCommandList CommandList,
+		const FrameCapture::ReadbackBuffer& Destination,
+		uint64_t Offset,
+		uint32_t RowPitch,
+		const FfxResource *Source) override;
+	void WriteReadbackMarker(FfxCommandList CommandList, const FrameCapture::ReadbackBuffer& Destination, uint64_t Offset, uint32_t Value) override;
 
 	bool LoadTextureFromNGXParameters(
 		NGXInstanceParameters *NGXParameters,
 		const char *Name,
 		FfxResource *OutFfxResource,
 		FfxResourceStates State) override;
+
+	void OnFrameTexturesLoaded(FFBackendInterfaces& Backend, bool Reset) override;
 };
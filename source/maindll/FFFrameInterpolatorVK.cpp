@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <FidelityFX/host/backends/vk/ffx_vk.h>
 #include "NGX/NvNGX.h"
 #include "FFFrameInterpolatorVK.h"
+#include "VRAMEstimator.h"
+#include "Util.h"
 
 VkAccessFlags getVKAccessFlagsFromResourceState(FfxResourceStates state);
 VkImageLayout getVKImageLayoutFromResourceState(FfxResourceStates state);
@@ -34,15 +37,11 @@ FfxErrorCode FFFrameInterpolatorVK::Dispatch(void *CommandList, NGXInstanceParam
 	// Begin a new command list in the event our caller didn't set one up
 	if (!isRecordingCommands)
 	{
-		const static bool once = [&]()
-		{
-			spdlog::warn(
-				"Vulkan command list wasn't recording. Resetting state: {} 0x{:X}",
-				enableInterpolation,
-				reinterpret_cast<uintptr_t>(CommandList));
-
-			return false;
-		}();
+		LOG_RATE_LIMITED(
+			warn,
+			"Vulkan command list wasn't recording. Resetting state: {} 0x{:X}",
+			enableInterpolation,
+			reinterpret_cast<uintptr_t>(CommandList));
 
 		VkCommandBufferBeginInfo info = {
 			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
@@ -70,6 +69,11 @@ FfxErrorCode FFFrameInterpolatorVK::InitializeBackendInterface(
 	return BackendInterface->Initialize(m_Device, m_PhysicalDevice, MaxContexts, NGXParameters);
 }
 
+void *FFFrameInterpolatorVK::GetBackendDevice() const
+{
+	return m_Device;
+}
+
 FfxCommandList FFFrameInterpolatorVK::GetActiveCommandList() const
 {
 	return m_ActiveCommandList;
@@ -151,6 +155,148 @@ void FFFrameInterpolatorVK::CopyTexture(FfxCommandList CommandList, const FfxRes
 		barriers.data());
 }
 
+FfxSurfaceFormat FFFrameInterpolatorVK::GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const
+{
+	const auto format = NGXParameters->GetUIntOrDefault("DLSSG.BackbufferFormat", VK_FORMAT_UNDEFINED);
+	return ffxGetSurfaceFormatVK(static_cast<VkFormat>(format));
+}
+
+bool FFFrameInterpolatorVK::CreateReadbackBuffer(uint64_t Size, FrameCapture::ReadbackBuffer *OutBuffer)
+{
+	const VkBufferCreateInfo bufferInfo = {
+		.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+		.size = Size,
+		.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+	};
+
+	VkBuffer buffer = VK_NULL_HANDLE;
+
+	if (vkCreateBuffer(m_Device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS)
+		return false;
+
+	VkMemoryRequirements memoryRequirements = {};
+	vkGetBufferMemoryRequirements(m_Device, buffer, &memoryRequirements);
+
+	VkPhysicalDeviceMemoryProperties memoryProperties = {};
+	vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memoryProperties);
+
+	const auto findMemoryType = [&](VkMemoryPropertyFlags Flags) -> std::optional<uint32_t>
+	{
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+		{
+			if ((memoryRequirements.memoryTypeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & Flags) == Flags)
+				return i;
+		}
+
+		return std::nullopt;
+	};
+
+	// Cached memory keeps host reads fast. Coherent memory avoids invalidating ranges on the writer thread.
+	auto memoryType = findMemoryType(
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+
+	if (!memoryType)
+		memoryType = findMemoryType(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	const VkMemoryAllocateInfo allocateInfo = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+		.allocationSize = memoryRequirements.size,
+		.memoryTypeIndex = memoryType.value_or(0),
+	};
+
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+	void *data = nullptr;
+
+	if (!memoryType ||
+		vkAllocateMemory(m_Device, &allocateInfo, nullptr, &memory) != VK_SUCCESS ||
+		vkBindBufferMemory(m_Device, buffer, memory, 0) != VK_SUCCESS ||
+		vkMapMemory(m_Device, memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS)
+	{
+		vkFreeMemory(m_Device, memory, nullptr);
+		vkDestroyBuffer(m_Device, buffer, nullptr);
+
+		return false;
+	}
+
+	memset(static_cast<uint8_t *>(data) + FrameCapture::MarkerOffset, 0, sizeof(uint32_t));
+
+	*OutBuffer = {
+		.Handle = buffer,
+		.Memory = memory,
+		.Data = static_cast<const uint8_t *>(data),
+		.Size = Size,
+	};
+
+	return true;
+}
+
+void FFFrameInterpolatorVK::DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer& Buffer)
+{
+	vkDestroyBuffer(m_Device, static_cast<VkBuffer>(Buffer.Handle), nullptr);
+	vkFreeMemory(m_Device, static_cast<VkDeviceMemory>(Buffer.Memory), nullptr);
+}
+
+void FFFrameInterpolatorVK::CopyTextureToReadback(
+	FfxCommandList CommandList,
+	const FrameCapture::ReadbackBuffer& Destination,
+	uint64_t Offset,
+	uint32_t RowPitch,
+	const FfxResource *Source)
+{
+	const auto cmdListVk = reinterpret_cast<VkCommandBuffer>(CommandList);
+	const bool isDepthAspect = (Source->description.usage & FFX_RESOURCE_USAGE_DEPTHTARGET) != 0;
+
+	const uint32_t srcStageMask = MakeVulkanStageFlags(Source->state);
+	const uint32_t destStageMask = MakeVulkanStageFlags(FFX_RESOURCE_STATE_COPY_SRC);
+
+	auto barrier = MakeVulkanBarrier(static_cast<VkImage>(Source->resource), Source->state, FFX_RESOURCE_STATE_COPY_SRC, isDepthAspect);
+
+	// Layout transitions of combined depth-stencil images cover both aspects
+	if (Source->description.usage & FFX_RESOURCE_USAGE_STENCILTARGET)
+		barrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+	vkCmdPipelineBarrier(cmdListVk, srcStageMask, destStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	// Only the depth aspect is read back. It's copied out at the size of its FFX format.
+	VkBufferImageCopy copyRegion = {};
+	copyRegion.bufferOffset = Offset;
+	copyRegion.bufferRowLength = RowPitch / VRAMEstimator::GetSurfaceFormatSize(Source->description.format);
+	copyRegion.imageSubresource.aspectMask = isDepthAspect ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+	copyRegion.imageSubresource.mipLevel = 0;
+	copyRegion.imageSubresource.baseArrayLayer = 0;
+	copyRegion.imageSubresource.layerCount = 1;
+	copyRegion.imageExtent = { Source->description.width, Source->description.height, 1 };
+
+	vkCmdCopyImageToBuffer(cmdListVk, barrier.image, barrier.newLayout, static_cast<VkBuffer>(Destination.Handle), 1, &copyRegion);
+
+	std::swap(barrier.srcAccessMask, barrier.dstAccessMask);
+	std::swap(barrier.oldLayout, barrier.newLayout);
+	vkCmdPipelineBarrier(cmdListVk, destStageMask, srcStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void FFFrameInterpolatorVK::WriteReadbackMarker(
+	FfxCommandList CommandList,
+	const FrameCapture::ReadbackBuffer& Destination,
+	uint64_t Offset,
+	uint32_t Value)
+{
+	const auto cmdListVk = reinterpret_cast<VkCommandBuffer>(CommandList);
+
+	// The marker is ordered after the copies and everything is made visible to the host along with it
+	VkMemoryBarrier barrier = {
+		.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+		.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+		.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+	};
+
+	vkCmdPipelineBarrier(cmdListVk, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+	vkCmdFillBuffer(cmdListVk, static_cast<VkBuffer>(Destination.Handle), Offset, sizeof(uint32_t), Value);
+
+	barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(cmdListVk, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
 bool FFFrameInterpolatorVK::LoadTextureFromNGXParameters(
 	NGXInstanceParameters *NGXParameters,
 	const char *Name,
@@ -167,6 +313,30 @@ bool FFFrameInterpolatorVK::LoadTextureFromNGXParameters(
 		return false;
 	}
 
+	const auto& metadata = resourceHandle->ImageMetadata;
+
+	const HostImage hostImage = {
+		.View = metadata.View,
+		.Format = metadata.Format,
+		.Width = metadata.Width,
+		.Height = metadata.Height,
+		.Subresource = metadata.Subresource,
+	};
+
+	// Forgetting an image is only safe once every view is dropped
+	if (!m_HostImages.contains(metadata.Image) && m_HostImages.size() >= MaxTrackedHostImages)
+	{
+		m_HostImages.clear();
+		m_HostImagesChanged = true;
+	}
+
+	if (auto [itr, inserted] = m_HostImages.try_emplace(metadata.Image, hostImage);
+		!inserted && memcmp(&itr->second, &hostImage, sizeof(hostImage)) != 0)
+	{
+		itr->second = hostImage;
+		m_HostImagesChanged = true;
+	}
+
 	// Vulkan provides no mechanism to query resource information. Convert it manually.
 	VkImageCreateInfo imageInfo = {
 		.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
@@ -244,3 +414,14 @@ VkPipelineStageFlags FFFrameInterpolatorVK::MakeVulkanStageFlags(FfxResourceStat
 
 	return VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 }
+
+void FFFrameInterpolatorVK::OnFrameTexturesLoaded(FFBackendInterfaces& Backend, bool Reset)
+{
+	// The backends cache image views by handle. Views of a recreated image would point to the old one. Other features
+	// sharing the backend simply recreate theirs.
+	if (!std::exchange(m_HostImagesChanged, false) && !Reset)
+		return;
+
+	ffxInvalidateImageViewsVK(&Backend.FrameInterpolation, VK_NULL_HANDLE);
+	ffxInvalidateImageViewsVK(&Backend.Shared, VK_NULL_HANDLE);
+}
@@ -9,10 +9,27 @@ private:
 	const VkDevice m_Device;
 	const VkPhysicalDevice m_PhysicalDevice;
 
+	struct HostImage
+	{
+		VkImageView View;
+		VkFormat Format;
+		uint32_t Width;
+		uint32_t Height;
+		VkImageSubresourceRange Subresource;
+	};
+
+	// Host images last seen for each handle. Drivers recycle image and view handles together, so a recreated image
+	// can only be told apart by its description. Any change drops every cached view on the next frame, as does a
+	// reset or a new feature.
+	std::unordered_map<VkImage, HostImage> m_HostImages;
+	bool m_HostImagesChanged = true;
+
 	// Transient
 	FfxCommandList m_ActiveCommandList = {};
 
 public:
+	constexpr static size_t MaxTrackedHostImages = 256;
+
 	FFFrameInterpolatorVK(
 		VkDevice LogicalDevice,
 		VkPhysicalDevice PhysicalDevice,
@@ -31,10 +48,23 @@ private:
 		uint32_t MaxContexts,
 		NGXInstanceParameters *NGXParameters) override;
 
+	void *GetBackendDevice() const override;
 	std::array<uint8_t, 8> GetActiveAdapterLUID() const override;
 	FfxCommandList GetActiveCommandList() const override;
 
 	void CopyTexture(FfxCommandList CommandList, const FfxResource *Destination, const FfxResource *Source) override;
+	FfxSurfaceFormat GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const override;
+
+	bool CreateReadbackBuffer(uint64_t Size, FrameCapture::ReadbackBuffer *OutBuffer) override;
+	void DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer& Buffer) override;
+
+	void CopyTextureToReadback(
+		FfxCommandList CommandList,
+		const FrameCapture::ReadbackBuffer& Destination,
+		uint64_t Offset,
+		uint32_t RowPitch,
+		const FfxResource *Source) override;
+	void WriteReadbackMarker(FfxCommandList CommandList, const FrameCapture::ReadbackBuffer& Destination, uint64_t Offset, uint32_t Value) override;
 
 	bool LoadTextureFromNGXParameters(
 		NGXInstanceParameters *NGXParameters,
@@ -42,6 +72,8 @@ private:
 		FfxResource *OutFfxResource,
 		FfxResourceStates State) override;
 
+	void OnFrameTexturesLoaded(FFBackendInterfaces& Backend, bool Reset) override;
+
 	static VkImageMemoryBarrier MakeVulkanBarrier(
 		VkImage Resource,
 		FfxResourceStates SourceState,
@@ -1,3 +1,5 @@
+#include <format>
+#include <spdlog/sinks/basic_file_sink.h>
 #include <directx/d3dx12.h>
 #pragma warning(push)
 #pragma warning(disable : 4005)
@@ -11,7 +13,12 @@
 #include <FidelityFX/host/backends/vk/ffx_vk.h>
 #pragma warning(pop)
 #include "NGX/NvNGX.h"
+#include "Config.h"
 #include "FFInterfaceWrapper.h"
+#include "LiveMetrics.h"
+#include "TraceRecorder.h"
+#include "Util.h"
+#include "VulkanPipelineCache.h"
 
 D3D12_RESOURCE_FLAGS ffxGetDX12ResourceFlags(FfxResourceUsage flags);
 D3D12_RESOURCE_STATES ffxGetDX12StateFromResourceState(FfxResourceStates state);
@@ -20,6 +27,8 @@ uint64_t GetResourceGpuMemorySizeDX12(ID3D12Resource *resource);
 static DXGI_FORMAT convertFormatUav(DXGI_FORMAT format);
 static DXGI_FORMAT convertFormatSrv(DXGI_FORMAT format);
 
+thread_local std::unique_lock<std::mutex> *FFInterfaceWrapper::m_PipelineCreationLock = nullptr;
+
 FFInterfaceWrapper::FFInterfaceWrapper()
 {
 	memset(this, 0, sizeof(*this));
@@ -27,6 +36,9 @@ FFInterfaceWrapper::FFInterfaceWrapper()
 
 FFInterfaceWrapper::~FFInterfaceWrapper()
 {
+	if (auto userData = GetUserData(); userData && userData->m_PipelineCacheDevice)
+		VulkanPipelineCache::Release(userData->m_PipelineCacheDevice);
+
 	delete[] reinterpret_cast<uint8_t *>(GetUserData());
 }
 
@@ -61,6 +73,12 @@ FfxErrorCode FFInterfaceWrapper::Initialize(ID3D12Device *Device, uint32_t MaxCo
 		}
 	}
 
+	if (result == FFX_OK)
+	{
+		InstallTraceCallbacks();
+		InstallPipelineCreationCallbacks();
+	}
+
 	return result;
 }
 
@@ -76,6 +94,7 @@ FfxErrorCode FFInterfaceWrapper::Initialize(
 		.vkDeviceProcAddr = nullptr,
 	};
 
+	const auto config = Config::Get();
 	const auto fsrDevice = ffxGetDeviceVK(&vkContext);
 	const auto scratchSize = ffxGetScratchMemorySizeVK(vkContext.vkPhysicalDevice, MaxContexts);
 
@@ -83,12 +102,258 @@ FfxErrorCode FFInterfaceWrapper::Initialize(
 	auto scratchMemory = new uint8_t[sizeof(UserDataHack) + scratchSize];
 	auto userData = new (scratchMemory) UserDataHack;
 
-	(void)userData;
-
 	auto ffxScratchMemory = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(scratchMemory) + sizeof(UserDataHack));
 	memset(ffxScratchMemory, 0, scratchSize);
 
-	return ffxGetInterfaceVK(this, fsrDevice, ffxScratchMemory, scratchSize, MaxContexts);
+	auto result = ffxGetInterfaceVK(this, fsrDevice, ffxScratchMemory, scratchSize, MaxContexts);
+
+	if (result == FFX_OK)
+	{
+		userData->m_Vulkan = true;
+
+		InstallTraceCallbacks();
+		InstallPipelineCreationCallbacks();
+	}
+
+	if (result == FFX_OK)
+	{
+		if (auto pipelineCache = VulkanPipelineCache::Acquire(Device, PhysicalDevice))
+		{
+			ffxSetPipelineCacheVK(this, pipelineCache);
+			userData->m_PipelineCacheDevice = Device;
+		}
+	}
+
+	if (result == FFX_OK)
+		ffxSetPushDescriptorsEnabledVK(this, config->EnableVulkanPushDescriptors);
+
+	if (result == FFX_OK && config->EnableGpuPassTimings)
+	{
+		const auto windowSize = config->GpuPassTimingsWindow;
+
+		if (ffxSetGpuPassTimingCallbackVK(this, windowSize, LogGpuPassTimingsVK, nullptr) != FFX_OK)
+		{
+			const static bool once = []()
+			{
+				spdlog::warn("GPU pass timings were requested but the device doesn't support timestamp queries.");
+				return false;
+			}();
+		}
+	}
+
+	return result;
+}
+
+void FFInterfaceWrapper::SavePipelineCache()
+{
+	if (auto userData = GetUserData(); userData && userData->m_PipelineCacheDevice)
+		VulkanPipelineCache::Save(userData->m_PipelineCacheDevice);
+}
+
+uint64_t FFInterfaceWrapper::QueryVRAMUsage(uint32_t MaxContexts)
+{
+	if (GetUserData()->m_Vulkan)
+	{
+		if (FfxDeviceMemoryStatsVK stats = {}; ffxGetDeviceMemoryStatsVK(this, &stats) == FFX_OK)
+			return stats.blockSize + stats.dedicatedAllocationSize;
+
+		return 0;
+	}
+
+	uint64_t totalUsage = 0;
+
+	for (uint32_t i = 0; i < MaxContexts; i++)
+	{
+		FfxEffectMemoryUsage usage = {};
+
+		if (fpGetEffectGpuMemoryUsage(this, i, &usage) == FFX_OK)
+			totalUsage += usage.totalUsageInBytes;
+	}
+
+	return totalUsage;
+}
+
+void FFInterfaceWrapper::LogMemoryStatistics(const char *Name)
+{
+	// DX12 resources are committed one by one. Nothing to report beyond the per-effect totals.
+	if (!GetUserData()->m_Vulkan)
+		return;
+
+	FfxDeviceMemoryStatsVK stats = {};
+
+	if (ffxGetDeviceMemoryStatsVK(this, &stats) != FFX_OK)
+		return;
+
+	constexpr double mib = 1024.0 * 1024.0;
+
+	spdlog::info(
+		"{} backend memory: {} blocks ({:.1f} MiB, {:.1f} MiB used by {} resources), {} dedicated allocations ({:.1f} MiB).",
+		Name,
+		stats.blockCount,
+		stats.blockSize / mib,
+		stats.blockUsedSize / mib,
+		stats.blockAllocationCount,
+		stats.dedicatedAllocationCount,
+		stats.dedicatedAllocationSize / mib);
+}
+
+void FFInterfaceWrapper::SetPipelineCreationLock(std::unique_lock<std::mutex> *Lock)
+{
+	m_PipelineCreationLock = Lock;
+}
+
+void FFInterfaceWrapper::InstallPipelineCreationCallbacks()
+{
+	auto userData = GetUserData();
+
+	userData->m_LockedCreatePipeline = std::exchange(fpCreatePipeline, UnlockedCreatePipeline);
+	userData->m_LockedDestroyPipeline = std::exchange(fpDestroyPipeline, RelockedDestroyPipeline);
+}
+
+void FFInterfaceWrapper::InstallTraceCallbacks()
+{
+#if defined(DLSSGTOFSR3_ENABLE_TRACING)
+	if (!Trace::IsEnabled())
+		return;
+
+	auto userData = GetUserData();
+
+	userData->m_CreatePipeline = std::exchange(fpCreatePipeline, TracedCreatePipeline);
+	userData->m_ExecuteGpuJobs = std::exchange(fpExecuteGpuJobs, TracedExecuteGpuJobs);
+#endif
+}
+
+FfxErrorCode FFInterfaceWrapper::TracedCreatePipeline(
+	FfxInterface *backendInterface,
+	FfxEffect effect,
+	FfxPass pass,
+	uint32_t permutationOptions,
+	const FfxPipelineDescription *pipelineDescription,
+	FfxUInt32 effectContextId,
+	FfxPipelineState *outPipeline)
+{
+	const auto start = std::chrono::steady_clock::now();
+	const auto status = static_cast<FFInterfaceWrapper *>(backendInterface)
+							->GetUserData()
+							->m_CreatePipeline(backendInterface, effect, pass, permutationOptions, pipelineDescription, effectContextId, outPipeline);
+
+	// Pipeline names are plain ASCII
+	std::string name = "CreatePipeline ";
+	for (auto c = pipelineDescription->name; *c; c++)
+		name += static_cast<char>(*c);
+
+	Trace::AddComplete(name, "backend", start, std::chrono::steady_clock::now());
+	return status;
+}
+
+FfxErrorCode FFInterfaceWrapper::UnlockedCreatePipeline(
+	FfxInterface *backendInterface,
+	FfxEffect effect,
+	FfxPass pass,
+	uint32_t permutationOptions,
+	const FfxPipelineDescription *pipelineDescription,
+	FfxUInt32 effectContextId,
+	FfxPipelineState *outPipeline)
+{
+	// ffxCreatePipelinesParallel helper threads never hold the lock in the first place. The calling thread doesn't take
+	// it back until context creation returns, otherwise it would sit on it while joining the helpers.
+	if (const auto lock = m_PipelineCreationLock; lock && lock->owns_lock())
+		lock->unlock();
+
+	return static_cast<FFInterfaceWrapper *>(backendInterface)
+		->GetUserData()
+		->m_LockedCreatePipeline(backendInterface, effect, pass, permutationOptions, pipelineDescription, effectContextId, outPipeline);
+}
+
+FfxErrorCode FFInterfaceWrapper::RelockedDestroyPipeline(FfxInterface *backendInterface, FfxPipelineState *pipeline, FfxUInt32 effectContextId)
+{
+	// Failed pipeline builds are released with every helper thread already joined
+	if (const auto lock = m_PipelineCreationLock; lock && !lock->owns_lock())
+		lock->lock();
+
+	return static_cast<FFInterfaceWrapper *>(backendInterface)->GetUserData()->m_LockedDestroyPipeline(backendInterface, pipeline, effectContextId);
+}
+
+FfxErrorCode FFInterfaceWrapper::TracedExecuteGpuJobs(FfxInterface *backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
+{
+	TRACE_ZONE("backend", "ExecuteGpuJobs");
+	return static_cast<FFInterfaceWrapper *>(backendInterface)->GetUserData()->m_ExecuteGpuJobs(backendInterface, commandList, effectContextId);
+}
+
+void FFInterfaceWrapper::LogGpuPassTimingsVK(
+	const FfxGpuPassTimingVK *Timings,
+	uint32_t TimingCount,
+	uint32_t DroppedSubmissions,
+	void *UserData)
+{
+	// Rows go to a separate CSV file when requested. The backend calls this from the render thread.
+	const static std::shared_ptr<spdlog::logger> csvLogger = []() -> std::shared_ptr<spdlog::logger>
+	{
+		if (!Config::Get()->GpuPassTimingsCSV)
+			return nullptr;
+
+		const auto fullPath = Util::GetThisDllPath() + L"\\dlssg_to_fsr3_gpu_passes.csv";
+		char convertedPath[2048] = {};
+
+		if (wcstombs_s(nullptr, convertedPath, fullPath.c_str(), std::size(convertedPath)) != 0)
+			return nullptr;
+
+		auto logger = spdlog::basic_logger_mt("gpu_pass_timings", convertedPath, true);
+		logger->set_pattern("%v");
+		logger->info("window,pass,samples,min_ms,avg_ms,max_ms,dropped_submissions");
+
+		return logger;
+	}();
+
+	static uint32_t windowIndex = 0;
+	std::string passes;
+	double totalMilliseconds = 0.0;
+
+	for (uint32_t i = 0; i < TimingCount; i++)
+	{
+		const auto& timing = Timings[i];
+
+		// Pass names are plain ASCII
+		std::string name;
+		for (auto c = timing.name; *c; c++)
+			name += static_cast<char>(*c);
+
+		TRACE_COUNTER("gpu", name, timing.avgMilliseconds);
+		totalMilliseconds += timing.avgMilliseconds;
+
+		if (csvLogger)
+		{
+			csvLogger->info(
+				"{},{},{},{:.4f},{:.4f},{:.4f},{}",
+				windowIndex,
+				name,
+				timing.sampleCount,
+				timing.minMilliseconds,
+				timing.avgMilliseconds,
+				timing.maxMilliseconds,
+				DroppedSubmissions);
+		}
+		else
+		{
+			passes += std::format(
+				"{}\"{}\":{{\"count\":{},\"minMs\":{:.4f},\"avgMs\":{:.4f},\"maxMs\":{:.4f}}}",
+				passes.empty() ? "" : ",",
+				name,
+				timing.sampleCount,
+				timing.minMilliseconds,
+				timing.avgMilliseconds,
+				timing.maxMilliseconds);
+		}
+	}
+
+	LiveMetrics::SetGpuPassMilliseconds(static_cast<float>(totalMilliseconds));
+
+	if (csvLogger)
+		csvLogger->flush();
+	else
+		spdlog::info("gpu_pass_timings {{\"droppedSubmissions\":{},\"passes\":{{{}}}}}", DroppedSubmissions, passes);
+
+	windowIndex++;
 }
 
 FFInterfaceWrapper::UserDataHack *FFInterfaceWrapper::GetUserData()
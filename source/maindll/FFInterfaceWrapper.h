@@ -5,8 +5,14 @@ struct D3D12_RESOURCE_DESC;
 struct ID3D12Device;
 struct ID3D12Resource;
 struct NGXInstanceParameters;
+struct FfxGpuPassTimingVK;
+
+// Same declarations as VK_DEFINE_HANDLE, leaving vulkan.h to the translation units that call into Vulkan
+struct VkDevice_T;
+struct VkPhysicalDevice_T;
+typedef VkDevice_T *VkDevice;
+typedef VkPhysicalDevice_T *VkPhysicalDevice;
 
-#include <vulkan/vulkan.h>
 #include <FidelityFX/host/ffx_interface.h>
 
 class FFInterfaceWrapper : public FfxInterface
@@ -19,8 +25,16 @@ private:
 	{
 		NGXAllocCallback *m_NGXAllocCallback = nullptr;
 		NGXFreeCallback *m_NGXFreeCallback = nullptr;
+		FfxCreatePipelineFunc m_CreatePipeline = nullptr; // Original backend callbacks when tracing
+		FfxExecuteGpuJobsFunc m_ExecuteGpuJobs = nullptr;
+		VkDevice m_PipelineCacheDevice = nullptr; // Set when a VulkanPipelineCache reference is held
+		FfxCreatePipelineFunc m_LockedCreatePipeline = nullptr; // Wrapped by UnlockedCreatePipeline
+		FfxDestroyPipelineFunc m_LockedDestroyPipeline = nullptr; // Wrapped by RelockedDestroyPipeline
+		bool m_Vulkan = false;
 	};
-	static_assert(sizeof(UserDataHack) == 0x10);
+	static_assert(sizeof(UserDataHack) == 0x40);
+
+	static thread_local std::unique_lock<std::mutex> *m_PipelineCreationLock;
 
 public:
 	FFInterfaceWrapper();
@@ -32,6 +46,19 @@ public:
 	FfxErrorCode Initialize(ID3D12Device *Device, uint32_t MaxContexts, NGXInstanceParameters *NGXParameters);
 	FfxErrorCode Initialize(VkDevice Device, VkPhysicalDevice PhysicalDevice, uint32_t MaxContexts, NGXInstanceParameters *NGXParameters);
 
+	void SavePipelineCache();
+
+	// Device memory held by the first MaxContexts effect contexts. Vulkan reports whole memory blocks, including
+	// free space, since that's what the driver actually sees.
+	uint64_t QueryVRAMUsage(uint32_t MaxContexts);
+	void LogMemoryStatistics(const char *Name);
+
+	// Backends build pipelines concurrently with any other call. Lock is released at the first pipeline the calling
+	// thread builds and stays released, helper threads and their joins included, until this is called again with
+	// nullptr. Pipelines are the last thing FFX context creation builds. Only the failure path destroys pipelines
+	// afterwards, and that takes the lock back.
+	static void SetPipelineCreationLock(std::unique_lock<std::mutex> *Lock);
+
 private:
 	UserDataHack *GetUserData();
 
@@ -42,5 +69,32 @@ private:
 		FfxResourceInternal *outTexture);
 
 	static FfxErrorCode CustomDestroyResourceDX12(FfxInterface *backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId);
+
+	void InstallTraceCallbacks();
+	void InstallPipelineCreationCallbacks();
+
+	static FfxErrorCode UnlockedCreatePipeline(
+		FfxInterface *backendInterface,
+		FfxEffect effect,
+		FfxPass pass,
+		uint32_t permutationOptions,
+		const FfxPipelineDescription *pipelineDescription,
+		FfxUInt32 effectContextId,
+		FfxPipelineState *outPipeline);
+
+	static FfxErrorCode RelockedDestroyPipeline(FfxInterface *backendInterface, FfxPipelineState *pipeline, FfxUInt32 effectContextId);
+
+	static FfxErrorCode TracedCreatePipeline(
+		FfxInterface *backendInterface,
+		FfxEffect effect,
+		FfxPass pass,
+		uint32_t permutationOptions,
+		const FfxPipelineDescription *pipelineDescription,
+		FfxUInt32 effectContextId,
+		FfxPipelineState *outPipeline);
+
+	static FfxErrorCode TracedExecuteGpuJobs(FfxInterface *backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+
+	static void LogGpuPassTimingsVK(const FfxGpuPassTimingVK *Timings, uint32_t TimingCount, uint32_t DroppedSubmissions, void *UserData);
 };
 static_assert(sizeof(FFInterfaceWrapper) == sizeof(FfxInterface));
@@ -1,30 +1,42 @@
+#include <algorithm>
 #include <FidelityFX/host/ffx_frameinterpolation.h>
+#include "Config.h"
+#include "FFBackendPool.h"
 #include "FFInterpolator.h"
+#include "TraceRecorder.h"
 
 FFInterpolator::FFInterpolator(
-	const FfxInterface& BackendInterface,
-	const FfxInterface& SharedBackendInterface,
+	FFBackendInterfaces& Backend,
 	FfxUInt32 SharedEffectContextId,
 	uint32_t MaxRenderWidth,
 	uint32_t MaxRenderHeight)
-	: m_BackendInterface(BackendInterface),
-	  m_SharedBackendInterface(SharedBackendInterface),
+	: m_MaxRenderWidth(MaxRenderWidth),
+	  m_MaxRenderHeight(MaxRenderHeight),
+	  m_Backend(Backend),
+	  m_BackendInterface(Backend.FrameInterpolation),
+	  m_SharedBackendInterface(Backend.Shared),
 	  m_SharedEffectContextId(SharedEffectContextId),
-	  m_MaxRenderWidth(MaxRenderWidth),
-	  m_MaxRenderHeight(MaxRenderHeight)
+	  m_MaxCachedContexts(Backend.MaxCachedContexts),
+	  m_CachedContextVRAMBudget(Config::Get()->CachedInterpolationContextVRAMBudget * 1024ull * 1024)
 {
 }
 
 FFInterpolator::~FFInterpolator()
 {
-	DestroyContext();
+	DestroyContexts();
 }
 
 FfxErrorCode FFInterpolator::Dispatch(const FFInterpolatorDispatchParameters& Parameters)
 {
-	if (auto status = CreateContextDeferred(Parameters); status != FFX_OK) // Massive frame hitch on first call
+	if (auto status = CreateContextDeferred(Parameters); status != FFX_OK) // FFX_EOF while the context is still being built
 		return status;
 
+	// A switched context has no history for any interpolated frame of this real frame
+	if (Parameters.PrepareInputs)
+		m_RealFrameContextReset = false;
+
+	m_RealFrameContextReset = m_RealFrameContextReset || std::exchange(m_ContextResetPending, false);
+
 	FfxFrameInterpolationDispatchDescription dispatchDesc = {};
 	{
 		if (Parameters.DebugTearLines)
@@ -33,6 +45,9 @@ FfxErrorCode FFInterpolator::Dispatch(const FFInterpolatorDispatchParameters& Pa
 		if (Parameters.DebugView)
 			dispatchDesc.flags |= FFX_FRAMEINTERPOLATION_DISPATCH_DRAW_DEBUG_VIEW;
 
+		if (!Parameters.StoreInterpolationSource)
+			dispatchDesc.flags |= FFX_FRAMEINTERPOLATION_DISPATCH_SKIP_STORE_INTERPOLATION_SOURCE;
+
 		dispatchDesc.commandList = Parameters.CommandList;
 		dispatchDesc.displaySize = Parameters.OutputSize;
 		dispatchDesc.renderSize = Parameters.RenderSize;
@@ -41,10 +56,7 @@ FfxErrorCode FFInterpolator::Dispatch(const FFInterpolatorDispatchParameters& Pa
 		dispatchDesc.currentBackBuffer_HUDLess = Parameters.InputHUDLessColorBuffer;
 		dispatchDesc.output = Parameters.OutputInterpolatedColorBuffer;
 
-		dispatchDesc.interpolationRect = { 0,
-										   0,
-										   static_cast<int>(dispatchDesc.displaySize.width),
-										   static_cast<int>(dispatchDesc.displaySize.height) };
+		dispatchDesc.interpolationRect = Parameters.InterpolationRect;
 
 		dispatchDesc.opticalFlowVector = Parameters.InputOpticalFlowVector;
 		dispatchDesc.opticalFlowSceneChangeDetection = Parameters.InputOpticalFlowSceneChangeDetection;
@@ -58,7 +70,7 @@ FfxErrorCode FFInterpolator::Dispatch(const FFInterpolatorDispatchParameters& Pa
 		dispatchDesc.viewSpaceToMetersFactor = 1.0f;
 
 		dispatchDesc.frameTimeDelta = 1000.0f / 60.0f; // Unused
-		dispatchDesc.reset = Parameters.Reset;
+		dispatchDesc.reset = Parameters.Reset || m_RealFrameContextReset;
 
 		dispatchDesc.backBufferTransferFunction = Parameters.HDR ? FFX_BACKBUFFER_TRANSFER_FUNCTION_PQ
 																 : FFX_BACKBUFFER_TRANSFER_FUNCTION_SRGB;
@@ -71,6 +83,7 @@ FfxErrorCode FFInterpolator::Dispatch(const FFInterpolatorDispatchParameters& Pa
 		dispatchDesc.dilatedMotionVectors = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_DilatedMotionVectors);
 		dispatchDesc.reconstructedPrevDepth = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_ReconstructedPrevDepth);
 		dispatchDesc.distortionField = Parameters.InputDistortionField;
+		dispatchDesc.interpolationFactor = Parameters.InterpolationFactor;
 	}
 
 	FfxFrameInterpolationPrepareDescription prepareDesc = {};
@@ -97,13 +110,147 @@ FfxErrorCode FFInterpolator::Dispatch(const FFInterpolatorDispatchParameters& Pa
 		prepareDesc.reconstructedPrevDepth = m_SharedBackendInterface.fpGetResource(&m_SharedBackendInterface, *m_ReconstructedPrevDepth);
 	}
 
-	if (auto status = ffxFrameInterpolationPrepare(&m_FSRContext.value(), &prepareDesc); status != FFX_OK)
-		return status;
+	if (Parameters.PrepareInputs)
+	{
+		m_PreparedInputsValid = false;
+
+		if (auto status = ffxFrameInterpolationPrepare(&m_ContextCache.front().Context, &prepareDesc); status != FFX_OK)
+			return status;
+
+		m_PreparedInputsValid = true;
+	}
+	else if (!m_PreparedInputsValid)
+	{
+		return FFX_EOF; // Context was recreated mid-frame. Nothing to interpolate from.
+	}
 
-	return ffxFrameInterpolationDispatch(&m_FSRContext.value(), &dispatchDesc);
+	return ffxFrameInterpolationDispatch(&m_ContextCache.front().Context, &dispatchDesc);
 }
 
 FfxErrorCode FFInterpolator::CreateContextDeferred(const FFInterpolatorDispatchParameters& Parameters)
+{
+	if (m_PendingContextCreation.valid())
+	{
+		if (IsContextCreationPending())
+			return FFX_EOF; // Still compiling pipelines on the worker thread
+
+		if (auto status = m_PendingContextCreation.get(); status != FFX_OK)
+		{
+			spdlog::error("Failed to create a frame interpolation context: {:X}. It won't be retried.", static_cast<uint32_t>(status));
+
+			m_FailedContexts.emplace_back(m_ContextCache.front().Description, status);
+			m_ContextCache.pop_front();
+			return status;
+		}
+
+		auto& entry = m_ContextCache.front();
+
+		if (FfxEffectMemoryUsage usage = {}; ffxFrameInterpolationContextGetGpuMemoryUsage(&entry.Context, &usage) == FFX_OK)
+			entry.VRAMUsage = usage.totalUsageInBytes;
+
+		if (!m_DilatedDepth)
+		{
+			if (auto status = CreateSharedResources(); status != FFX_OK)
+			{
+				DestroyContexts();
+				return status;
+			}
+		}
+
+		m_Backend.FrameInterpolation.LogMemoryStatistics("Frame interpolation");
+		m_Backend.Shared.LogMemoryStatistics("Shared");
+
+		// Older contexts may still be in use by the GPU. Release them after a flush.
+		if (IsContextCacheOverBudget())
+		{
+			m_ContextFlushPending = true;
+			return FFX_EOF;
+		}
+	}
+
+	if (std::exchange(m_ContextFlushPending, false))
+		TrimContextCache();
+
+	const auto desc = BuildContextDescription(Parameters);
+
+	if (!m_ContextCache.empty() && memcmp(&desc, &m_ContextCache.front().Description, sizeof(desc)) == 0)
+		return FFX_OK;
+
+	// Switching to a cached context is free, but its history is stale
+	for (auto itr = m_ContextCache.begin(); itr != m_ContextCache.end(); itr++)
+	{
+		if (memcmp(&desc, &itr->Description, sizeof(desc)) != 0)
+			continue;
+
+		m_ContextCache.splice(m_ContextCache.begin(), m_ContextCache, itr);
+		m_ContextResetPending = true;
+
+		return FFX_OK;
+	}
+
+	// Same inputs, same failure
+	for (auto& failed : m_FailedContexts)
+	{
+		if (memcmp(&desc, &failed.Description, sizeof(desc)) == 0)
+			return failed.Status;
+	}
+
+	CreateContextAsync(desc);
+	return FFX_EOF;
+}
+
+void FFInterpolator::CreateContextAsync(const FFInterpolatorDispatchParameters& PredictedParameters)
+{
+	if (!m_ContextCache.empty() || m_PendingContextCreation.valid())
+		return;
+
+	CreateContextAsync(BuildContextDescription(PredictedParameters));
+}
+
+bool FFInterpolator::IsContextCreationPending() const
+{
+	return m_PendingContextCreation.valid() &&
+		   m_PendingContextCreation.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+}
+
+void FFInterpolator::WaitForContextCreation() const
+{
+	if (m_PendingContextCreation.valid())
+		m_PendingContextCreation.wait();
+}
+
+void FFInterpolator::CreateContextAsync(const FfxFrameInterpolationContextDescription& Description)
+{
+	// Pipeline creation takes hundreds of milliseconds. The worker only holds the backend lock for resource and effect
+	// context setup, so other features sharing the backend keep interpolating in the meantime.
+	auto& entry = m_ContextCache.emplace_front();
+	entry.Description = Description;
+
+	m_PendingContextCreation = std::async(
+		std::launch::async,
+		[&entry, &backend = m_Backend]()
+		{
+			FfxErrorCode status;
+
+			{
+				std::unique_lock lock(backend.Mutex);
+				TRACE_ZONE("context", "CreateFrameInterpolationContext");
+
+				FFInterfaceWrapper::SetPipelineCreationLock(&lock);
+				status = ffxFrameInterpolationContextCreate(&entry.Context, &entry.Description);
+				FFInterfaceWrapper::SetPipelineCreationLock(nullptr);
+			}
+
+			// Outside the lock so dispatches don't wait on the disk. Covers optical flow pipelines as well since the
+			// cache is per device.
+			if (status == FFX_OK)
+				backend.FrameInterpolation.SavePipelineCache();
+
+			return status;
+		});
+}
+
+FfxFrameInterpolationContextDescription FFInterpolator::BuildContextDescription(const FFInterpolatorDispatchParameters& Parameters) const
 {
 	FfxFrameInterpolationContextDescription desc = {};
 	desc.backendInterface = m_BackendInterface;
@@ -135,35 +282,16 @@ FfxErrorCode FFInterpolator::CreateContextDeferred(const FFInterpolatorDispatchP
 	if (Parameters.InputHUDLessColorBuffer.resource)
 		desc.previousInterpolationSourceFormat = Parameters.InputHUDLessColorBuffer.description.format;
 
-	if (std::exchange(m_ContextFlushPending, false))
-		DestroyContext();
-
-	if (m_FSRContext)
-	{
-		if (memcmp(&desc, &m_ContextDescription, sizeof(m_ContextDescription)) == 0)
-			return FFX_OK;
-
-		m_ContextFlushPending = true;
-		return FFX_EOF; // Description changed. Return fake status to request a flush from our parent.
-	}
-
-	m_ContextDescription = desc;
-	auto status = ffxFrameInterpolationContextCreate(&m_FSRContext.emplace(), &m_ContextDescription);
-
-	if (status != FFX_OK)
-	{
-		m_FSRContext.reset();
-		return status;
-	}
+	return desc;
+}
 
+FfxErrorCode FFInterpolator::CreateSharedResources()
+{
 	FfxFrameInterpolationSharedResourceDescriptions fsrFiSharedDescriptions = {};
-	status = ffxFrameInterpolationGetSharedResourceDescriptions(&m_FSRContext.value(), &fsrFiSharedDescriptions);
+	auto status = ffxFrameInterpolationGetSharedResourceDescriptions(&m_ContextCache.front().Context, &fsrFiSharedDescriptions);
 
 	if (status != FFX_OK)
-	{
-		DestroyContext();
 		return status;
-	}
 
 	status = m_SharedBackendInterface.fpCreateResource(
 		&m_SharedBackendInterface,
@@ -174,8 +302,6 @@ FfxErrorCode FFInterpolator::CreateContextDeferred(const FFInterpolatorDispatchP
 	if (status != FFX_OK)
 	{
 		m_DilatedDepth.reset();
-		DestroyContext();
-
 		return status;
 	}
 
@@ -188,8 +314,6 @@ FfxErrorCode FFInterpolator::CreateContextDeferred(const FFInterpolatorDispatchP
 	if (status != FFX_OK)
 	{
 		m_DilatedMotionVectors.reset();
-		DestroyContext();
-
 		return status;
 	}
 
@@ -202,18 +326,44 @@ FfxErrorCode FFInterpolator::CreateContextDeferred(const FFInterpolatorDispatchP
 	if (status != FFX_OK)
 	{
 		m_ReconstructedPrevDepth.reset();
-		DestroyContext();
-
 		return status;
 	}
 
 	return FFX_OK;
 }
 
-void FFInterpolator::DestroyContext()
+bool FFInterpolator::IsContextCacheOverBudget() const
+{
+	uint64_t totalVRAMUsage = 0;
+
+	for (auto& entry : m_ContextCache)
+		totalVRAMUsage += entry.VRAMUsage;
+
+	return m_ContextCache.size() > m_MaxCachedContexts || totalVRAMUsage > m_CachedContextVRAMBudget;
+}
+
+uint32_t FFInterpolator::GetMaxCachedContexts(const Configuration& Config)
 {
-	if (m_FSRContext)
-		ffxFrameInterpolationContextDestroy(&m_FSRContext.value());
+	return std::clamp(Config.MaxCachedInterpolationContexts, 1u, MaxCachedContextsLimit);
+}
+
+void FFInterpolator::TrimContextCache()
+{
+	// The active context is always kept regardless of budget
+	while (m_ContextCache.size() > 1 && IsContextCacheOverBudget())
+	{
+		ffxFrameInterpolationContextDestroy(&m_ContextCache.back().Context);
+		m_ContextCache.pop_back();
+	}
+}
+
+void FFInterpolator::DestroyContexts()
+{
+	if (m_PendingContextCreation.valid() && m_PendingContextCreation.get() != FFX_OK)
+		m_ContextCache.pop_front();
+
+	for (auto& entry : m_ContextCache)
+		ffxFrameInterpolationContextDestroy(&entry.Context);
 
 	if (m_DilatedDepth)
 		m_SharedBackendInterface.fpDestroyResource(&m_SharedBackendInterface, *m_DilatedDepth, m_SharedEffectContextId);
@@ -224,7 +374,8 @@ void FFInterpolator::DestroyContext()
 	if (m_ReconstructedPrevDepth)
 		m_SharedBackendInterface.fpDestroyResource(&m_SharedBackendInterface, *m_ReconstructedPrevDepth, m_SharedEffectContextId);
 
-	m_FSRContext.reset();
+	m_ContextCache.clear();
+	m_PreparedInputsValid = false;
 	m_DilatedDepth.reset();
 	m_DilatedMotionVectors.reset();
 	m_ReconstructedPrevDepth.reset();
@@ -2,12 +2,16 @@
 
 #include <FidelityFX/host/ffx_frameinterpolation.h>
 
+struct Configuration;
+struct FFBackendInterfaces;
+
 struct FFInterpolatorDispatchParameters
 {
 	FfxCommandList CommandList;
 
     FfxDimensions2D RenderSize;
 	FfxDimensions2D OutputSize;
+	FfxRect2D InterpolationRect; // Area of OutputSize containing the game image. Excludes letterboxing.
 
     FfxResource InputColorBuffer;
     FfxResource InputHUDLessColorBuffer;
@@ -40,21 +44,51 @@ struct FFInterpolatorDispatchParameters
 	float CameraFar;
 	float CameraFovAngleVertical;
 	FfxFloatCoords2D MinMaxLuminance;
+
+	float InterpolationFactor;		// Generated frame position between the previous (0) and current (1) frame
+	bool PrepareInputs;				// False when reusing dilated depth and motion vectors from an earlier dispatch this frame
+	bool StoreInterpolationSource;	// False when more frames will be generated from the same source frames
 };
 
 class FFInterpolator
 {
+public:
+	constexpr static uint32_t MaxCachedContextsLimit = 8;
+
+	// MaxCachedInterpolationContexts clamped to what the backend pool can hold
+	static uint32_t GetMaxCachedContexts(const Configuration& Config);
+
 private:
+	struct CachedContext
+	{
+		FfxFrameInterpolationContextDescription Description = {};
+		FfxFrameInterpolationContext Context = {};
+		uint64_t VRAMUsage = 0;
+	};
+
+	struct FailedContext
+	{
+		FfxFrameInterpolationContextDescription Description = {};
+		FfxErrorCode Status = FFX_OK;
+	};
+
 	const uint32_t m_MaxRenderWidth;
 	const uint32_t m_MaxRenderHeight;
 
+	FFBackendInterfaces& m_Backend;
 	const FfxInterface m_BackendInterface;
 	FfxInterface m_SharedBackendInterface;
 	FfxUInt32 m_SharedEffectContextId = {};
+	const uint32_t m_MaxCachedContexts;
+	const uint64_t m_CachedContextVRAMBudget;
 
-	FfxFrameInterpolationContextDescription m_ContextDescription = {};
-	std::optional<FfxFrameInterpolationContext> m_FSRContext;
+	std::list<CachedContext> m_ContextCache; // Most recently used first. Front is the active context.
 	bool m_ContextFlushPending = false;
+	bool m_ContextResetPending = false;
+	bool m_RealFrameContextReset = false; // Set by a cache switch until inputs are prepared for the next real frame
+	bool m_PreparedInputsValid = false;
+	std::future<FfxErrorCode> m_PendingContextCreation;
+	std::vector<FailedContext> m_FailedContexts; // Never retried
 
 	std::optional<FfxResourceInternal> m_DilatedDepth;
 	std::optional<FfxResourceInternal> m_DilatedMotionVectors;
@@ -62,8 +96,7 @@ private:
 
 public:
 	FFInterpolator(
-		const FfxInterface& BackendInterface,
-		const FfxInterface& SharedBackendInterface,
+		FFBackendInterfaces& Backend,
 		FfxUInt32 SharedEffectContextId,
 		uint32_t MaxRenderWidth,
 		uint32_t MaxRenderHeight);
@@ -72,8 +105,16 @@ public:
 	~FFInterpolator();
 
 	FfxErrorCode Dispatch(const FFInterpolatorDispatchParameters& Parameters);
+	FfxErrorCode CreateContextDeferred(const FFInterpolatorDispatchParameters& Parameters);
+	void CreateContextAsync(const FFInterpolatorDispatchParameters& PredictedParameters);
+	bool IsContextCreationPending() const;
+	void WaitForContextCreation() const;
 
 private:
-	FfxErrorCode CreateContextDeferred(const FFInterpolatorDispatchParameters& Parameters);
-	void DestroyContext();
+	void CreateContextAsync(const FfxFrameInterpolationContextDescription& Description);
+	FfxFrameInterpolationContextDescription BuildContextDescription(const FFInterpolatorDispatchParameters& Parameters) const;
+	FfxErrorCode CreateSharedResources();
+	bool IsContextCacheOverBudget() const;
+	void TrimContextCache();
+	void DestroyContexts();
 };
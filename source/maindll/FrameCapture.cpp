@@ -0,0 +1,324 @@
+#include <FidelityFX/host/ffx_util.h>
+#include <lz4.h>
+#include "FrameCapture.h"
+#include "TraceRecorder.h"
+#include "VRAMEstimator.h"
+
+FrameCapture::FrameCapture(const std::filesystem::path& Path, uint32_t FrameCount) : m_FrameCount(FrameCount)
+{
+	m_File.open(Path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+	if (!m_File)
+	{
+		spdlog::error("Failed to open {} for frame capture.", Path.filename().string());
+		m_FrameCount = 0;
+
+		return;
+	}
+
+	// Patched with the frame count and index location once the capture completes
+	FileHeader header = {};
+	memcpy(header.Magic, FileMagic, sizeof(header.Magic));
+	header.Version = FileVersion;
+
+	m_File.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	m_FileOffset = sizeof(header);
+
+	spdlog::info("Capturing {} frames to {}.", m_FrameCount, Path.filename().string());
+	m_WriterThread = std::thread(&FrameCapture::WriterThread, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+	StopWriterThread();
+}
+
+FrameCapture::Slot *FrameCapture::BeginFrame(
+	const DLSSGFrameInputs& Inputs,
+	const std::array<const FfxResource *, TextureCount>& Textures)
+{
+	if (m_RecordedFrames >= m_FrameCount)
+		return nullptr;
+
+	const auto sourceFrameIndex = m_SourceFrames++;
+
+	auto slot = std::ranges::find_if(
+		m_Slots,
+		[](const Slot& Frame) { return Frame.Status.load(std::memory_order_acquire) == Slot::State::Free; });
+
+	if (slot == m_Slots.end())
+	{
+		m_DroppedFrames++;
+		return nullptr;
+	}
+
+	auto& record = slot->Record;
+	record = {};
+	record.FrameIndex = m_RecordedFrames;
+	record.SourceFrameIndex = sourceFrameIndex;
+	record.Flags = (Inputs.EnableInterp ? FrameFlagEnableInterp : 0) |
+		(Inputs.Reset ? FrameFlagReset : 0) |
+		(Inputs.HDR ? FrameFlagHDR : 0) |
+		(Inputs.MvecJittered ? FrameFlagMvecJittered : 0) |
+		(Inputs.MvecDilated ? FrameFlagMvecDilated : 0) |
+		(Inputs.DistortionFieldLowPrecision ? FrameFlagDistortionFieldLowPrecision : 0) |
+		(Inputs.Camera.OrthoProjection ? FrameFlagOrthoProjection : 0) |
+		(Inputs.Camera.DepthInverted ? FrameFlagDepthInverted : 0) |
+		(Inputs.Camera.ViewToClipValid ? FrameFlagViewToClipValid : 0);
+	record.MultiFrameCount = Inputs.MultiFrameCount;
+	record.DepthSubrect[0] = Inputs.DepthSubrect.width;
+	record.DepthSubrect[1] = Inputs.DepthSubrect.height;
+	record.HUDLessSubrectBase[0] = Inputs.HUDLessSubrectBase.x;
+	record.HUDLessSubrectBase[1] = Inputs.HUDLessSubrectBase.y;
+	record.HUDLessSubrect[0] = Inputs.HUDLessSubrect.width;
+	record.HUDLessSubrect[1] = Inputs.HUDLessSubrect.height;
+	record.MVecsSubrect[0] = Inputs.MVecsSubrect.width;
+	record.MVecsSubrect[1] = Inputs.MVecsSubrect.height;
+	record.MvecScale[0] = Inputs.MvecScale.x;
+	record.MvecScale[1] = Inputs.MvecScale.y;
+	record.JitterOffset[0] = Inputs.JitterOffset.x;
+	record.JitterOffset[1] = Inputs.JitterOffset.y;
+	memcpy(record.ViewToClip, Inputs.Camera.ViewToClip, sizeof(record.ViewToClip));
+	record.FOV = Inputs.Camera.FOV;
+	record.Near = Inputs.Camera.Near;
+	record.Far = Inputs.Camera.Far;
+	record.HostTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_StartTime).count();
+
+	// Textures are packed back to back with copy alignment rules that satisfy both D3D12 and Vulkan. The marker
+	// stays at a fixed offset so a stale value left by earlier, differently sized frames can't be mistaken for it.
+	uint64_t offset = TextureOffsetAlignment;
+
+	for (uint32_t i = 0; i < TextureCount; i++)
+	{
+		const auto texture = Textures[i];
+		slot->Layouts[i] = {};
+
+		if (!texture || !texture->resource || texture->description.type != FFX_RESOURCE_TYPE_TEXTURE2D ||
+			texture->description.format == FFX_SURFACE_FORMAT_UNKNOWN)
+			continue;
+
+		const auto& description = texture->description;
+		const auto texelSize = VRAMEstimator::GetSurfaceFormatSize(description.format);
+		const auto rowPitch = FFX_ALIGN_UP(description.width * texelSize, RowPitchAlignment);
+
+		// Vulkan addresses buffer rows in texels
+		if (rowPitch % texelSize != 0)
+			continue;
+
+		slot->Layouts[i] = {
+			.Offset = offset,
+			.RowPitch = rowPitch,
+			.RowCount = description.height,
+		};
+
+		record.Textures[i] = {
+			.Format = static_cast<uint32_t>(description.format),
+			.Width = description.width,
+			.Height = description.height,
+			.RowPitch = rowPitch,
+		};
+
+		offset = FFX_ALIGN_UP(offset + static_cast<uint64_t>(rowPitch) * description.height, TextureOffsetAlignment);
+	}
+
+	slot->Serial = m_NextSerial++;
+	slot->RequiredSize = offset;
+	slot->Status.store(Slot::State::Recording, std::memory_order_relaxed);
+
+	return &*slot;
+}
+
+void FrameCapture::SubmitFrame(Slot *Frame)
+{
+	m_RecordedFrames++;
+
+	{
+		std::scoped_lock lock(m_Mutex);
+		Frame->Status.store(Slot::State::Submitted, std::memory_order_release);
+	}
+
+	m_WorkAvailable.notify_one();
+}
+
+void FrameCapture::CancelFrame(Slot *Frame)
+{
+	Frame->Status.store(Slot::State::Free, std::memory_order_release);
+}
+
+void FrameCapture::Stop(const std::function<void(const ReadbackBuffer&)>& DestroyReadbackBuffer)
+{
+	StopWriterThread();
+
+	for (auto& slot : m_Slots)
+	{
+		if (slot.Buffer.Handle)
+			DestroyReadbackBuffer(slot.Buffer);
+
+		slot.Buffer = {};
+		slot.Status.store(Slot::State::Free, std::memory_order_relaxed);
+	}
+}
+
+void FrameCapture::StopWriterThread()
+{
+	if (m_WriterThread.joinable())
+	{
+		{
+			std::scoped_lock lock(m_Mutex);
+			m_StopRequested = true;
+		}
+
+		m_WorkAvailable.notify_one();
+		m_WriterThread.join();
+	}
+
+	// Frames still in flight are abandoned. Everything already written stays readable.
+	if (m_File.is_open())
+		Finalize();
+}
+
+void FrameCapture::WriterThread()
+{
+	while (true)
+	{
+		Slot *frame = nullptr;
+
+		{
+			std::unique_lock lock(m_Mutex);
+			m_WorkAvailable.wait(lock, [&]() { return m_StopRequested || (frame = FindOldestSubmittedSlot()) != nullptr; });
+
+			if (m_StopRequested)
+				return;
+		}
+
+		// Copies complete in submission order. Nothing else is ready until the oldest frame's marker lands.
+		const auto marker = reinterpret_cast<const volatile uint32_t *>(frame->Buffer.Data + MarkerOffset);
+
+		if (*marker != frame->Serial)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		WriteFrame(*frame);
+		frame->Status.store(Slot::State::Free, std::memory_order_release);
+
+		if (++m_WrittenFrames >= m_FrameCount)
+		{
+			Finalize();
+			return;
+		}
+	}
+}
+
+FrameCapture::Slot *FrameCapture::FindOldestSubmittedSlot()
+{
+	Slot *oldest = nullptr;
+
+	for (auto& slot : m_Slots)
+	{
+		if (slot.Status.load(std::memory_order_acquire) != Slot::State::Submitted)
+			continue;
+
+		if (!oldest || slot.Record.FrameIndex < oldest->Record.FrameIndex)
+			oldest = &slot;
+	}
+
+	return oldest;
+}
+
+void FrameCapture::WriteFrame(const Slot& Frame)
+{
+	TRACE_ZONE("capture", "WriteFrame");
+
+	const auto& record = Frame.Record;
+	WriteChunk(ChunkType::Frame, record.FrameIndex, 0, std::as_bytes(std::span(&record, 1)), sizeof(record));
+
+	for (uint32_t i = 0; i < TextureCount; i++)
+	{
+		const auto& layout = Frame.Layouts[i];
+
+		if (layout.RowPitch == 0)
+			continue;
+
+		const std::span source(Frame.Buffer.Data + layout.Offset, static_cast<size_t>(layout.RowPitch) * layout.RowCount);
+		m_CompressedData.clear();
+
+		for (size_t blockOffset = 0; blockOffset < source.size(); blockOffset += BlockSize)
+		{
+			const auto block = source.subspan(blockOffset, std::min<size_t>(BlockSize, source.size() - blockOffset));
+			const auto blockStart = m_CompressedData.size();
+
+			m_CompressedData.resize(blockStart + sizeof(uint32_t) + LZ4_compressBound(static_cast<int>(block.size())));
+
+			auto blockData = m_CompressedData.data() + blockStart + sizeof(uint32_t);
+			auto blockHeader = static_cast<uint32_t>(LZ4_compress_default(
+				reinterpret_cast<const char *>(block.data()),
+				reinterpret_cast<char *>(blockData),
+				static_cast<int>(block.size()),
+				static_cast<int>(m_CompressedData.size() - blockStart - sizeof(uint32_t))));
+
+			// Zero on failure. Incompressible blocks are stored as is.
+			if (blockHeader == 0 || blockHeader >= block.size())
+			{
+				memcpy(blockData, block.data(), block.size());
+				blockHeader = static_cast<uint32_t>(block.size()) | BlockUncompressedFlag;
+			}
+
+			memcpy(m_CompressedData.data() + blockStart, &blockHeader, sizeof(blockHeader));
+			m_CompressedData.resize(blockStart + sizeof(uint32_t) + (blockHeader & ~BlockUncompressedFlag));
+		}
+
+		WriteChunk(ChunkType::Texture, record.FrameIndex, i, std::as_bytes(std::span(m_CompressedData)), source.size());
+	}
+
+	m_File.flush();
+}
+
+void FrameCapture::WriteChunk(
+	ChunkType Type,
+	uint32_t FrameIndex,
+	uint32_t TextureIndex,
+	std::span<const std::byte> Payload,
+	uint64_t RawSize)
+{
+	const ChunkHeader header = {
+		.Type = Type,
+		.FrameIndex = FrameIndex,
+		.TextureIndex = TextureIndex,
+		.StoredSize = Payload.size(),
+		.RawSize = RawSize,
+	};
+
+	m_Index.push_back({ .Offset = m_FileOffset, .Type = Type, .FrameIndex = FrameIndex });
+
+	const std::array<char, ChunkAlignment> padding = {};
+	const auto paddingSize = FFX_ALIGN_UP(Payload.size(), ChunkAlignment) - Payload.size();
+
+	m_File.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	m_File.write(reinterpret_cast<const char *>(Payload.data()), Payload.size());
+	m_File.write(padding.data(), paddingSize);
+
+	m_FileOffset += sizeof(header) + Payload.size() + paddingSize;
+}
+
+void FrameCapture::Finalize()
+{
+	FileHeader header = {};
+	memcpy(header.Magic, FileMagic, sizeof(header.Magic));
+	header.Version = FileVersion;
+	header.FrameCount = m_WrittenFrames;
+	header.IndexOffset = m_FileOffset;
+	header.IndexCount = m_Index.size();
+
+	m_File.write(reinterpret_cast<const char *>(m_Index.data()), m_Index.size() * sizeof(IndexEntry));
+	m_File.seekp(0);
+	m_File.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	m_File.close();
+
+	if (m_File.fail())
+		spdlog::error("Frame capture failed to write to disk.");
+	else
+		spdlog::info("Frame capture complete. {} frames written, {} dropped.", m_WrittenFrames, m_DroppedFrames.load());
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include "DLSSGFrameInputs.h"
+
+// Records frame generation inputs for offline replay. DLSSG parameters and the Backbuffer, HUDLess, Depth and MVecs
+// textures are copied into a ring of persistently mapped readback buffers on the frame's own command list. The GPU
+// writes a marker after the copies, and a writer thread picks up slots whose marker arrived, compresses them and
+// appends them to a capture file. The render thread never waits on the GPU or the disk. Frames are dropped and
+// counted when every slot is still in flight.
+class FrameCapture
+{
+public:
+	constexpr static uint32_t RingSize = 4;
+	constexpr static uint32_t TextureCount = 4; // Backbuffer, HUDLess, Depth, MVecs
+	constexpr static uint32_t RowPitchAlignment = 256; // D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+	constexpr static uint64_t TextureOffsetAlignment = 512; // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+	constexpr static uint64_t MarkerOffset = 0; // Textures follow at TextureOffsetAlignment
+
+	//
+	// File layout. All fields are little endian and every chunk starts on a ChunkAlignment boundary, so the file can
+	// be mapped and chunks addressed in place. The index is written when the capture completes. A file without one
+	// can still be walked chunk by chunk starting after the header.
+	//
+	// Texture chunks hold the texture's rows at TextureRecord::RowPitch. The payload is a sequence of LZ4 blocks
+	// that decompress to at most BlockSize bytes each, each preceded by a uint32_t size. The high bit of the size
+	// marks a block that's stored uncompressed, same as the LZ4 frame format.
+	//
+	constexpr static char FileMagic[8] = { 'D', 'L', 'S', 'S', 'G', 'C', 'A', 'P' };
+	constexpr static uint32_t FileVersion = 1;
+	constexpr static uint64_t ChunkAlignment = 16;
+	constexpr static uint32_t BlockSize = 4 * 1024 * 1024;
+	constexpr static uint32_t BlockUncompressedFlag = 0x80000000;
+
+	enum class ChunkType : uint32_t
+	{
+		Frame = 1,	 // FrameRecord
+		Texture = 2, // Compressed texture rows
+	};
+
+	// FrameRecord::Flags
+	constexpr static uint32_t FrameFlagEnableInterp = 1 << 0;
+	constexpr static uint32_t FrameFlagReset = 1 << 1;
+	constexpr static uint32_t FrameFlagHDR = 1 << 2;
+	constexpr static uint32_t FrameFlagMvecJittered = 1 << 3;
+	constexpr static uint32_t FrameFlagMvecDilated = 1 << 4;
+	constexpr static uint32_t FrameFlagDistortionFieldLowPrecision = 1 << 5;
+	constexpr static uint32_t FrameFlagOrthoProjection = 1 << 6;
+	constexpr static uint32_t FrameFlagDepthInverted = 1 << 7;
+	constexpr static uint32_t FrameFlagViewToClipValid = 1 << 8;
+
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t FrameCount;
+		uint64_t IndexOffset; // Zero until the capture completes
+		uint64_t IndexCount;
+	};
+
+	struct ChunkHeader
+	{
+		ChunkType Type;
+		uint32_t FrameIndex;
+		uint32_t TextureIndex; // Texture chunks only
+		uint32_t Reserved;
+		uint64_t StoredSize; // Payload bytes following this header
+		uint64_t RawSize;	 // Payload bytes after decompression
+	};
+
+	struct IndexEntry
+	{
+		uint64_t Offset; // Of the chunk header
+		ChunkType Type;
+		uint32_t FrameIndex;
+	};
+
+	struct TextureRecord
+	{
+		uint32_t Format; // FfxSurfaceFormat
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t RowPitch; // Zero when the texture wasn't bound or couldn't be read back
+	};
+
+	struct FrameRecord
+	{
+		uint32_t FrameIndex;
+		uint32_t SourceFrameIndex; // Counts dropped frames too. Gaps mean temporal history has to be reset.
+		uint32_t Flags;
+		uint32_t MultiFrameCount;
+		uint32_t DepthSubrect[2];
+		int32_t HUDLessSubrectBase[2];
+		uint32_t HUDLessSubrect[2];
+		uint32_t MVecsSubrect[2];
+		float MvecScale[2];
+		float JitterOffset[2];
+		float ViewToClip[4][4];
+		float FOV;
+		float Near;
+		float Far;
+		uint32_t Reserved[3];
+		double HostTime; // Seconds since the capture started
+		TextureRecord Textures[TextureCount];
+	};
+
+	static_assert(sizeof(FileHeader) % ChunkAlignment == 0);
+	static_assert(sizeof(ChunkHeader) % ChunkAlignment == 0);
+	static_assert(sizeof(FrameRecord) % ChunkAlignment == 0);
+
+	// Backend buffer in host-visible memory. Created and destroyed by the API-specific frame interpolator, which
+	// zeroes the marker on creation.
+	struct ReadbackBuffer
+	{
+		void *Handle = nullptr;
+		void *Memory = nullptr; // Backend memory object, if separate from the buffer
+		const uint8_t *Data = nullptr;
+		uint64_t Size = 0;
+	};
+
+	struct TextureLayout
+	{
+		uint64_t Offset = 0;
+		uint32_t RowPitch = 0;
+		uint32_t RowCount = 0;
+	};
+
+	struct Slot
+	{
+		enum class State : uint32_t
+		{
+			Free,
+			Recording, // Owned by the render thread
+			Submitted, // Owned by the writer thread, waiting on the GPU marker
+		};
+
+		std::atomic<State> Status = State::Free;
+		ReadbackBuffer Buffer;
+		uint32_t Serial = 0;
+		uint64_t RequiredSize = 0;
+		std::array<TextureLayout, TextureCount> Layouts;
+		FrameRecord Record = {};
+	};
+
+private:
+	uint32_t m_FrameCount;
+	const std::chrono::steady_clock::time_point m_StartTime = std::chrono::steady_clock::now();
+
+	std::array<Slot, RingSize> m_Slots;
+	uint32_t m_NextSerial = 1;
+	uint32_t m_RecordedFrames = 0;
+	uint32_t m_SourceFrames = 0;
+	std::atomic<uint32_t> m_DroppedFrames = 0;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkAvailable;
+	bool m_StopRequested = false;
+	std::thread m_WriterThread;
+
+	std::ofstream m_File;
+	uint64_t m_FileOffset = 0;
+	uint32_t m_WrittenFrames = 0;
+	std::vector<IndexEntry> m_Index;
+	std::vector<uint8_t> m_CompressedData;
+
+public:
+	FrameCapture(const std::filesystem::path& Path, uint32_t FrameCount);
+	FrameCapture(const FrameCapture&) = delete;
+	FrameCapture& operator=(const FrameCapture&) = delete;
+	~FrameCapture();
+
+	// Returns a slot to record into, or nullptr when the capture is complete or the ring is full. Textures are given in
+	// TextureCount order and may be null. Readback buffers smaller than RequiredSize must be recreated by the caller.
+	Slot *BeginFrame(const DLSSGFrameInputs& Inputs, const std::array<const FfxResource *, TextureCount>& Textures);
+	void SubmitFrame(Slot *Frame);
+	void CancelFrame(Slot *Frame);
+
+	// Stops the writer thread. Pending slots are abandoned. The callback receives every readback buffer so the
+	// caller can release it.
+	void Stop(const std::function<void(const ReadbackBuffer&)>& DestroyReadbackBuffer);
+
+private:
+	void StopWriterThread();
+	void WriterThread();
+	Slot *FindOldestSubmittedSlot();
+	void WriteFrame(const Slot& Frame);
+	void WriteChunk(ChunkType Type, uint32_t FrameIndex, uint32_t TextureIndex, std::span<const std::byte> Payload, uint64_t RawSize);
+	void Finalize();
+};
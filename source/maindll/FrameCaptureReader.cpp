@@ -0,0 +1,219 @@
+#include <FidelityFX/host/ffx_util.h>
+#include <lz4.h>
+#include "FrameCaptureReader.h"
+
+FrameCaptureReader::FrameCaptureReader(const std::filesystem::path& Path)
+{
+	m_File.open(Path, std::ios::in | std::ios::binary);
+
+	if (!m_File)
+		throw std::runtime_error("Failed to open " + Path.string() + ".");
+
+	m_File.seekg(0, std::ios::end);
+	m_FileSize = static_cast<uint64_t>(m_File.tellg());
+
+	FrameCapture::FileHeader header = {};
+	ReadAt(0, &header, sizeof(header));
+
+	if (memcmp(header.Magic, FrameCapture::FileMagic, sizeof(header.Magic)) != 0)
+		throw std::runtime_error("Not a frame capture file.");
+
+	if (header.Version != FrameCapture::FileVersion)
+		throw std::runtime_error("Unsupported frame capture version " + std::to_string(header.Version) + ".");
+
+	m_HasIndex = LoadIndex(header);
+
+	if (!m_HasIndex)
+	{
+		m_Frames.clear();
+		WalkChunks();
+	}
+}
+
+uint32_t FrameCaptureReader::GetFrameCount() const
+{
+	return static_cast<uint32_t>(m_Frames.size());
+}
+
+bool FrameCaptureReader::HasIndex() const
+{
+	return m_HasIndex;
+}
+
+FrameCapture::FrameRecord FrameCaptureReader::ReadRecord(uint32_t Index)
+{
+	if (Index >= m_Frames.size())
+		throw std::out_of_range("Frame " + std::to_string(Index) + " is not in the capture.");
+
+	FrameCapture::FrameRecord record = {};
+	ReadAt(m_Frames[Index].RecordOffset + sizeof(FrameCapture::ChunkHeader), &record, sizeof(record));
+
+	return record;
+}
+
+FrameCaptureReader::Frame FrameCaptureReader::ReadFrame(uint32_t Index)
+{
+	Frame frame;
+	frame.Record = ReadRecord(Index);
+
+	const auto& chunks = m_Frames[Index];
+
+	for (uint32_t i = 0; i < FrameCapture::TextureCount; i++)
+	{
+		const auto& texture = frame.Record.Textures[i];
+
+		// Textures of the last frame of an unfinished capture may be missing
+		if (texture.RowPitch == 0 || chunks.TextureOffsets[i] == 0)
+			continue;
+
+		const auto header = ReadChunkHeader(chunks.TextureOffsets[i]);
+
+		if (header.RawSize != static_cast<uint64_t>(texture.RowPitch) * texture.Height)
+			throw std::runtime_error("Texture " + std::to_string(i) + " of frame " + std::to_string(Index) + " has the wrong size.");
+
+		m_StoredData.resize(header.StoredSize);
+		ReadAt(chunks.TextureOffsets[i] + sizeof(header), m_StoredData.data(), header.StoredSize);
+
+		frame.Textures[i].resize(header.RawSize);
+
+		if (!DecompressTexture(m_StoredData, frame.Textures[i]))
+			throw std::runtime_error("Texture " + std::to_string(i) + " of frame " + std::to_string(Index) + " is corrupt.");
+	}
+
+	return frame;
+}
+
+bool FrameCaptureReader::DecompressTexture(std::span<const uint8_t> Source, std::span<uint8_t> Destination)
+{
+	while (!Destination.empty())
+	{
+		uint32_t blockHeader = 0;
+
+		if (Source.size() < sizeof(blockHeader))
+			return false;
+
+		memcpy(&blockHeader, Source.data(), sizeof(blockHeader));
+		Source = Source.subspan(sizeof(blockHeader));
+
+		const size_t storedSize = blockHeader & ~FrameCapture::BlockUncompressedFlag;
+		const size_t blockSize = std::min<size_t>(FrameCapture::BlockSize, Destination.size());
+
+		if (storedSize > Source.size())
+			return false;
+
+		if (blockHeader & FrameCapture::BlockUncompressedFlag)
+		{
+			if (storedSize != blockSize)
+				return false;
+
+			memcpy(Destination.data(), Source.data(), blockSize);
+		}
+		else
+		{
+			const int decodedSize = LZ4_decompress_safe(
+				reinterpret_cast<const char *>(Source.data()),
+				reinterpret_cast<char *>(Destination.data()),
+				static_cast<int>(storedSize),
+				static_cast<int>(blockSize));
+
+			if (decodedSize < 0 || static_cast<size_t>(decodedSize) != blockSize)
+				return false;
+		}
+
+		Source = Source.subspan(storedSize);
+		Destination = Destination.subspan(blockSize);
+	}
+
+	return Source.empty();
+}
+
+bool FrameCaptureReader::LoadIndex(const FrameCapture::FileHeader& Header)
+{
+	constexpr uint64_t entrySize = sizeof(FrameCapture::IndexEntry);
+
+	if (Header.IndexOffset < sizeof(Header) || Header.IndexOffset > m_FileSize ||
+		Header.IndexCount > (m_FileSize - Header.IndexOffset) / entrySize)
+		return false;
+
+	std::vector<FrameCapture::IndexEntry> index(Header.IndexCount);
+	ReadAt(Header.IndexOffset, index.data(), index.size() * entrySize);
+
+	for (const auto& entry : index)
+	{
+		const auto header = ReadChunkHeader(entry.Offset);
+
+		if (entry.Offset + sizeof(header) + header.StoredSize > Header.IndexOffset || header.Type != entry.Type ||
+			header.FrameIndex != entry.FrameIndex)
+			throw std::runtime_error("Index entry at " + std::to_string(entry.Offset) + " doesn't match its chunk.");
+
+		AddChunk(entry.Offset, header);
+	}
+
+	if (m_Frames.size() != Header.FrameCount)
+		throw std::runtime_error("Index holds " + std::to_string(m_Frames.size()) + " frames, header says " + std::to_string(Header.FrameCount) + ".");
+
+	return true;
+}
+
+void FrameCaptureReader::WalkChunks()
+{
+	uint64_t offset = sizeof(FrameCapture::FileHeader);
+
+	while (m_FileSize - offset >= sizeof(FrameCapture::ChunkHeader))
+	{
+		FrameCapture::ChunkHeader header = {};
+		ReadAt(offset, &header, sizeof(header));
+
+		// Anything cut off or unrecognizable ends the walk. Everything before it is still usable.
+		if ((header.Type != FrameCapture::ChunkType::Frame && header.Type != FrameCapture::ChunkType::Texture) ||
+			header.StoredSize > m_FileSize - offset - sizeof(header))
+			break;
+
+		AddChunk(offset, header);
+		offset += sizeof(header) + FFX_ALIGN_UP(header.StoredSize, FrameCapture::ChunkAlignment);
+	}
+}
+
+void FrameCaptureReader::AddChunk(uint64_t Offset, const FrameCapture::ChunkHeader& Header)
+{
+	if (Header.Type == FrameCapture::ChunkType::Frame)
+	{
+		if (Header.FrameIndex != m_Frames.size() || Header.StoredSize != sizeof(FrameCapture::FrameRecord))
+			throw std::runtime_error("Frame chunk at " + std::to_string(Offset) + " is out of order or malformed.");
+
+		m_Frames.push_back({ .RecordOffset = Offset });
+	}
+	else
+	{
+		if (Header.FrameIndex >= m_Frames.size() || Header.TextureIndex >= FrameCapture::TextureCount)
+			throw std::runtime_error("Texture chunk at " + std::to_string(Offset) + " doesn't belong to a frame.");
+
+		m_Frames[Header.FrameIndex].TextureOffsets[Header.TextureIndex] = Offset;
+	}
+}
+
+FrameCapture::ChunkHeader FrameCaptureReader::ReadChunkHeader(uint64_t Offset)
+{
+	FrameCapture::ChunkHeader header = {};
+	ReadAt(Offset, &header, sizeof(header));
+
+	if (header.Type != FrameCapture::ChunkType::Frame && header.Type != FrameCapture::ChunkType::Texture)
+		throw std::runtime_error("Unknown chunk type at " + std::to_string(Offset) + ".");
+
+	if (header.StoredSize > m_FileSize - Offset - sizeof(header))
+		throw std::runtime_error("Chunk at " + std::to_string(Offset) + " runs past the end of the file.");
+
+	return header;
+}
+
+void FrameCaptureReader::ReadAt(uint64_t Offset, void *Data, uint64_t Size)
+{
+	if (Offset > m_FileSize || Size > m_FileSize - Offset)
+		throw std::runtime_error("Unexpected end of file at " + std::to_string(Offset) + ".");
+
+	m_File.seekg(static_cast<std::streamoff>(Offset));
+	m_File.read(static_cast<char *>(Data), static_cast<std::streamsize>(Size));
+
+	if (!m_File)
+		throw std::runtime_error("Failed to read " + std::to_string(Size) + " bytes at " + std::to_string(Offset) + ".");
+}
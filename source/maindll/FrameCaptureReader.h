@@ -0,0 +1,49 @@
+#pragma once
+
+#include "FrameCapture.h"
+
+// Reads files written by FrameCapture. Captures that were cut short, for example because the game crashed, have no
+// index and are walked chunk by chunk instead. Everything read from disk is bounds checked. Malformed files throw
+// std::runtime_error.
+class FrameCaptureReader
+{
+public:
+	struct Frame
+	{
+		FrameCapture::FrameRecord Record = {};
+		std::array<std::vector<uint8_t>, FrameCapture::TextureCount> Textures; // Rows at TextureRecord::RowPitch. Empty when not captured.
+	};
+
+private:
+	struct FrameChunks
+	{
+		uint64_t RecordOffset = 0;
+		std::array<uint64_t, FrameCapture::TextureCount> TextureOffsets = {};
+	};
+
+	std::ifstream m_File;
+	uint64_t m_FileSize = 0;
+	bool m_HasIndex = false;
+	std::vector<FrameChunks> m_Frames;
+	std::vector<uint8_t> m_StoredData;
+
+public:
+	FrameCaptureReader(const std::filesystem::path& Path);
+	FrameCaptureReader(const FrameCaptureReader&) = delete;
+	FrameCaptureReader& operator=(const FrameCaptureReader&) = delete;
+
+	uint32_t GetFrameCount() const;
+	bool HasIndex() const;
+	FrameCapture::FrameRecord ReadRecord(uint32_t Index);
+	Frame ReadFrame(uint32_t Index);
+
+	// Decodes a texture chunk payload into exactly Destination.size() bytes
+	static bool DecompressTexture(std::span<const uint8_t> Source, std::span<uint8_t> Destination);
+
+private:
+	bool LoadIndex(const FrameCapture::FileHeader& Header);
+	void WalkChunks();
+	void AddChunk(uint64_t Offset, const FrameCapture::ChunkHeader& Header);
+	FrameCapture::ChunkHeader ReadChunkHeader(uint64_t Offset);
+	void ReadAt(uint64_t Offset, void *Data, uint64_t Size);
+};
@@ -0,0 +1,93 @@
+#include "FrameGenerationGovernor.h"
+
+FrameGenerationGovernor::FrameGenerationGovernor(const Settings& Settings) : m_Settings(Settings)
+{
+}
+
+FrameGenerationGovernor::Decision FrameGenerationGovernor::OnRealFrame(double Timestamp, uint32_t FrameMultiplier)
+{
+	const double frameTime = Timestamp - std::exchange(m_LastTimestamp, Timestamp);
+
+	if (frameTime <= 0.0 || frameTime > m_Settings.MaxFrameInterval)
+	{
+		// First frame or a hitch. Neither says anything about steady state performance.
+		m_GenerateFrameTime = 0.0;
+		m_PassThroughFrameTime = 0.0;
+		m_StateStartTimestamp = Timestamp;
+
+		return m_Decision;
+	}
+
+	auto& averageFrameTime = (m_Decision == Decision::Generate) ? m_GenerateFrameTime : m_PassThroughFrameTime;
+
+	if (averageFrameTime == 0.0)
+		averageFrameTime = frameTime;
+	else
+		averageFrameTime += (frameTime - averageFrameTime) * m_Settings.SmoothingFactor;
+
+	const double stateDuration = Timestamp - m_StateStartTimestamp;
+
+	if (stateDuration < m_Settings.MinStateDuration)
+		return m_Decision;
+
+	// Frames presented per second while generating
+	const double frameRate = std::max(FrameMultiplier, 1u) / averageFrameTime;
+	const bool hasFrameRateCap = m_Settings.TargetFrameRate > 0.0;
+
+	if (m_Decision == Decision::Generate)
+	{
+		const bool reachedCap = hasFrameRateCap && frameRate >= m_Settings.TargetFrameRate * m_Settings.EngageFrameRateRatio;
+		const bool regressed = m_PassThroughFrameTime > 0.0 &&
+			m_GenerateFrameTime > m_PassThroughFrameTime * (1.0 + m_Settings.MaxFrameTimeRegression);
+
+		if (regressed)
+		{
+			// Generation is slowing real frames down. Back off exponentially before trying again.
+			m_RetryInterval = std::clamp(m_RetryInterval * 2.0, m_Settings.MinStateDuration * 2.0, m_Settings.MaxRetryInterval);
+			TransitionTo(Decision::PassThrough, Timestamp);
+		}
+		else if (reachedCap)
+		{
+			TransitionTo(Decision::PassThrough, Timestamp);
+		}
+		else if (m_PassThroughFrameTime > 0.0)
+		{
+			// Generation has been paying off for a full state duration
+			m_RetryInterval = 0.0;
+		}
+	}
+	else
+	{
+		const bool belowCap = !hasFrameRateCap || frameRate < m_Settings.TargetFrameRate * m_Settings.DisengageFrameRateRatio;
+		const bool retryAllowed = stateDuration >= m_RetryInterval;
+
+		if (belowCap && retryAllowed)
+		{
+			// Measure generation cost from scratch. Conditions may have changed since the last attempt.
+			m_GenerateFrameTime = 0.0;
+			TransitionTo(Decision::Generate, Timestamp);
+		}
+	}
+
+	return m_Decision;
+}
+
+FrameGenerationGovernor::Decision FrameGenerationGovernor::GetDecision() const
+{
+	return m_Decision;
+}
+
+bool FrameGenerationGovernor::ConsumeResetRequest()
+{
+	return std::exchange(m_ResetPending, false);
+}
+
+void FrameGenerationGovernor::TransitionTo(Decision NewDecision, double Timestamp)
+{
+	// Interpolation history is stale after passing frames through
+	if (m_Decision == Decision::PassThrough && NewDecision == Decision::Generate)
+		m_ResetPending = true;
+
+	m_Decision = NewDecision;
+	m_StateStartTimestamp = Timestamp;
+}
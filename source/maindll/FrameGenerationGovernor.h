@@ -0,0 +1,49 @@
+#pragma once
+
+// Decides whether interpolated frames are worth generating based on the cadence of real frames. Timestamps are fed
+// in by the caller so traces can be replayed without a GPU.
+class FrameGenerationGovernor
+{
+public:
+	struct Settings
+	{
+		double TargetFrameRate = 0.0;		   // Presented frame rate cap. Zero disables the cap check.
+		double EngageFrameRateRatio = 0.95;	   // Pass through once presented frames reach this fraction of the cap...
+		double DisengageFrameRateRatio = 0.85; // ...and resume once generating would present less than this fraction
+		double MaxFrameTimeRegression = 0.25;  // Allowed real frame time increase caused by generation
+		double MinStateDuration = 1.0;		   // Seconds before another transition is allowed
+		double MaxRetryInterval = 32.0;		   // Upper bound for the regression back-off in seconds
+		double SmoothingFactor = 0.1;		   // Frame time moving average weight
+		double MaxFrameInterval = 0.25;		   // Longer gaps (loading screens, pauses) restart measurements
+	};
+
+	enum class Decision
+	{
+		Generate,
+		PassThrough,
+	};
+
+private:
+	const Settings m_Settings;
+
+	Decision m_Decision = Decision::PassThrough; // Starting here establishes a baseline frame time
+	double m_LastTimestamp = -std::numeric_limits<double>::infinity();
+	double m_StateStartTimestamp = 0.0;
+
+	double m_GenerateFrameTime = 0.0; // Smoothed real frame times. Zero when unknown.
+	double m_PassThroughFrameTime = 0.0;
+
+	double m_RetryInterval = 0.0; // Non-zero while backing off after a regression
+	bool m_ResetPending = false;
+
+public:
+	explicit FrameGenerationGovernor(const Settings& Settings);
+
+	// FrameMultiplier is the number of frames presented per real frame while generating
+	Decision OnRealFrame(double Timestamp, uint32_t FrameMultiplier);
+	Decision GetDecision() const;
+	bool ConsumeResetRequest();
+
+private:
+	void TransitionTo(Decision NewDecision, double Timestamp);
+};
@@ -0,0 +1,126 @@
+#include <format>
+#include "HostStageProfiler.h"
+
+static const char *GetStageName(HostStageProfiler::Stage Stage)
+{
+	switch (Stage)
+	{
+	case HostStageProfiler::Stage::LoadInputs:
+		return "LoadInputs";
+	case HostStageProfiler::Stage::BuildParameters:
+		return "BuildParameters";
+	case HostStageProfiler::Stage::OpticalFlow:
+		return "OpticalFlow";
+	case HostStageProfiler::Stage::FrameInterpolation:
+		return "FrameInterpolation";
+	case HostStageProfiler::Stage::OutputCopies:
+		return "OutputCopies";
+	case HostStageProfiler::Stage::Total:
+		return "Total";
+	}
+
+	return "Unknown";
+}
+
+HostStageProfiler::ScopedSample::ScopedSample(std::optional<HostStageProfiler>& Profiler, Stage Stage)
+	: m_Profiler(Profiler ? &Profiler.value() : nullptr),
+	  m_Stage(Stage),
+	  m_Start(Profiler ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {})
+{
+}
+
+HostStageProfiler::ScopedSample::~ScopedSample()
+{
+	if (m_Profiler)
+		m_Profiler->AddSample(m_Stage, std::chrono::steady_clock::now() - m_Start);
+}
+
+HostStageProfiler::HostStageProfiler(uint32_t WindowSize) : m_WindowSize(std::max(WindowSize, 1u))
+{
+}
+
+HostStageProfiler::~HostStageProfiler()
+{
+	Flush();
+}
+
+void HostStageProfiler::BeginFrame()
+{
+	m_FrameTimes = {};
+	m_FrameStart = std::chrono::steady_clock::now();
+}
+
+void HostStageProfiler::EndFrame(const Configuration& Configuration)
+{
+	AddSample(Stage::Total, std::chrono::steady_clock::now() - m_FrameStart);
+
+	// Mixing resolutions or feature sets in one window makes the numbers meaningless
+	if (Configuration != m_Configuration)
+	{
+		Flush();
+		m_Configuration = Configuration;
+	}
+
+	// A stage can be entered several times per frame. Statistics are kept over per-frame sums.
+	for (size_t i = 0; i < m_FrameTimes.size(); i++)
+	{
+		if (!m_FrameTimes[i])
+			continue;
+
+		auto& stats = m_Statistics[i];
+		stats.Count++;
+		stats.Min = std::min(stats.Min, *m_FrameTimes[i]);
+		stats.Max = std::max(stats.Max, *m_FrameTimes[i]);
+		stats.Sum += *m_FrameTimes[i];
+	}
+
+	if (++m_FrameCount >= m_WindowSize)
+		Flush();
+}
+
+void HostStageProfiler::AddSample(Stage Stage, std::chrono::steady_clock::duration Duration)
+{
+	auto& time = m_FrameTimes[static_cast<size_t>(Stage)];
+	time = time.value_or(0.0) + std::chrono::duration<double, std::micro>(Duration).count();
+}
+
+void HostStageProfiler::Flush()
+{
+	if (m_FrameCount == 0)
+		return;
+
+	std::string stages;
+
+	for (size_t i = 0; i < m_Statistics.size(); i++)
+	{
+		const auto& stats = m_Statistics[i];
+
+		if (stats.Count == 0)
+			continue;
+
+		stages += std::format(
+			"{}\"{}\":{{\"count\":{},\"minUs\":{:.2f},\"avgUs\":{:.2f},\"maxUs\":{:.2f}}}",
+			stages.empty() ? "" : ",",
+			GetStageName(static_cast<Stage>(i)),
+			stats.Count,
+			stats.Min,
+			stats.Sum / stats.Count,
+			stats.Max);
+	}
+
+	// One line per window. Grep for "host_stage_timings" and parse the remainder as JSON.
+	spdlog::info(
+		"host_stage_timings {{\"width\":{},\"height\":{},\"multiFrameCount\":{},\"hdr\":{},\"hudless\":{},\"distortionField\":{},"
+		"\"frames\":{},\"stages\":{{{}}}}}",
+		m_Configuration.Width,
+		m_Configuration.Height,
+		m_Configuration.MultiFrameCount,
+		m_Configuration.HDR,
+		m_Configuration.HUDLess,
+		m_Configuration.DistortionField,
+		m_FrameCount,
+		stages);
+
+	m_FrameCount = 0;
+	m_Statistics = {};
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+// Measures render thread time spent in each stage of a frame generation dispatch. Per-frame stage times are
+// aggregated over a window of frames and logged as a single JSON object, keyed by the configuration they were
+// captured with, so runs can be compared across builds.
+class HostStageProfiler
+{
+public:
+	enum class Stage : uint32_t
+	{
+		LoadInputs,			// Parameter map reads and resource lookups
+		BuildParameters,	// Resource dimensions and dispatch descriptions
+		OpticalFlow,		// Optical flow dispatch including backend job translation
+		FrameInterpolation, // Frame interpolation prepare and dispatch including backend job translation
+		OutputCopies,		// OutputReal/OutputInterpolated copies
+		Total,
+		Count,
+	};
+
+	struct Configuration
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t MultiFrameCount = 0;
+		bool HDR = false;
+		bool HUDLess = false;
+		bool DistortionField = false;
+
+		bool operator==(const Configuration&) const = default;
+	};
+
+	class ScopedSample
+	{
+	private:
+		HostStageProfiler *const m_Profiler;
+		const Stage m_Stage;
+		const std::chrono::steady_clock::time_point m_Start;
+
+	public:
+		ScopedSample(std::optional<HostStageProfiler>& Profiler, Stage Stage);
+		ScopedSample(const ScopedSample&) = delete;
+		ScopedSample& operator=(const ScopedSample&) = delete;
+		~ScopedSample();
+	};
+
+private:
+	struct Statistics
+	{
+		uint32_t Count = 0;
+		double Min = std::numeric_limits<double>::max();
+		double Max = 0.0;
+		double Sum = 0.0;
+	};
+
+	const uint32_t m_WindowSize;
+
+	Configuration m_Configuration;
+	uint32_t m_FrameCount = 0;
+	std::array<Statistics, static_cast<size_t>(Stage::Count)> m_Statistics;
+
+	std::chrono::steady_clock::time_point m_FrameStart;
+	std::array<std::optional<double>, static_cast<size_t>(Stage::Count)> m_FrameTimes; // Microseconds
+
+public:
+	explicit HostStageProfiler(uint32_t WindowSize);
+	~HostStageProfiler();
+
+	void BeginFrame();
+	void EndFrame(const Configuration& Configuration);
+
+private:
+	void AddSample(Stage Stage, std::chrono::steady_clock::duration Duration);
+	void Flush();
+};
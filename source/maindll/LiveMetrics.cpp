@@ -0,0 +1,106 @@
+#include <format>
+#include <Windows.h>
+#include "Config.h"
+#include "LiveMetrics.h"
+
+namespace LiveMetrics
+{
+	static std::atomic<float> LatestGpuPassMilliseconds = 0.0f;
+
+	static Header *GetSegment()
+	{
+		// Intentionally leaked. Readers may still have the segment mapped when the plugin unloads.
+		const static auto segment = []() -> Header *
+		{
+			if (!Config::Get()->EnableLiveMetrics)
+				return nullptr;
+
+			const auto name = std::format(L"Local\\dlssg_to_fsr3_metrics_{}", GetCurrentProcessId());
+			const uint32_t size = sizeof(Header) + sizeof(Record) * RecordCount;
+
+			const auto mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, size, name.c_str());
+
+			if (!mapping)
+			{
+				spdlog::error("Failed to create the live metrics shared memory segment: {:X}", GetLastError());
+				return nullptr;
+			}
+
+			const auto header = static_cast<Header *>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+
+			if (!header)
+			{
+				spdlog::error("Failed to map the live metrics shared memory segment: {:X}", GetLastError());
+				CloseHandle(mapping);
+
+				return nullptr;
+			}
+
+			// New mappings are zeroed. Magic goes last so readers never see a half initialized header.
+			LARGE_INTEGER frequency = {};
+			QueryPerformanceFrequency(&frequency);
+
+			header->Version = Version;
+			header->RecordSize = sizeof(Record);
+			header->RecordCount = RecordCount;
+			header->TimestampFrequency = frequency.QuadPart;
+			std::atomic_ref(header->Magic).store(Magic, std::memory_order_release);
+
+			spdlog::info("Publishing live metrics to shared memory segment dlssg_to_fsr3_metrics_{}.", GetCurrentProcessId());
+			return header;
+		}();
+
+		return segment;
+	}
+
+	bool IsEnabled()
+	{
+		return GetSegment() != nullptr;
+	}
+
+	void Publish(const Sample& Data)
+	{
+		const auto header = GetSegment();
+
+		if (!header)
+			return;
+
+		if (Data.Flags & FlagFlush)
+			header->FlushCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (Data.Flags & FlagContextsRecreated)
+			header->ContextRecreationCount.fetch_add(1, std::memory_order_relaxed);
+
+		if (Data.Flags & FlagPassThrough)
+			header->PassThroughCount.fetch_add(1, std::memory_order_relaxed);
+
+		const auto index = header->WriteIndex.fetch_add(1, std::memory_order_relaxed);
+		auto& record = reinterpret_cast<Record *>(header + 1)[index % RecordCount];
+
+		// Still owned by a writer from a full lap ago
+		auto sequence = record.Sequence.load(std::memory_order_relaxed);
+
+		if ((sequence & 1) != 0 || !record.Sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+		{
+			header->DroppedSamples.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		std::atomic_thread_fence(std::memory_order_release);
+
+		LARGE_INTEGER timestamp = {};
+		QueryPerformanceCounter(&timestamp);
+
+		record.Data = Data;
+		record.Data.FrameIndex = index;
+		record.Data.Timestamp = timestamp.QuadPart;
+		record.Data.GpuPassMilliseconds = LatestGpuPassMilliseconds.load(std::memory_order_relaxed);
+
+		record.Sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	void SetGpuPassMilliseconds(float Milliseconds)
+	{
+		LatestGpuPassMilliseconds.store(Milliseconds, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+// Per-frame metrics published to the named shared memory segment "Local\dlssg_to_fsr3_metrics_<pid>" when
+// EnableLiveMetrics is set. The segment holds a Header followed by RecordCount Records, so overlays and monitoring
+// tools can include this file and read it without linking anything.
+//
+// Writers claim records round robin with Header::WriteIndex and guard each one with a sequence lock: the sequence is
+// odd while a write is in progress. Readers copy a record with TryReadRecord and discard the copy when the sequence
+// changed underneath it. Neither side ever waits. A writer that finds its record still being written one full lap
+// later drops its sample instead.
+namespace LiveMetrics
+{
+	constexpr uint32_t Magic = 0x4D475344; // 'DSGM'
+	constexpr uint32_t Version = 1;
+	constexpr uint32_t RecordCount = 256;
+
+	// Sample::Flags
+	constexpr uint32_t FlagInterpolated = 1 << 0;		// Interpolated frame was generated
+	constexpr uint32_t FlagPassThrough = 1 << 1;		// Governor presented the real frame instead
+	constexpr uint32_t FlagFlush = 1 << 2;				// FFX_EOF. Backend busy or contexts awaiting a flush.
+	constexpr uint32_t FlagContextsRecreated = 1 << 3; // Contexts were rebuilt for a larger swapchain
+	constexpr uint32_t FlagError = 1 << 4;
+
+	struct Sample
+	{
+		uint64_t FrameIndex; // Claimed record index. Counts every feature instance.
+		uint64_t Timestamp;	 // QueryPerformanceCounter ticks
+		uint64_t BackendVRAMBytes; // Sampled every few frames
+		uint32_t Flags;
+		uint32_t Width;
+		uint32_t Height;
+		uint32_t MultiFrameIndex;
+		uint32_t MultiFrameCount;
+		float CpuDispatchMilliseconds;
+		float GpuPassMilliseconds; // Sum of pass averages over the last EnableGpuPassTimings window. Vulkan only.
+		uint32_t Reserved;
+	};
+
+	struct alignas(64) Record
+	{
+		std::atomic_uint32_t Sequence; // Zero until first written
+		uint32_t Reserved;
+		Sample Data;
+	};
+
+	struct alignas(64) Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t RecordSize;
+		uint32_t RecordCount;
+		uint64_t TimestampFrequency;
+		std::atomic_uint64_t WriteIndex; // Next record is Records[WriteIndex % RecordCount]
+		std::atomic_uint64_t DroppedSamples;
+		std::atomic_uint64_t FlushCount;
+		std::atomic_uint64_t ContextRecreationCount;
+		std::atomic_uint64_t PassThroughCount;
+	};
+
+	static_assert(std::atomic_uint64_t::is_always_lock_free, "Shared memory atomics must be address free");
+	static_assert(sizeof(Record) == 64 && sizeof(Header) == 64);
+
+	inline const Record *GetRecords(const Header *Segment)
+	{
+		return reinterpret_cast<const Record *>(Segment + 1);
+	}
+
+	// Returns false when the record was never written, is being written, or was overwritten during the copy
+	inline bool TryReadRecord(const Record& Source, Sample *OutSample)
+	{
+		const auto sequence = Source.Sequence.load(std::memory_order_acquire);
+
+		if (sequence == 0 || (sequence & 1) != 0)
+			return false;
+
+		memcpy(OutSample, &Source.Data, sizeof(Sample));
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		return Source.Sequence.load(std::memory_order_relaxed) == sequence;
+	}
+
+	bool IsEnabled();
+	void Publish(const Sample& Data);
+	void SetGpuPassMilliseconds(float Milliseconds);
+}
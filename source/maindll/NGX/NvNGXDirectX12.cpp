@@ -1,13 +1,15 @@
 #include <d3d12.h>
 #include <dxgi.h>
+#include <FidelityFX/host/backends/dx12/ffx_dx12.h>
 #include "FFFrameInterpolatorDX.h"
-#include "NvNGX.h"
+#include "TraceRecorder.h"
+#include "Util.h"
+#include "NvNGXFeature.h"
 
 typedef LONG NTSTATUS;
 #include <d3dkmthk.h>
 
-static std::shared_mutex FeatureInstanceHandleLock;
-static std::unordered_map<uint32_t, std::shared_ptr<FFFrameInterpolatorDX>> FeatureInstanceHandles;
+static NGXFeature::Registry<FFFrameInterpolatorDX> FeatureInstances;
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_CreateFeature(
 	ID3D12CommandList *CommandList,
@@ -16,6 +18,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_CreateFeature(
 	NGXHandle **OutInstanceHandle)
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_ZONE("ngx", "CreateFeature");
 
 	if (!CommandList || !Parameters || !OutInstanceHandle)
 		return NGX_INVALID_PARAMETER;
@@ -26,91 +29,27 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_CreateFeature(
 	if (FAILED(CommandList->GetDevice(IID_PPV_ARGS(&device))))
 		return 0xBAD00002;
 
-	// Grab NGX parameters from sl.dlss_g.dll
-	// https://forums.developer.nvidia.com/t/using-dlssg-without-idxgiswapchain-present/247260/8
-	Parameters->Set4("DLSSG.MustCallEval", 1);
-
-	uint32_t swapchainWidth = 0;
-	Parameters->Get5("Width", &swapchainWidth);
-
-	uint32_t swapchainHeight = 0;
-	Parameters->Get5("Height", &swapchainHeight);
-
-	// Then initialize FSR
-	try
-	{
-		auto instance = std::make_shared<FFFrameInterpolatorDX>(device, swapchainWidth, swapchainHeight, Parameters);
-
-		std::scoped_lock lock(FeatureInstanceHandleLock);
+	const auto result = FeatureInstances.Create(
+		__FUNCTION__,
+		Parameters,
+		OutInstanceHandle,
+		[&](uint32_t SwapchainWidth, uint32_t SwapchainHeight)
 		{
-			const auto handle = NGXHandle::Allocate(11);
-			*OutInstanceHandle = handle;
-
-			FeatureInstanceHandles.emplace(handle->InternalId, std::move(instance));
-		}
-	}
-	catch (const std::exception& e)
-	{
-		spdlog::error("NVSDK_NGX_D3D12_CreateFeature: Failed to initialize: {}", e.what());
-		device->Release();
-
-		return NGX_FEATURE_NOT_FOUND;
-	}
-
-	spdlog::info("NVSDK_NGX_D3D12_CreateFeature: Succeeded.");
+			return std::make_shared<FFFrameInterpolatorDX>(device, SwapchainWidth, SwapchainHeight, Parameters);
+		});
 	device->Release();
 
-	return NGX_SUCCESS;
+	return result;
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCommandList *CommandList, NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
 {
-	if (!CommandList || !InstanceHandle || !Parameters)
-		return NGX_INVALID_PARAMETER;
-
-	const auto instance = [&]()
-	{
-		std::shared_lock lock(FeatureInstanceHandleLock);
-		auto itr = FeatureInstanceHandles.find(InstanceHandle->InternalId);
-
-		if (itr == FeatureInstanceHandles.end())
-			return decltype(itr->second) {};
-
-		return itr->second;
-	}();
-
-	if (!instance)
-		return NGX_FEATURE_NOT_FOUND;
+	TRACE_ZONE("ngx", "EvaluateFeature");
 
-	const auto status = instance->Dispatch(CommandList, Parameters);
-
-	switch (status)
-	{
-	case FFX_EOF:
+	if (!CommandList || !InstanceHandle || !Parameters)
 		return NGX_INVALID_PARAMETER;
 
-	case FFX_OK:
-	{
-		static bool once = [&]()
-		{
-			spdlog::info("NVSDK_NGX_D3D12_EvaluateFeature: Succeeded.");
-			return true;
-		}();
-
-		return NGX_SUCCESS;
-	}
-
-	default:
-	{
-		static bool once = [&]()
-		{
-			spdlog::error("Evaluation call failed with status {:X}.", static_cast<uint32_t>(status));
-			return true;
-		}();
-
-		return NGX_INVALID_PARAMETER;
-	}
-	}
+	return FeatureInstances.Evaluate(__FUNCTION__, CommandList, InstanceHandle, Parameters);
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_GetFeatureRequirements(IDXGIAdapter *Adapter, void *FeatureDiscoveryInfo, NGXFeatureRequirementInfo *RequirementInfo)
@@ -118,9 +57,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_GetFeatureRequirements(IDXGIAdapter *Adap
 	if (!FeatureDiscoveryInfo || !RequirementInfo)
 		return NGX_INVALID_PARAMETER;
 
-	RequirementInfo->Flags = 0;
-	RequirementInfo->RequiredGPUArchitecture = NGXHardcodedArchitecture;
-	strcpy_s(RequirementInfo->RequiredOperatingSystemVersion, "10.0.0");
+	NGXFeature::GetRequirements(RequirementInfo);
 
 	return NGX_SUCCESS;
 }
@@ -204,22 +141,14 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_Init(void *Unknown1, const wchar_t *Path,
 	return NVSDK_NGX_D3D12_Init_Ext(Unknown1, Path, D3DDevice, Unknown2, nullptr);
 }
 
-static NGXResult GetCurrentSettingsCallback(NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
-{
-	if (!InstanceHandle || !Parameters)
-		return NGX_INVALID_PARAMETER;
-
-	Parameters->Set4("DLSSG.MustCallEval", 1);
-	Parameters->Set4("DLSSG.BurstCaptureRunning", 0);
-
-	return NGX_SUCCESS;
-}
-
+// Argument order follows Streamline's sl.dlss_g, which forwards sl::DLSSGOptions::numBackBuffers, colorWidth,
+// colorHeight and colorBufferFormat first when the game sets DLSSGFlags::eRequestVRAMEstimate. The remaining
+// arguments describe the depth, motion vector and UI inputs.
 static NGXResult EstimateVRAMCallback(
-	uint32_t,
-	uint32_t,
-	uint32_t,
-	uint32_t,
+	uint32_t SwapchainBufferCount,
+	uint32_t SwapchainWidth,
+	uint32_t SwapchainHeight,
+	uint32_t BackbufferFormat,
 	uint32_t,
 	uint32_t,
 	uint32_t,
@@ -227,10 +156,15 @@ static NGXResult EstimateVRAMCallback(
 	uint32_t,
 	size_t *EstimatedSize)
 {
-	// Assume 300MB
-	if (EstimatedSize)
-		*EstimatedSize = 300 * 1024 * 1024;
+	if (!EstimatedSize)
+		return NGX_INVALID_PARAMETER;
 
+	// Only the swapchain description is used. Depth, motion vector and UI inputs are never copied.
+	*EstimatedSize = FFFrameInterpolator::EstimateVRAMUsage(
+		SwapchainBufferCount,
+		SwapchainWidth,
+		SwapchainHeight,
+		ffxGetSurfaceFormatDX12(static_cast<DXGI_FORMAT>(BackbufferFormat)));
 	return NGX_SUCCESS;
 }
 
@@ -241,10 +175,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_PopulateDeviceParameters_Impl(ID3D12Devic
 	if (!D3DDevice || !Parameters)
 		return NGX_INVALID_PARAMETER;
 
-	Parameters->SetVoidPointer("DLSSG.GetCurrentSettingsCallback", &GetCurrentSettingsCallback);
-	Parameters->SetVoidPointer("DLSSG.EstimateVRAMCallback", &EstimateVRAMCallback);
-	Parameters->Set5("DLSSG.MultiFrameCountMax", 1);
-	Parameters->Set4("DLSSG.ReflexWarp.Available", 0);
+	NGXFeature::PopulateParameters(Parameters, &EstimateVRAMCallback);
 
 	return NGX_SUCCESS;
 }
@@ -256,10 +187,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_PopulateParameters_Impl(NGXInstanceParame
 	if (!Parameters)
 		return NGX_INVALID_PARAMETER;
 
-	Parameters->SetVoidPointer("DLSSG.GetCurrentSettingsCallback", &GetCurrentSettingsCallback);
-	Parameters->SetVoidPointer("DLSSG.EstimateVRAMCallback", &EstimateVRAMCallback);
-	Parameters->Set5("DLSSG.MultiFrameCountMax", 1);
-	Parameters->Set4("DLSSG.ReflexWarp.Available", 0);
+	NGXFeature::PopulateParameters(Parameters, &EstimateVRAMCallback);
 
 	return NGX_SUCCESS;
 }
@@ -267,33 +195,27 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_PopulateParameters_Impl(NGXInstanceParame
 NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_ReleaseFeature(NGXHandle *InstanceHandle)
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_ZONE("ngx", "ReleaseFeature");
 
 	if (!InstanceHandle)
 		return NGX_INVALID_PARAMETER;
 
-	const auto node = [&]()
-	{
-		std::scoped_lock lock(FeatureInstanceHandleLock);
-		return FeatureInstanceHandles.extract(InstanceHandle->InternalId);
-	}();
-
-	if (node.empty())
-		return NGX_FEATURE_NOT_FOUND;
-
-	// Node is handled by RAII. Apparently, InstanceHandle isn't supposed to be deleted.
-	// NGXHandle::Free(InstanceHandle);
-	return NGX_SUCCESS;
+	return FeatureInstances.Release(__FUNCTION__, InstanceHandle);
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_Shutdown()
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_FLUSH();
+	Util::FlushLog();
 	return NGX_SUCCESS;
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_D3D12_Shutdown1(ID3D12Device *D3DDevice)
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_FLUSH();
+	Util::FlushLog();
 
 	if (!D3DDevice)
 		return NGX_INVALID_PARAMETER;
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "NvNGX.h"
+#include "FFFrameInterpolator.h"
+#include "Util.h"
+
+// Feature handles and the parameter contract with sl.dlss_g, shared by the exports of every graphics API. Callers pass
+// their export name for log messages.
+namespace NGXFeature
+{
+	using EstimateVRAMFunc = NGXResult(
+		uint32_t SwapchainBufferCount,
+		uint32_t SwapchainWidth,
+		uint32_t SwapchainHeight,
+		uint32_t BackbufferFormat,
+		uint32_t,
+		uint32_t,
+		uint32_t,
+		uint32_t,
+		uint32_t,
+		size_t *EstimatedSize);
+
+	inline NGXResult GetCurrentSettingsCallback(NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
+	{
+		if (!InstanceHandle || !Parameters)
+			return NGX_INVALID_PARAMETER;
+
+		Parameters->Set4("DLSSG.MustCallEval", 1);
+		Parameters->Set4("DLSSG.BurstCaptureRunning", 0);
+
+		return NGX_SUCCESS;
+	}
+
+	inline void PopulateParameters(NGXInstanceParameters *Parameters, EstimateVRAMFunc *EstimateVRAMCallback)
+	{
+		Parameters->SetVoidPointer("DLSSG.GetCurrentSettingsCallback", reinterpret_cast<void *>(&GetCurrentSettingsCallback));
+		Parameters->SetVoidPointer("DLSSG.EstimateVRAMCallback", reinterpret_cast<void *>(EstimateVRAMCallback));
+		Parameters->Set5("DLSSG.MultiFrameCountMax", FFFrameInterpolator::MaxMultiFrameCount);
+		Parameters->Set4("DLSSG.ReflexWarp.Available", 0);
+	}
+
+	inline void GetRequirements(NGXFeatureRequirementInfo *RequirementInfo)
+	{
+		RequirementInfo->Flags = 0;
+		RequirementInfo->RequiredGPUArchitecture = NGXHardcodedArchitecture;
+		strcpy_s(RequirementInfo->RequiredOperatingSystemVersion, "10.0.0");
+	}
+
+	// Live feature instances by NGX handle. Handles stay valid after release and are reported as unknown from then on.
+	template<typename T>
+	class Registry
+	{
+	private:
+		std::shared_mutex m_Lock;
+		std::unordered_map<uint32_t, std::shared_ptr<T>> m_Instances;
+
+	public:
+		using ConstructFunc = std::function<std::shared_ptr<T>(uint32_t SwapchainWidth, uint32_t SwapchainHeight)>;
+
+		NGXResult Create(
+			const char *Caller,
+			NGXInstanceParameters *Parameters,
+			NGXHandle **OutInstanceHandle,
+			const ConstructFunc& Construct)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+
+			// Grab NGX parameters from sl.dlss_g.dll
+			// https://forums.developer.nvidia.com/t/using-dlssg-without-idxgiswapchain-present/247260/8
+			Parameters->Set4("DLSSG.MustCallEval", 1);
+
+			uint32_t swapchainWidth = 0;
+			Parameters->Get5("Width", &swapchainWidth);
+
+			uint32_t swapchainHeight = 0;
+			Parameters->Get5("Height", &swapchainHeight);
+
+			// Then initialize FSR
+			try
+			{
+				auto instance = Construct(swapchainWidth, swapchainHeight);
+
+				std::scoped_lock lock(m_Lock);
+				{
+					const auto handle = NGXHandle::Allocate(11);
+					*OutInstanceHandle = handle;
+
+					m_Instances.emplace(handle->InternalId, std::move(instance));
+				}
+			}
+			catch (const std::exception& e)
+			{
+				spdlog::error("{}: Failed to initialize: {}", Caller, e.what());
+				return NGX_FEATURE_NOT_FOUND;
+			}
+
+			spdlog::info(
+				"{}: Succeeded in {:.1f} ms.",
+				Caller,
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+			return NGX_SUCCESS;
+		}
+
+		NGXResult Evaluate(const char *Caller, void *CommandList, NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
+		{
+			const auto instance = [&]()
+			{
+				std::shared_lock lock(m_Lock);
+				auto itr = m_Instances.find(InstanceHandle->InternalId);
+
+				if (itr == m_Instances.end())
+					return decltype(itr->second) {};
+
+				return itr->second;
+			}();
+
+			if (!instance)
+			{
+				LOG_RATE_LIMITED(warn, "{}: Called with an unknown or released feature handle.", Caller);
+
+				return NGX_FEATURE_NOT_FOUND;
+			}
+
+			const auto status = instance->Dispatch(CommandList, Parameters);
+
+			// FfxErrorCode is signed while the FFX_ERROR_ constants aren't
+			switch (static_cast<uint32_t>(status))
+			{
+			case FFX_EOF:
+				return NGX_INVALID_PARAMETER;
+
+			case FFX_OK:
+			{
+				static bool once = [&]()
+				{
+					spdlog::info("{}: Succeeded.", Caller);
+					return true;
+				}();
+
+				return NGX_SUCCESS;
+			}
+
+			default:
+				LOG_RATE_LIMITED(error, "Evaluation call failed with status {:X}.", static_cast<uint32_t>(status));
+				return NGX_INVALID_PARAMETER;
+			}
+		}
+
+		NGXResult Release(const char *Caller, NGXHandle *InstanceHandle)
+		{
+			auto node = [&]()
+			{
+				std::scoped_lock lock(m_Lock);
+				return m_Instances.extract(InstanceHandle->InternalId);
+			}();
+
+			if (node.empty())
+			{
+				spdlog::warn("{}: Unknown or already released feature handle.", Caller);
+				return NGX_FEATURE_NOT_FOUND;
+			}
+
+			// Apparently, InstanceHandle isn't supposed to be deleted.
+			// NGXHandle::Free(InstanceHandle);
+			const auto startTime = std::chrono::steady_clock::now();
+			node = {};
+
+			spdlog::info(
+				"{}: Released in {:.1f} ms.",
+				Caller,
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+
+			return NGX_SUCCESS;
+		}
+	};
+}
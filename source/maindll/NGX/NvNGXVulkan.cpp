@@ -1,12 +1,14 @@
 #include <Windows.h>
-#include "NvNGX.h"
+#include <FidelityFX/host/backends/vk/ffx_vk.h>
 #include "FFFrameInterpolatorVK.h"
+#include "NvNGXFeature.h"
+#include "TraceRecorder.h"
+#include "Util.h"
 
 typedef LONG NTSTATUS;
 #include <d3dkmthk.h>
 
-static std::shared_mutex FeatureInstanceHandleLock;
-static std::unordered_map<uint32_t, std::shared_ptr<FFFrameInterpolatorVK>> FeatureInstanceHandles;
+static NGXFeature::Registry<FFFrameInterpolatorVK> FeatureInstances;
 
 static VkDevice g_LogicalDevice = VK_NULL_HANDLE;
 static VkPhysicalDevice g_PhysicalDevice = VK_NULL_HANDLE;
@@ -19,46 +21,24 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_CreateFeature1(
 	NGXHandle **OutInstanceHandle)
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_ZONE("ngx", "CreateFeature");
 
 	if (!LogicalDevice || !Parameters || !OutInstanceHandle)
 		return NGX_INVALID_PARAMETER;
 
-	// Grab NGX parameters from sl.dlss_g.dll
-	// https://forums.developer.nvidia.com/t/using-dlssg-without-idxgiswapchain-present/247260/8
-	Parameters->Set4("DLSSG.MustCallEval", 1);
-
-	uint32_t swapchainWidth = 0;
-	Parameters->Get5("Width", &swapchainWidth);
-
-	uint32_t swapchainHeight = 0;
-	Parameters->Get5("Height", &swapchainHeight);
-
-	// Then initialize FSR
-	try
-	{
-		auto instance = std::make_shared<FFFrameInterpolatorVK>(
-			LogicalDevice,
-			g_PhysicalDevice,
-			swapchainWidth,
-			swapchainHeight,
-			Parameters);
-
-		std::scoped_lock lock(FeatureInstanceHandleLock);
+	return FeatureInstances.Create(
+		__FUNCTION__,
+		Parameters,
+		OutInstanceHandle,
+		[&](uint32_t SwapchainWidth, uint32_t SwapchainHeight)
 		{
-			const auto handle = NGXHandle::Allocate(11);
-			*OutInstanceHandle = handle;
-
-			FeatureInstanceHandles.emplace(handle->InternalId, std::move(instance));
-		}
-	}
-	catch (const std::exception& e)
-	{
-		spdlog::error("NVSDK_NGX_VULKAN_CreateFeature1: Failed to initialize: {}", e.what());
-		return NGX_FEATURE_NOT_FOUND;
-	}
-
-	spdlog::info("NVSDK_NGX_VULKAN_CreateFeature1: Succeeded.");
-	return NGX_SUCCESS;
+			return std::make_shared<FFFrameInterpolatorVK>(
+				LogicalDevice,
+				g_PhysicalDevice,
+				SwapchainWidth,
+				SwapchainHeight,
+				Parameters);
+		});
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_CreateFeature(
@@ -77,52 +57,12 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_CreateFeature(
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer CommandList, NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
 {
-	if (!CommandList || !InstanceHandle || !Parameters)
-		return NGX_INVALID_PARAMETER;
+	TRACE_ZONE("ngx", "EvaluateFeature");
 
-	const auto instance = [&]()
-	{
-		std::shared_lock lock(FeatureInstanceHandleLock);
-		auto itr = FeatureInstanceHandles.find(InstanceHandle->InternalId);
-
-		if (itr == FeatureInstanceHandles.end())
-			return decltype(itr->second) {};
-
-		return itr->second;
-	}();
-
-	if (!instance)
-		return NGX_FEATURE_NOT_FOUND;
-
-	const auto status = instance->Dispatch(CommandList, Parameters);
-
-	switch (status)
-	{
-	case FFX_EOF:
+	if (!CommandList || !InstanceHandle || !Parameters)
 		return NGX_INVALID_PARAMETER;
 
-	case FFX_OK:
-	{
-		static bool once = [&]()
-		{
-			spdlog::info("NVSDK_NGX_VULKAN_EvaluateFeature: Succeeded.");
-			return true;
-		}();
-
-		return NGX_SUCCESS;
-	}
-
-	default:
-	{
-		static bool once = [&]()
-		{
-			spdlog::error("Evaluation call failed with status {:X}.", static_cast<uint32_t>(status));
-			return true;
-		}();
-
-		return NGX_INVALID_PARAMETER;
-	}
-	}
+	return FeatureInstances.Evaluate(__FUNCTION__, CommandList, InstanceHandle, Parameters);
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_GetFeatureRequirements(
@@ -134,9 +74,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_GetFeatureRequirements(
 	if (!FeatureDiscoveryInfo || !RequirementInfo)
 		return NGX_INVALID_PARAMETER;
 
-	RequirementInfo->Flags = 0;
-	RequirementInfo->RequiredGPUArchitecture = NGXHardcodedArchitecture;
-	strcpy_s(RequirementInfo->RequiredOperatingSystemVersion, "10.0.0");
+	NGXFeature::GetRequirements(RequirementInfo);
 
 	return NGX_SUCCESS;
 }
@@ -253,22 +191,14 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_Init(
 	return NVSDK_NGX_VULKAN_Init_Ext(Unknown1, Unknown2, VulkanInstance, PhysicalDevice, LogicalDevice, Unknown3, nullptr);
 }
 
-static NGXResult GetCurrentSettingsCallback(NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
-{
-	if (!InstanceHandle || !Parameters)
-		return NGX_INVALID_PARAMETER;
-
-	Parameters->Set4("DLSSG.MustCallEval", 1);
-	Parameters->Set4("DLSSG.BurstCaptureRunning", 0);
-
-	return NGX_SUCCESS;
-}
-
+// Argument order follows Streamline's sl.dlss_g, which forwards sl::DLSSGOptions::numBackBuffers, colorWidth,
+// colorHeight and colorBufferFormat first when the game sets DLSSGFlags::eRequestVRAMEstimate. The remaining
+// arguments describe the depth, motion vector and UI inputs.
 static NGXResult EstimateVRAMCallback(
-	uint32_t,
-	uint32_t,
-	uint32_t,
-	uint32_t,
+	uint32_t SwapchainBufferCount,
+	uint32_t SwapchainWidth,
+	uint32_t SwapchainHeight,
+	uint32_t BackbufferFormat,
 	uint32_t,
 	uint32_t,
 	uint32_t,
@@ -276,10 +206,15 @@ static NGXResult EstimateVRAMCallback(
 	uint32_t,
 	size_t *EstimatedSize)
 {
-	// Assume 300MB
-	if (EstimatedSize)
-		*EstimatedSize = 300 * 1024 * 1024;
+	if (!EstimatedSize)
+		return NGX_INVALID_PARAMETER;
 
+	// Only the swapchain description is used. Depth, motion vector and UI inputs are never copied.
+	*EstimatedSize = FFFrameInterpolator::EstimateVRAMUsage(
+		SwapchainBufferCount,
+		SwapchainWidth,
+		SwapchainHeight,
+		ffxGetSurfaceFormatVK(static_cast<VkFormat>(BackbufferFormat)));
 	return NGX_SUCCESS;
 }
 
@@ -295,10 +230,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_PopulateDeviceParameters_Impl(
 	if (!VulkanInstance || !PhysicalDevice || !LogicalDevice || !Parameters)
 		return NGX_INVALID_PARAMETER;
 
-	Parameters->SetVoidPointer("DLSSG.GetCurrentSettingsCallback", &GetCurrentSettingsCallback);
-	Parameters->SetVoidPointer("DLSSG.EstimateVRAMCallback", &EstimateVRAMCallback);
-	Parameters->Set5("DLSSG.MultiFrameCountMax", 1);
-	Parameters->Set4("DLSSG.ReflexWarp.Available", 0);
+	NGXFeature::PopulateParameters(Parameters, &EstimateVRAMCallback);
 
 	return NGX_SUCCESS;
 }
@@ -310,10 +242,7 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_PopulateParameters_Impl(NGXInstanceParam
 	if (!Parameters)
 		return NGX_INVALID_PARAMETER;
 
-	Parameters->SetVoidPointer("DLSSG.GetCurrentSettingsCallback", &GetCurrentSettingsCallback);
-	Parameters->SetVoidPointer("DLSSG.EstimateVRAMCallback", &EstimateVRAMCallback);
-	Parameters->Set5("DLSSG.MultiFrameCountMax", 1);
-	Parameters->Set4("DLSSG.ReflexWarp.Available", 0);
+	NGXFeature::PopulateParameters(Parameters, &EstimateVRAMCallback);
 
 	return NGX_SUCCESS;
 }
@@ -321,33 +250,27 @@ NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_PopulateParameters_Impl(NGXInstanceParam
 NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_ReleaseFeature(NGXHandle *InstanceHandle)
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_ZONE("ngx", "ReleaseFeature");
 
 	if (!InstanceHandle)
 		return NGX_INVALID_PARAMETER;
 
-	const auto node = [&]()
-	{
-		std::scoped_lock lock(FeatureInstanceHandleLock);
-		return FeatureInstanceHandles.extract(InstanceHandle->InternalId);
-	}();
-
-	if (node.empty())
-		return NGX_FEATURE_NOT_FOUND;
-
-	// Node is handled by RAII. Apparently, InstanceHandle isn't supposed to be deleted.
-	// NGXHandle::Free(InstanceHandle);
-	return NGX_SUCCESS;
+	return FeatureInstances.Release(__FUNCTION__, InstanceHandle);
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_Shutdown()
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_FLUSH();
+	Util::FlushLog();
 	return NGX_SUCCESS;
 }
 
 NGXDLLEXPORT NGXResult NVSDK_NGX_VULKAN_Shutdown1(VkDevice LogicalDevice)
 {
 	spdlog::info(__FUNCTION__);
+	TRACE_FLUSH();
+	Util::FlushLog();
 
 	if (!LogicalDevice)
 		return NGX_INVALID_PARAMETER;
@@ -0,0 +1,270 @@
+#include <condition_variable>
+#include <deque>
+#include <format>
+#include <thread>
+#include <Windows.h>
+#include "Config.h"
+#include "TraceRecorder.h"
+#include "Util.h"
+
+namespace Trace
+{
+	constexpr size_t EventsPerChunk = 4096;
+	constexpr size_t ChunkCount = 4;
+
+	struct Event
+	{
+		std::chrono::steady_clock::time_point Start;
+		std::chrono::steady_clock::duration Duration;
+		double Value;
+		const char *Category;
+		uint32_t ThreadId;
+		char Phase; // 'X' complete, 'i' instant, 'C' counter
+		char Name[MaxNameLength + 1];
+	};
+
+	struct Chunk
+	{
+		std::array<Event, EventsPerChunk> Events;
+		size_t Count = 0;
+	};
+
+	class Recorder
+	{
+	private:
+		std::mutex m_Mutex;
+		std::condition_variable m_WorkAvailable;
+		std::vector<std::unique_ptr<Chunk>> m_FreeChunks;
+		std::deque<std::unique_ptr<Chunk>> m_FullChunks;
+		std::unique_ptr<Chunk> m_ActiveChunk;
+		uint64_t m_DroppedEvents = 0;
+
+		const std::chrono::steady_clock::time_point m_Epoch = std::chrono::steady_clock::now();
+		const uint32_t m_ProcessId = GetCurrentProcessId();
+		std::ofstream m_File;
+
+	public:
+		Recorder(const std::filesystem::path& Path) : m_File(Path, std::ios::out | std::ios::trunc)
+		{
+			for (size_t i = 0; i < ChunkCount; i++)
+				m_FreeChunks.emplace_back(std::make_unique<Chunk>());
+
+			// JSON array format. The closing bracket is optional, so whatever made it to disk stays loadable.
+			m_File << std::format(
+				"[\n{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},\"args\":{{\"name\":\"dlssg-to-fsr3\"}}}},\n",
+				m_ProcessId);
+			m_File.flush();
+
+			std::thread(&Recorder::WriterThread, this).detach();
+		}
+
+		void Add(char Phase, std::string_view Name, const char *Category, std::chrono::steady_clock::time_point Start, std::chrono::steady_clock::duration Duration, double Value)
+		{
+			std::scoped_lock lock(m_Mutex);
+
+			if (m_ActiveChunk && m_ActiveChunk->Count >= EventsPerChunk)
+			{
+				m_FullChunks.emplace_back(std::move(m_ActiveChunk));
+				m_WorkAvailable.notify_one();
+			}
+
+			if (!m_ActiveChunk)
+			{
+				if (m_FreeChunks.empty())
+				{
+					m_DroppedEvents++;
+					return;
+				}
+
+				m_ActiveChunk = std::move(m_FreeChunks.back());
+				m_FreeChunks.pop_back();
+			}
+
+			auto& event = m_ActiveChunk->Events[m_ActiveChunk->Count++];
+			event.Start = Start;
+			event.Duration = Duration;
+			event.Value = Value;
+			event.Category = Category;
+			event.ThreadId = GetCurrentThreadId();
+			event.Phase = Phase;
+
+			// Names are written verbatim. Keep them JSON safe.
+			const auto length = std::min(Name.size(), MaxNameLength);
+
+			for (size_t i = 0; i < length; i++)
+				event.Name[i] = (Name[i] == '"' || Name[i] == '\\' || Name[i] < ' ') ? '_' : Name[i];
+
+			event.Name[length] = '\0';
+		}
+
+		void Flush()
+		{
+			std::scoped_lock lock(m_Mutex);
+
+			if (m_ActiveChunk && m_ActiveChunk->Count > 0)
+			{
+				m_FullChunks.emplace_back(std::move(m_ActiveChunk));
+				m_WorkAvailable.notify_one();
+			}
+		}
+
+	private:
+		void WriterThread()
+		{
+			std::string buffer;
+			uint64_t reportedDroppedEvents = 0;
+
+			while (true)
+			{
+				std::unique_ptr<Chunk> chunk;
+				uint64_t droppedEvents = 0;
+
+				{
+					std::unique_lock lock(m_Mutex);
+					m_WorkAvailable.wait(lock, [&]() { return !m_FullChunks.empty(); });
+
+					chunk = std::move(m_FullChunks.front());
+					m_FullChunks.pop_front();
+					droppedEvents = m_DroppedEvents;
+				}
+
+				buffer.clear();
+
+				for (size_t i = 0; i < chunk->Count; i++)
+					FormatEvent(buffer, chunk->Events[i]);
+
+				if (droppedEvents != reportedDroppedEvents && chunk->Count > 0)
+				{
+					buffer += std::format(
+						"{{\"name\":\"TraceDroppedEvents\",\"cat\":\"trace\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":{},\"tid\":0,"
+						"\"args\":{{\"value\":{}}}}},\n",
+						GetTimestamp(chunk->Events[0].Start),
+						m_ProcessId,
+						droppedEvents);
+
+					reportedDroppedEvents = droppedEvents;
+				}
+
+				m_File << buffer;
+				m_File.flush();
+
+				chunk->Count = 0;
+
+				std::scoped_lock lock(m_Mutex);
+				m_FreeChunks.emplace_back(std::move(chunk));
+			}
+		}
+
+		void FormatEvent(std::string& Buffer, const Event& Entry) const
+		{
+			const auto timestamp = GetTimestamp(Entry.Start);
+
+			switch (Entry.Phase)
+			{
+			case 'X':
+				std::format_to(
+					std::back_inserter(Buffer),
+					"{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{}}},\n",
+					Entry.Name,
+					Entry.Category,
+					timestamp,
+					std::chrono::duration<double, std::micro>(Entry.Duration).count(),
+					m_ProcessId,
+					Entry.ThreadId);
+				break;
+
+			case 'i':
+				std::format_to(
+					std::back_inserter(Buffer),
+					"{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"i\",\"s\":\"t\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}},\n",
+					Entry.Name,
+					Entry.Category,
+					timestamp,
+					m_ProcessId,
+					Entry.ThreadId);
+				break;
+
+			case 'C':
+				std::format_to(
+					std::back_inserter(Buffer),
+					"{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":{},\"tid\":{},\"args\":{{\"value\":{:.4f}}}}},\n",
+					Entry.Name,
+					Entry.Category,
+					timestamp,
+					m_ProcessId,
+					Entry.ThreadId,
+					Entry.Value);
+				break;
+			}
+		}
+
+		double GetTimestamp(std::chrono::steady_clock::time_point Time) const
+		{
+			return std::chrono::duration<double, std::micro>(Time - m_Epoch).count();
+		}
+	};
+
+	static Recorder *GetRecorder()
+	{
+		// Intentionally leaked. Joining the writer thread from DllMain's static destructors would deadlock on the
+		// loader lock.
+		const static auto recorder = []() -> Recorder *
+		{
+			if (!Config::Get()->EnableTracing)
+				return nullptr;
+
+			const auto path = Util::GetThisDllPath() + L"\\dlssg_to_fsr3_trace.json";
+			spdlog::info("Writing trace events to dlssg_to_fsr3_trace.json.");
+
+			return new Recorder(path);
+		}();
+
+		return recorder;
+	}
+
+	bool IsEnabled()
+	{
+		return GetRecorder() != nullptr;
+	}
+
+	void Flush()
+	{
+		if (auto recorder = GetRecorder())
+			recorder->Flush();
+	}
+
+	void AddComplete(
+		std::string_view Name,
+		const char *Category,
+		std::chrono::steady_clock::time_point Start,
+		std::chrono::steady_clock::time_point End)
+	{
+		if (auto recorder = GetRecorder())
+			recorder->Add('X', Name, Category, Start, End - Start, 0.0);
+	}
+
+	void AddInstant(std::string_view Name, const char *Category)
+	{
+		if (auto recorder = GetRecorder())
+			recorder->Add('i', Name, Category, std::chrono::steady_clock::now(), {}, 0.0);
+	}
+
+	void AddCounter(std::string_view Name, const char *Category, double Value)
+	{
+		if (auto recorder = GetRecorder())
+			recorder->Add('C', Name, Category, std::chrono::steady_clock::now(), {}, Value);
+	}
+
+	ScopedZone::ScopedZone(const char *Name, const char *Category)
+		: m_Name(Name),
+		  m_Category(Category),
+		  m_Start(IsEnabled() ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point {})
+	{
+	}
+
+	ScopedZone::~ScopedZone()
+	{
+		if (IsEnabled())
+			AddComplete(m_Name, m_Category, m_Start, std::chrono::steady_clock::now());
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+// Timeline of plugin activity in the Chrome trace-event format, viewable in chrome://tracing or ui.perfetto.dev.
+//
+// Zones compile to nothing unless DLSSGTOFSR3_ENABLE_TRACING is defined (CMake option BUILD_WITH_TRACING). At runtime
+// they're only recorded when EnableTracing is set. Events go to fixed size in-memory chunks that a writer thread
+// appends to dlssg_to_fsr3_trace.json. Events are dropped, not waited on, when the writer falls behind.
+namespace Trace
+{
+	constexpr size_t MaxNameLength = 47;
+
+	bool IsEnabled();
+	void Flush();
+
+	void AddComplete(
+		std::string_view Name,
+		const char *Category,
+		std::chrono::steady_clock::time_point Start,
+		std::chrono::steady_clock::time_point End);
+	void AddInstant(std::string_view Name, const char *Category);
+	void AddCounter(std::string_view Name, const char *Category, double Value);
+
+	class ScopedZone
+	{
+	private:
+		const char *const m_Name;
+		const char *const m_Category;
+		const std::chrono::steady_clock::time_point m_Start;
+
+	public:
+		ScopedZone(const char *Name, const char *Category);
+		ScopedZone(const ScopedZone&) = delete;
+		ScopedZone& operator=(const ScopedZone&) = delete;
+		~ScopedZone();
+	};
+}
+
+#if defined(DLSSGTOFSR3_ENABLE_TRACING)
+#define TRACE_CONCAT_IMPL(A, B) A##B
+#define TRACE_CONCAT(A, B) TRACE_CONCAT_IMPL(A, B)
+#define TRACE_ZONE(Category, Name) const Trace::ScopedZone TRACE_CONCAT(traceZone, __LINE__)(Name, Category)
+#define TRACE_INSTANT(Category, Name) Trace::AddInstant(Name, Category)
+#define TRACE_COUNTER(Category, Name, Value) Trace::AddCounter(Name, Category, Value)
+#define TRACE_FLUSH() Trace::Flush()
+#else
+#define TRACE_ZONE(Category, Name) ((void)0)
+#define TRACE_INSTANT(Category, Name) ((void)0)
+#define TRACE_COUNTER(Category, Name, Value) ((void)0)
+#define TRACE_FLUSH() ((void)0)
+#endif
@@ -1,5 +1,8 @@
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <Windows.h>
+#include <dxgi1_6.h>
+#include "Config.h"
 #include "Util.h"
 
 namespace Util
@@ -35,6 +38,94 @@ namespace Util
 		return finalPath;
 	}
 
+	std::optional<std::pair<float, float>> FindHDROutputLuminanceRange(const std::array<uint8_t, 8>& AdapterLUID)
+	{
+		// Microsoft DirectX 12 HDR sample
+		// https://github.com/microsoft/DirectX-Graphics-Samples/blob/b5f92e2251ee83db4d4c795b3cba5d470c52eaf8/Samples/Desktop/D3D12HDR/src/D3D12HDR.cpp#L1064
+		std::optional<std::pair<float, float>> range;
+
+		IDXGIFactory1 *factory = nullptr;
+		IDXGIAdapter1 *adapter = nullptr;
+		IDXGIOutput *output = nullptr;
+
+		if (CreateDXGIFactory1(IID_PPV_ARGS(&factory)) == S_OK)
+		{
+			// Match the active DXGI adapter
+			for (uint32_t i = 0; factory->EnumAdapters1(i, &adapter) == S_OK; i++)
+			{
+				DXGI_ADAPTER_DESC desc = {};
+				adapter->GetDesc(&desc);
+
+				static_assert(sizeof(AdapterLUID) == sizeof(desc.AdapterLuid));
+
+				if (memcmp(&desc.AdapterLuid, AdapterLUID.data(), AdapterLUID.size()) == 0)
+				{
+					// Then check the first HDR-capable output
+					for (uint32_t j = 0; adapter->EnumOutputs(j, &output) == S_OK; j++)
+					{
+						if (IDXGIOutput6 *output6; output->QueryInterface(IID_PPV_ARGS(&output6)) == S_OK)
+						{
+							DXGI_OUTPUT_DESC1 outputDesc = {};
+							output6->GetDesc1(&outputDesc);
+							output6->Release();
+
+							if (outputDesc.ColorSpace == DXGI_COLOR_SPACE_RGB_FULL_G2084_NONE_P2020 && !range)
+								range.emplace(outputDesc.MinLuminance, outputDesc.MaxLuminance);
+						}
+
+						output->Release();
+					}
+				}
+
+				adapter->Release();
+			}
+
+			factory->Release();
+		}
+
+		return range;
+	}
+
+	static std::atomic<uint64_t> RateLimitedMessageCount = 0;
+
+	bool LogRateLimiter::TryAcquire(uint32_t& OutSuppressedCount)
+	{
+		const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+		auto nextAllowedTime = m_NextAllowedTime.load(std::memory_order_relaxed);
+
+		if (now < nextAllowedTime ||
+			!m_NextAllowedTime.compare_exchange_strong(
+				nextAllowedTime,
+				now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(Interval).count(),
+				std::memory_order_relaxed))
+		{
+			m_SuppressedCount.fetch_add(1, std::memory_order_relaxed);
+			RateLimitedMessageCount.fetch_add(1, std::memory_order_relaxed);
+
+			return false;
+		}
+
+		OutSuppressedCount = m_SuppressedCount.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
+
+	void PinThisDll()
+	{
+		static bool once = []()
+		{
+			// FreeLibrary can't unmap us from under a running worker thread once pinned. Worker threads are never
+			// joined from DllMain since their exit needs the loader lock held there.
+			HMODULE thisModuleHandle = nullptr;
+
+			GetModuleHandleExW(
+				GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+				reinterpret_cast<LPCWSTR>(&PinThisDll),
+				&thisModuleHandle);
+
+			return true;
+		}();
+	}
+
 	void InitializeLog()
 	{
 		static bool once = []()
@@ -44,7 +135,27 @@ namespace Util
 
 			if (wcstombs_s(nullptr, convertedPath, fullPath.c_str(), std::size(convertedPath)) == 0)
 			{
-				auto logger = spdlog::basic_logger_mt("file_logger", convertedPath, true);
+				std::shared_ptr<spdlog::logger> logger;
+
+				if (Config::Get()->EnableSynchronousLogging)
+				{
+					logger = spdlog::basic_logger_mt("file_logger", convertedPath, true);
+				}
+				else
+				{
+					// Callers only pay for formatting and a queue push. Disk writes and flushes happen on the worker
+					// thread. A full queue overwrites the oldest messages rather than stalling the render thread.
+					spdlog::init_thread_pool(8192, 1);
+
+					// Intentionally leaked. The pool's destructor joins its worker, which would deadlock on the loader
+					// lock when the registry is torn down from DllMain. Its worker runs our code until the process
+					// exits, so the DLL has to stay mapped.
+					new std::shared_ptr(spdlog::thread_pool());
+					PinThisDll();
+
+					logger = spdlog::basic_logger_mt<spdlog::async_factory_nonblock>("file_logger", convertedPath, true);
+				}
+
 				logger->set_level(spdlog::level::level_enum::trace);
 				logger->set_pattern("[%H:%M:%S] [%l] %v"); // [HH:MM:SS] [Level] Message
 				logger->flush_on(logger->level());
@@ -55,15 +166,22 @@ namespace Util
 		}();
 	}
 
-	bool GetSetting(const wchar_t *Key, bool DefaultValue)
+	void FlushLog()
 	{
-		wchar_t envKey[256];
-		swprintf_s(envKey, L"DLSSGTOFSR3_%s", Key);
+		static std::atomic<uint64_t> reportedDroppedCount = 0;
+		const auto droppedCount = GetDroppedLogMessageCount();
+
+		if (reportedDroppedCount.exchange(droppedCount) != droppedCount)
+			spdlog::warn("{} log messages were dropped or rate limited so far.", droppedCount);
 
-		if (wchar_t v[2]; GetEnvironmentVariableW(envKey, v, std::size(v)) == 1)
-			return v[0] == L'1';
+		spdlog::default_logger_raw()->flush();
+	}
+
+	uint64_t GetDroppedLogMessageCount()
+	{
+		const auto threadPool = spdlog::thread_pool();
+		const auto overrunCount = threadPool ? threadPool->overrun_counter() : 0;
 
-		const static auto iniPath = GetThisDllPath() + L"\\dlssg_to_fsr3.ini";
-		return GetPrivateProfileIntW(L"Debug", Key, DefaultValue, iniPath.c_str()) != 0;
+		return overrunCount + RateLimitedMessageCount.load(std::memory_order_relaxed);
 	}
 }
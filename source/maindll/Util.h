@@ -1,7 +1,46 @@
 #pragma once
 
+#include <atomic>
+
 namespace Util
 {
+	// Lets one log call site through at most once per interval. Everything in between is counted and reported with
+	// the next message that does get through.
+	class LogRateLimiter
+	{
+	private:
+		std::atomic<int64_t> m_NextAllowedTime = 0;
+		std::atomic<uint32_t> m_SuppressedCount = 0;
+
+	public:
+		constexpr static std::chrono::milliseconds Interval { 1000 };
+
+		bool TryAcquire(uint32_t& OutSuppressedCount);
+	};
+
+	const std::wstring& GetThisDllPath();
+
+	// Minimum and maximum luminance in nits of the first HDR output connected to the adapter
+	std::optional<std::pair<float, float>> FindHDROutputLuminanceRange(const std::array<uint8_t, 8>& AdapterLUID);
+
+	// Keeps this DLL mapped until the process exits. Required before starting threads that outlive any API call.
+	void PinThisDll();
 	void InitializeLog();
-	bool GetSetting(const wchar_t *Key, bool DefaultValue);
+	void FlushLog();
+	uint64_t GetDroppedLogMessageCount();
 }
+
+// Per call site rate limiting for messages that can fire every frame
+#define LOG_RATE_LIMITED(Level, ...)                                                              \
+	do                                                                                            \
+	{                                                                                             \
+		static Util::LogRateLimiter logRateLimiter;                                               \
+                                                                                                  \
+		if (uint32_t suppressedCount; logRateLimiter.TryAcquire(suppressedCount))                 \
+		{                                                                                         \
+			spdlog::Level(__VA_ARGS__);                                                           \
+                                                                                                  \
+			if (suppressedCount > 0)                                                              \
+				spdlog::Level("Suppressed {} repeats of the previous message.", suppressedCount); \
+		}                                                                                         \
+	} while (0)
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <bit>
+#include <FidelityFX/host/ffx_util.h>
+#include "VRAMEstimator.h"
+
+namespace VRAMEstimator
+{
+	constexpr uint64_t ResourceAlignment = 64 * 1024; // Committed resources are placed at 64KB granularity
+	constexpr uint64_t DescriptorSize = 64;			  // Largest descriptor increment seen across vendors
+
+	constexpr uint32_t OpticalFlowPyramidLevels = 7;
+	constexpr uint32_t OpticalFlowBlockSize = 8;
+	constexpr uint32_t SCDHistogramTextureWidth = 256 * (3 * 3);
+
+	static uint64_t GetTextureSize(uint32_t Width, uint32_t Height, FfxSurfaceFormat Format, uint32_t MipCount = 1)
+	{
+		// A mip count of zero requests the full chain
+		if (MipCount == 0)
+			MipCount = static_cast<uint32_t>(std::bit_width(std::max(Width, Height)));
+
+		uint64_t size = 0;
+
+		for (uint32_t i = 0; i < MipCount; i++)
+		{
+			const uint64_t mipWidth = std::max(Width >> i, 1u);
+			const uint64_t mipHeight = std::max(Height >> i, 1u);
+
+			size += mipWidth * mipHeight * GetSurfaceFormatSize(Format);
+		}
+
+		return FFX_ALIGN_UP(size, ResourceAlignment);
+	}
+
+	static uint64_t GetFrameInterpolationContextSize(const Inputs& Inputs)
+	{
+		// FFInterpolator allocates render resolution resources at the display resolution
+		const auto [displayWidth, displayHeight] = Inputs.DisplaySize;
+		const auto [renderWidth, renderHeight] = Inputs.DisplaySize;
+
+		auto previousInterpolationSourceFormat = Inputs.BackbufferFormat;
+
+		if (Inputs.HUDLessFormat != FFX_SURFACE_FORMAT_UNKNOWN &&
+			GetSurfaceFormatSize(Inputs.HUDLessFormat) > GetSurfaceFormatSize(previousInterpolationSourceFormat))
+			previousInterpolationSourceFormat = Inputs.HUDLessFormat;
+
+		uint64_t size = 0;
+		size += GetTextureSize(renderWidth, renderHeight, FFX_SURFACE_FORMAT_R32_UINT) * 5; // Depth, game and OF vector fields
+		size += GetTextureSize(displayWidth / 2, displayHeight / 2, FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, 0);
+		size += GetTextureSize(8, 1, FFX_SURFACE_FORMAT_R8_UINT); // Counters
+		size += GetTextureSize(displayWidth, displayHeight, previousInterpolationSourceFormat);
+		size += GetTextureSize(displayWidth, displayHeight, FFX_SURFACE_FORMAT_R8_UNORM);
+		size += GetTextureSize(renderWidth, renderHeight, FFX_SURFACE_FORMAT_R8G8_UNORM);
+		size += GetTextureSize(1, 1, FFX_SURFACE_FORMAT_R8G8B8A8_SNORM);
+
+		return size;
+	}
+
+	static uint64_t GetFrameInterpolationSharedSize(const Inputs& Inputs)
+	{
+		// Created once by FFInterpolator and used by every cached context
+		const auto [renderWidth, renderHeight] = Inputs.DisplaySize;
+
+		uint64_t size = 0;
+		size += GetTextureSize(renderWidth, renderHeight, FFX_SURFACE_FORMAT_R32_FLOAT);
+		size += GetTextureSize(renderWidth, renderHeight, FFX_SURFACE_FORMAT_R16G16_FLOAT);
+		size += GetTextureSize(renderWidth, renderHeight, FFX_SURFACE_FORMAT_R32_UINT);
+
+		return size;
+	}
+
+	static uint64_t GetOpticalFlowContextSize(const Inputs& Inputs)
+	{
+		const auto [width, height] = Inputs.DisplaySize;
+		uint32_t flowWidth = (width + OpticalFlowBlockSize - 1) / OpticalFlowBlockSize;
+		uint32_t flowHeight = (height + OpticalFlowBlockSize - 1) / OpticalFlowBlockSize;
+
+		uint64_t size = 0;
+
+		// Luma and vector pyramids are ping-ponged between frames
+		for (uint32_t i = 0; i < OpticalFlowPyramidLevels; i++)
+		{
+			size += GetTextureSize(width >> i, height >> i, FFX_SURFACE_FORMAT_R8_UINT) * 2;
+			size += GetTextureSize(flowWidth, flowHeight, FFX_SURFACE_FORMAT_R16G16_SINT) * 2;
+
+			flowWidth = FFX_ALIGN_UP(flowWidth, 2) / 2;
+			flowHeight = FFX_ALIGN_UP(flowHeight, 2) / 2;
+		}
+
+		size += GetTextureSize(SCDHistogramTextureWidth, 1, FFX_SURFACE_FORMAT_R32_UINT);
+		size += GetTextureSize(SCDHistogramTextureWidth, 1, FFX_SURFACE_FORMAT_R32_FLOAT);
+		size += GetTextureSize(3, 1, FFX_SURFACE_FORMAT_R32_UINT);
+
+		// Shared resources
+		size += GetTextureSize(
+			(width + OpticalFlowBlockSize - 1) / OpticalFlowBlockSize,
+			(height + OpticalFlowBlockSize - 1) / OpticalFlowBlockSize,
+			FFX_SURFACE_FORMAT_R16G16_SINT);
+		size += GetTextureSize(3, 1, FFX_SURFACE_FORMAT_R32_UINT);
+
+		return size;
+	}
+
+	static uint64_t GetBackendSize(uint32_t MaxEffectContexts)
+	{
+		// Constant buffer rings plus the shader visible descriptor heaps
+		const uint64_t constantBufferSize = FFX_ALIGN_UP(FFX_BUFFER_SIZE, 256) * FFX_MAX_PASS_COUNT * FFX_MAX_QUEUED_FRAMES;
+		const uint64_t descriptorSize = (FFX_MAX_RESOURCE_COUNT + FFX_RING_BUFFER_DESCRIPTOR_COUNT) * DescriptorSize;
+
+		return FFX_ALIGN_UP((constantBufferSize + descriptorSize) * MaxEffectContexts, ResourceAlignment);
+	}
+
+	uint64_t EstimateFrameGeneration(const Inputs& Inputs)
+	{
+		if (Inputs.DisplaySize.width == 0 || Inputs.DisplaySize.height == 0)
+			return 0;
+
+		uint64_t size = 0;
+		size += GetFrameInterpolationContextSize(Inputs);
+		size += GetFrameInterpolationSharedSize(Inputs);
+		size += GetOpticalFlowContextSize(Inputs);
+		size += GetBackendSize(Inputs.SharedBackendContexts);
+		size += GetBackendSize(Inputs.FrameInterpolationBackendContexts);
+
+		return size;
+	}
+
+	bool IsPlausibleSwapchain(uint32_t SwapchainBufferCount, const Inputs& Inputs)
+	{
+		constexpr uint32_t MaxSwapchainBufferCount = 16;
+		constexpr uint32_t MaxSwapchainDimension = 16384;
+
+		const auto [width, height] = Inputs.DisplaySize;
+
+		return SwapchainBufferCount != 0 && SwapchainBufferCount <= MaxSwapchainBufferCount && width != 0 &&
+			   width <= MaxSwapchainDimension && height != 0 && height <= MaxSwapchainDimension &&
+			   Inputs.BackbufferFormat != FFX_SURFACE_FORMAT_UNKNOWN;
+	}
+
+	uint32_t GetSurfaceFormatSize(FfxSurfaceFormat Format)
+	{
+		switch (Format)
+		{
+		case FFX_SURFACE_FORMAT_R32G32B32A32_TYPELESS:
+		case FFX_SURFACE_FORMAT_R32G32B32A32_UINT:
+		case FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT:
+			return 16;
+
+		case FFX_SURFACE_FORMAT_R32G32B32_FLOAT:
+			return 12;
+
+		case FFX_SURFACE_FORMAT_R16G16B16A16_TYPELESS:
+		case FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT:
+		case FFX_SURFACE_FORMAT_R32G32_TYPELESS:
+		case FFX_SURFACE_FORMAT_R32G32_FLOAT:
+			return 8;
+
+		case FFX_SURFACE_FORMAT_R8_TYPELESS:
+		case FFX_SURFACE_FORMAT_R8_UINT:
+		case FFX_SURFACE_FORMAT_R8_UNORM:
+			return 1;
+
+		case FFX_SURFACE_FORMAT_R16_TYPELESS:
+		case FFX_SURFACE_FORMAT_R16_FLOAT:
+		case FFX_SURFACE_FORMAT_R16_UINT:
+		case FFX_SURFACE_FORMAT_R16_UNORM:
+		case FFX_SURFACE_FORMAT_R16_SNORM:
+		case FFX_SURFACE_FORMAT_R8G8_TYPELESS:
+		case FFX_SURFACE_FORMAT_R8G8_UNORM:
+		case FFX_SURFACE_FORMAT_R8G8_UINT:
+			return 2;
+
+		case FFX_SURFACE_FORMAT_UNKNOWN:
+			return 8; // Assume the worst case for color buffers
+
+		default:
+			return 4;
+		}
+	}
+}
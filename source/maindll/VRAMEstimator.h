@@ -0,0 +1,27 @@
+#pragma once
+
+#include <FidelityFX/host/ffx_types.h>
+
+// Predicts the device memory used by frame generation without creating a device or any contexts. The resource
+// tables mirror ffxFrameInterpolationContextCreate, ffxOpticalflowContextCreate and the backend constructors, so
+// keep them in sync when the SDK changes.
+namespace VRAMEstimator
+{
+	struct Inputs
+	{
+		FfxDimensions2D DisplaySize = {}; // Extent every context is allocated with
+		FfxSurfaceFormat BackbufferFormat = FFX_SURFACE_FORMAT_UNKNOWN;
+		FfxSurfaceFormat HUDLessFormat = FFX_SURFACE_FORMAT_UNKNOWN;
+		uint32_t SharedBackendContexts = 0; // Effect contexts each backend interface is created for
+		uint32_t FrameInterpolationBackendContexts = 0;
+	};
+
+	// Memory a feature holds while interpolating: the active context, the resources all of its contexts share,
+	// optical flow and the backends. Extra cached contexts only exist after the game switches settings and aren't
+	// counted.
+	uint64_t EstimateFrameGeneration(const Inputs& Inputs);
+
+	// NGX doesn't document the EstimateVRAM callback arguments. Rejects descriptions that can't be a swapchain.
+	bool IsPlausibleSwapchain(uint32_t SwapchainBufferCount, const Inputs& Inputs);
+	uint32_t GetSurfaceFormatSize(FfxSurfaceFormat Format);
+}
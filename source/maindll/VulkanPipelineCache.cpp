@@ -0,0 +1,149 @@
+#include <format>
+#include "Config.h"
+#include "VulkanPipelineCache.h"
+#include "VulkanPipelineCacheFile.h"
+#include "Util.h"
+
+struct PipelineCacheEntry
+{
+	VkPipelineCache Cache = VK_NULL_HANDLE;
+	VulkanPipelineCacheFile::DeviceIdentity Device = {};
+	std::filesystem::path Path;
+	uint32_t ReferenceCount = 0;
+	size_t SavedDataSize = 0;
+};
+
+static_assert(VulkanPipelineCacheFile::UUIDSize == VK_UUID_SIZE);
+static_assert(sizeof(VulkanPipelineCacheFile::DataHeader) == sizeof(VkPipelineCacheHeaderVersionOne));
+static_assert(offsetof(VulkanPipelineCacheFile::DataHeader, PipelineCacheUUID) == offsetof(VkPipelineCacheHeaderVersionOne, pipelineCacheUUID));
+
+static std::mutex CacheLock;
+static std::unordered_map<VkDevice, PipelineCacheEntry> CacheEntries;
+
+static std::vector<uint8_t> LoadCacheData(const std::filesystem::path& Path, const VulkanPipelineCacheFile::DeviceIdentity& Device)
+{
+	using Status = VulkanPipelineCacheFile::Status;
+
+	std::vector<uint8_t> data;
+
+	switch (VulkanPipelineCacheFile::Load(Path, Device, &data))
+	{
+	case Status::Unrecognized:
+		spdlog::warn("Ignoring unrecognized Vulkan pipeline cache file.");
+		break;
+
+	case Status::DifferentDevice:
+		spdlog::info("Ignoring Vulkan pipeline cache file from a different GPU or driver.");
+		break;
+
+	case Status::Corrupt:
+		spdlog::warn("Ignoring truncated or corrupt Vulkan pipeline cache file.");
+		break;
+
+	default:
+		break;
+	}
+
+	return data;
+}
+
+static void SaveCacheData(VkDevice Device, PipelineCacheEntry& Entry)
+{
+	// Caches only ever grow. An unchanged size means nothing was added.
+	size_t dataSize = 0;
+
+	if (vkGetPipelineCacheData(Device, Entry.Cache, &dataSize, nullptr) != VK_SUCCESS || dataSize <= Entry.SavedDataSize)
+		return;
+
+	std::vector<uint8_t> data(dataSize);
+
+	if (vkGetPipelineCacheData(Device, Entry.Cache, &dataSize, data.data()) != VK_SUCCESS)
+		return;
+
+	data.resize(dataSize);
+
+	if (!VulkanPipelineCacheFile::Save(Entry.Path, Entry.Device, data))
+		return;
+
+	Entry.SavedDataSize = data.size();
+	spdlog::info("Saved {} bytes of Vulkan pipeline cache data.", data.size());
+}
+
+VkPipelineCache VulkanPipelineCache::Acquire(VkDevice Device, VkPhysicalDevice PhysicalDevice)
+{
+	std::scoped_lock lock(CacheLock);
+
+	if (auto itr = CacheEntries.find(Device); itr != CacheEntries.end())
+	{
+		itr->second.ReferenceCount++;
+		return itr->second.Cache;
+	}
+
+	if (!Config::Get()->EnableVulkanPipelineCache)
+		return VK_NULL_HANDLE;
+
+	VkPhysicalDeviceProperties properties = {};
+	vkGetPhysicalDeviceProperties(PhysicalDevice, &properties);
+
+	PipelineCacheEntry entry = {};
+	entry.Device.VendorID = properties.vendorID;
+	entry.Device.DeviceID = properties.deviceID;
+	entry.Device.DriverVersion = properties.driverVersion;
+	std::ranges::copy(properties.pipelineCacheUUID, entry.Device.PipelineCacheUUID.begin());
+
+	entry.Path = Util::GetThisDllPath() +
+				 std::format(L"\\dlssg_to_fsr3_vk_pipelines_{:04X}_{:04X}.bin", properties.vendorID, properties.deviceID);
+
+	const auto initialData = LoadCacheData(entry.Path, entry.Device);
+
+	VkPipelineCacheCreateInfo createInfo = {
+		.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+		.initialDataSize = initialData.size(),
+		.pInitialData = initialData.data(),
+	};
+
+	if (vkCreatePipelineCache(Device, &createInfo, nullptr, &entry.Cache) != VK_SUCCESS)
+	{
+		// Retry empty in case the driver refused the data
+		createInfo.initialDataSize = 0;
+		createInfo.pInitialData = nullptr;
+
+		if (initialData.empty() || vkCreatePipelineCache(Device, &createInfo, nullptr, &entry.Cache) != VK_SUCCESS)
+		{
+			spdlog::error("Failed to create a Vulkan pipeline cache.");
+			return VK_NULL_HANDLE;
+		}
+	}
+	else
+	{
+		entry.SavedDataSize = initialData.size();
+	}
+
+	spdlog::info("Created Vulkan pipeline cache with {} bytes of initial data.", entry.SavedDataSize);
+
+	entry.ReferenceCount = 1;
+	return CacheEntries.emplace(Device, std::move(entry)).first->second.Cache;
+}
+
+void VulkanPipelineCache::Release(VkDevice Device)
+{
+	std::scoped_lock lock(CacheLock);
+
+	const auto itr = CacheEntries.find(Device);
+
+	if (itr == CacheEntries.end() || --itr->second.ReferenceCount > 0)
+		return;
+
+	SaveCacheData(Device, itr->second);
+	vkDestroyPipelineCache(Device, itr->second.Cache, nullptr);
+
+	CacheEntries.erase(itr);
+}
+
+void VulkanPipelineCache::Save(VkDevice Device)
+{
+	std::scoped_lock lock(CacheLock);
+
+	if (const auto itr = CacheEntries.find(Device); itr != CacheEntries.end())
+		SaveCacheData(Device, itr->second);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+// Keeps compiled FFX compute pipelines across launches. Each device gets one VkPipelineCache, seeded from
+// dlssg_to_fsr3_vk_pipelines_<vendor>_<device>.bin and shared by every backend interface on that device. Files
+// written by another driver, GPU or build, as well as truncated or corrupt ones, are ignored and replaced on the
+// next save. See VulkanPipelineCacheFile for the checks.
+class VulkanPipelineCache
+{
+public:
+	// Returns VK_NULL_HANDLE when disabled or when the cache couldn't be created. Every successful call must be paired
+	// with Release.
+	static VkPipelineCache Acquire(VkDevice Device, VkPhysicalDevice PhysicalDevice);
+	static void Release(VkDevice Device);
+
+	// Writes the cache to disk if it grew since it was loaded or last saved
+	static void Save(VkDevice Device);
+};
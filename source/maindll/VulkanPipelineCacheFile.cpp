@@ -0,0 +1,119 @@
+#include "VulkanPipelineCacheFile.h"
+
+static bool MatchesDevice(uint32_t VendorID, uint32_t DeviceID, const uint8_t *UUID, const VulkanPipelineCacheFile::DeviceIdentity& Device)
+{
+	return VendorID == Device.VendorID && DeviceID == Device.DeviceID &&
+		   memcmp(UUID, Device.PipelineCacheUUID.data(), Device.PipelineCacheUUID.size()) == 0;
+}
+
+VulkanPipelineCacheFile::Status VulkanPipelineCacheFile::Load(
+	const std::filesystem::path& Path,
+	const DeviceIdentity& Device,
+	std::vector<uint8_t> *OutData)
+{
+	OutData->clear();
+
+	std::error_code ec;
+	const auto fileSize = std::filesystem::file_size(Path, ec);
+
+	if (ec)
+		return Status::Missing;
+
+	if (fileSize > sizeof(FileHeader) + MaxDataSize)
+		return Status::Corrupt;
+
+	std::ifstream file(Path, std::ios::binary);
+	std::vector<uint8_t> contents(static_cast<size_t>(fileSize));
+
+	if (!file.read(reinterpret_cast<char *>(contents.data()), contents.size()))
+		return Status::Missing;
+
+	return Parse(contents, Device, OutData);
+}
+
+VulkanPipelineCacheFile::Status VulkanPipelineCacheFile::Parse(
+	std::span<const uint8_t> File,
+	const DeviceIdentity& Device,
+	std::vector<uint8_t> *OutData)
+{
+	OutData->clear();
+	FileHeader header = {};
+
+	if (File.size() < sizeof(header))
+		return File.empty() ? Status::Unrecognized : Status::Corrupt;
+
+	memcpy(&header, File.data(), sizeof(header));
+
+	if (memcmp(header.Magic, FileMagic, sizeof(header.Magic)) != 0 || header.Version != FileVersion)
+		return Status::Unrecognized;
+
+	if (!MatchesDevice(header.VendorID, header.DeviceID, header.PipelineCacheUUID, Device) ||
+		header.DriverVersion != Device.DriverVersion)
+		return Status::DifferentDevice;
+
+	const auto data = File.subspan(sizeof(header));
+
+	if (header.DataSize < sizeof(DataHeader) || header.DataSize > MaxDataSize || header.DataSize != data.size() ||
+		HashData(data) != header.DataHash)
+		return Status::Corrupt;
+
+	// Drivers are supposed to validate this as well. Not all of them do so gracefully.
+	DataHeader dataHeader = {};
+	memcpy(&dataHeader, data.data(), sizeof(dataHeader));
+
+	if (dataHeader.HeaderSize < sizeof(dataHeader) || dataHeader.HeaderVersion != 1 ||
+		!MatchesDevice(dataHeader.VendorID, dataHeader.DeviceID, dataHeader.PipelineCacheUUID, Device))
+		return Status::Corrupt;
+
+	OutData->assign(data.begin(), data.end());
+	return Status::Loaded;
+}
+
+bool VulkanPipelineCacheFile::Save(const std::filesystem::path& Path, const DeviceIdentity& Device, std::span<const uint8_t> Data)
+{
+	FileHeader header = {};
+	memcpy(header.Magic, FileMagic, sizeof(header.Magic));
+	header.Version = FileVersion;
+	header.VendorID = Device.VendorID;
+	header.DeviceID = Device.DeviceID;
+	header.DriverVersion = Device.DriverVersion;
+	memcpy(header.PipelineCacheUUID, Device.PipelineCacheUUID.data(), sizeof(header.PipelineCacheUUID));
+	header.DataSize = Data.size();
+	header.DataHash = HashData(Data);
+
+	auto temporaryPath = Path;
+	temporaryPath += ".tmp";
+
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char *>(Data.data()), Data.size());
+
+		if (!file.flush())
+		{
+			spdlog::warn("Failed to write Vulkan pipeline cache file.");
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(temporaryPath, Path, ec);
+
+	if (ec)
+	{
+		spdlog::warn("Failed to replace Vulkan pipeline cache file: {}", ec.message());
+		return false;
+	}
+
+	return true;
+}
+
+uint64_t VulkanPipelineCacheFile::HashData(std::span<const uint8_t> Data)
+{
+	uint64_t hash = 0xCBF29CE484222325;
+
+	for (const auto byte : Data)
+		hash = (hash ^ byte) * 0x100000001B3;
+
+	return hash;
+}
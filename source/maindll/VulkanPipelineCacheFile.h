@@ -0,0 +1,66 @@
+#pragma once
+
+#include <span>
+
+// On-disk format of VulkanPipelineCache. A FileHeader identifying the device and driver is followed by the
+// vkGetPipelineCacheData blob. Free of Vulkan and OS calls so the validation can be tested on any host.
+class VulkanPipelineCacheFile
+{
+public:
+	constexpr static char FileMagic[8] = { 'D', 'L', 'S', 'S', 'G', 'P', 'S', 'O' };
+	constexpr static uint32_t FileVersion = 1;
+	constexpr static uint32_t UUIDSize = 16; // VK_UUID_SIZE
+
+	// Anything larger is assumed to be garbage
+	constexpr static uint64_t MaxDataSize = 256 * 1024 * 1024;
+
+	// The parts of VkPhysicalDeviceProperties a cache is only valid for
+	struct DeviceIdentity
+	{
+		uint32_t VendorID;
+		uint32_t DeviceID;
+		uint32_t DriverVersion;
+		std::array<uint8_t, UUIDSize> PipelineCacheUUID;
+	};
+
+	struct FileHeader
+	{
+		char Magic[8];
+		uint32_t Version;
+		uint32_t VendorID;
+		uint32_t DeviceID;
+		uint32_t DriverVersion;
+		uint8_t PipelineCacheUUID[UUIDSize];
+		uint64_t DataSize;
+		uint64_t DataHash; // FNV-1a of the vkGetPipelineCacheData blob that follows
+	};
+
+	// Same layout as VkPipelineCacheHeaderVersionOne, which starts every blob
+	struct DataHeader
+	{
+		uint32_t HeaderSize;
+		uint32_t HeaderVersion; // VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+		uint32_t VendorID;
+		uint32_t DeviceID;
+		uint8_t PipelineCacheUUID[UUIDSize];
+	};
+
+	enum class Status
+	{
+		Loaded,
+		Missing,
+		Unrecognized,	 // Not a cache file or written by a different plugin version
+		DifferentDevice, // Another GPU, driver or driver build
+		Corrupt,		 // Truncated, hash mismatch or a blob the driver would have to reject
+	};
+
+	// Only hands out data whose blob header matches Device as well, since not every driver rejects foreign data
+	// gracefully
+	static Status Load(const std::filesystem::path& Path, const DeviceIdentity& Device, std::vector<uint8_t> *OutData);
+	static Status Parse(std::span<const uint8_t> File, const DeviceIdentity& Device, std::vector<uint8_t> *OutData);
+
+	// Writes a temporary and swaps it in, so an interrupted save can't take out a good cache
+	static bool Save(const std::filesystem::path& Path, const DeviceIdentity& Device, std::span<const uint8_t> Data);
+
+	static uint64_t HashData(std::span<const uint8_t> Data);
+};
@@ -0,0 +1,437 @@
+#include <map>
+#include "DLSSGFrameInputs.h"
+#include "FakeShaderBlobs.h"
+#include "FFBackendPool.h"
+#include "FFInterpolator.h"
+#include "FFRecordingInterface.h"
+#include "FrameCaptureReader.h"
+#include "VRAMEstimator.h"
+
+//
+// Offline tool for captures written with EnableFrameCapture:
+//
+//   dlssg_to_fsr3_capture_replay info <capture>
+//   dlssg_to_fsr3_capture_replay extract <capture> <directory>
+//   dlssg_to_fsr3_capture_replay replay <capture>
+//
+// extract writes each texture without row padding to frame<N>_<texture>_<width>x<height>_<FfxSurfaceFormat>.raw.
+//
+// replay feeds every frame's parameters through FFInterpolator on FFRecordingInterface, the same way the plugin builds
+// them, and reports the passes, dispatches and host time of each frame. Shaders aren't run. The FidelityFX shader
+// permutations and GPU backends are only built by the Windows SDK toolchain.
+//
+constexpr std::array<const char *, FrameCapture::TextureCount> TextureNames = { "Backbuffer", "HUDLess", "Depth", "MVecs" };
+
+static std::string ToNarrow(std::wstring_view Text)
+{
+	std::string narrow;
+
+	for (auto c : Text)
+		narrow.push_back(c < 0x80 ? static_cast<char>(c) : '?');
+
+	return narrow;
+}
+
+static int PrintInfo(FrameCaptureReader& Reader)
+{
+	spdlog::info("{} frames{}", Reader.GetFrameCount(), Reader.HasIndex() ? "" : ", no index (capture was cut short)");
+
+	for (uint32_t i = 0; i < Reader.GetFrameCount(); i++)
+	{
+		const auto record = Reader.ReadRecord(i);
+		std::string textures;
+
+		for (uint32_t j = 0; j < FrameCapture::TextureCount; j++)
+		{
+			const auto& texture = record.Textures[j];
+
+			if (texture.RowPitch != 0)
+				textures += fmt::format(" {} {}x{} format {}", TextureNames[j], texture.Width, texture.Height, texture.Format);
+		}
+
+		spdlog::info(
+			"Frame {} (source frame {}, {:.3f}s): flags {:#x}, multi frame count {}, jitter {} {}, mvec scale {} {},{}",
+			record.FrameIndex,
+			record.SourceFrameIndex,
+			record.HostTime,
+			record.Flags,
+			record.MultiFrameCount,
+			record.JitterOffset[0],
+			record.JitterOffset[1],
+			record.MvecScale[0],
+			record.MvecScale[1],
+			textures);
+	}
+
+	return 0;
+}
+
+static int Extract(FrameCaptureReader& Reader, const std::filesystem::path& Directory)
+{
+	std::filesystem::create_directories(Directory);
+
+	for (uint32_t i = 0; i < Reader.GetFrameCount(); i++)
+	{
+		const auto frame = Reader.ReadFrame(i);
+
+		for (uint32_t j = 0; j < FrameCapture::TextureCount; j++)
+		{
+			const auto& texture = frame.Record.Textures[j];
+
+			if (frame.Textures[j].empty())
+				continue;
+
+			const auto rowSize = static_cast<size_t>(texture.Width) *
+				VRAMEstimator::GetSurfaceFormatSize(static_cast<FfxSurfaceFormat>(texture.Format));
+			const auto path = Directory /
+				fmt::format("frame{:04}_{}_{}x{}_{}.raw", i, TextureNames[j], texture.Width, texture.Height, texture.Format);
+
+			std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+			for (uint32_t row = 0; row < texture.Height; row++)
+				file.write(reinterpret_cast<const char *>(frame.Textures[j].data()) + static_cast<size_t>(row) * texture.RowPitch, rowSize);
+
+			if (!file)
+			{
+				spdlog::error("Failed to write {}.", path.string());
+				return 1;
+			}
+		}
+	}
+
+	spdlog::info("Extracted {} frames to {}.", Reader.GetFrameCount(), Directory.string());
+	return 0;
+}
+
+class CaptureReplayer
+{
+private:
+	FFRecordingInterface m_FrameInterpolationRecording;
+	FFRecordingInterface m_SharedRecording;
+	FFBackendInterfaces m_Backend;
+	std::optional<FFInterpolator> m_Interpolator;
+	DLSSGFrameInputs m_FrameInputs;
+
+	// Stand-ins for game resources. Only the addresses are used.
+	std::array<uint32_t, FrameCapture::TextureCount + 3> m_GameResources = {};
+
+	struct PassTotals
+	{
+		uint64_t DispatchCount = 0;
+		uint64_t ThreadGroupCount = 0;
+	};
+
+	std::map<std::string, PassTotals> m_PassTotals;
+
+public:
+	bool Initialize(uint32_t MaxWidth, uint32_t MaxHeight)
+	{
+		if (m_FrameInterpolationRecording.Initialize(FakeShaderBlobs::GetPermutationBlob, 8) != FFX_OK ||
+			m_SharedRecording.Initialize(FakeShaderBlobs::GetPermutationBlob, 2) != FFX_OK)
+			return false;
+
+		static_cast<FfxInterface&>(m_Backend.FrameInterpolation) = m_FrameInterpolationRecording;
+		static_cast<FfxInterface&>(m_Backend.Shared) = m_SharedRecording;
+		m_Backend.MaxCachedContexts = 2;
+
+		FfxUInt32 sharedEffectContextId = 0;
+
+		if (m_SharedRecording.fpCreateBackendContext(&m_SharedRecording, FFX_EFFECT_SHAREDRESOURCES, nullptr, &sharedEffectContextId) != FFX_OK)
+			return false;
+
+		m_Interpolator.emplace(m_Backend, sharedEffectContextId, MaxWidth, MaxHeight);
+		return true;
+	}
+
+	~CaptureReplayer()
+	{
+		if (m_Interpolator)
+			m_Interpolator->WaitForContextCreation();
+	}
+
+	bool ReplayFrame(const FrameCapture::FrameRecord& Record, bool ResetHistory)
+	{
+		FFInterpolatorDispatchParameters parameters = {};
+
+		if (!BuildParameters(Record, &parameters))
+		{
+			spdlog::warn("Frame {}: Depth, MVecs or a color input wasn't captured. Skipped.", Record.FrameIndex);
+			return false;
+		}
+
+		parameters.Reset = parameters.Reset || ResetHistory;
+
+		const uint32_t multiFrameCount = std::max(Record.MultiFrameCount, 1u);
+
+		for (uint32_t multiFrameIndex = 1; multiFrameIndex <= multiFrameCount; multiFrameIndex++)
+		{
+			parameters.InterpolationFactor = static_cast<float>(multiFrameIndex) / (multiFrameCount + 1);
+			parameters.PrepareInputs = multiFrameIndex == 1;
+			parameters.StoreInterpolationSource = multiFrameIndex == multiFrameCount;
+
+			m_FrameInterpolationRecording.ResetLog();
+
+			// The plugin passes frames through while a context is built. Replays wait instead so no frame is lost.
+			auto start = std::chrono::steady_clock::now();
+			auto status = m_Interpolator->Dispatch(parameters);
+
+			if (status == FFX_EOF)
+			{
+				m_Interpolator->WaitForContextCreation();
+				spdlog::info("Frame {}: built interpolation context.", Record.FrameIndex);
+
+				start = std::chrono::steady_clock::now();
+				status = m_Interpolator->Dispatch(parameters);
+			}
+
+			const auto hostMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			if (status != FFX_OK)
+			{
+				spdlog::error("Frame {}: dispatch failed with {:#x}.", Record.FrameIndex, static_cast<uint32_t>(status));
+				return false;
+			}
+
+			ReportDispatch(Record.FrameIndex, multiFrameIndex, hostMilliseconds);
+		}
+
+		return true;
+	}
+
+	void PrintSummary(uint32_t FrameCount) const
+	{
+		spdlog::info("Per pass totals over {} frames:", FrameCount);
+
+		for (const auto& [label, totals] : m_PassTotals)
+			spdlog::info("  {:<56} {:>6} dispatches {:>12} thread groups", label, totals.DispatchCount, totals.ThreadGroupCount);
+	}
+
+private:
+	FfxResource MakeTexture(uint32_t ResourceIndex, FfxSurfaceFormat Format, uint32_t Width, uint32_t Height, FfxResourceStates State)
+	{
+		FfxResource resource = {};
+		resource.resource = &m_GameResources[ResourceIndex];
+		resource.description.type = FFX_RESOURCE_TYPE_TEXTURE2D;
+		resource.description.format = Format;
+		resource.description.width = Width;
+		resource.description.height = Height;
+		resource.description.depth = 1;
+		resource.description.mipCount = 1;
+		resource.state = State;
+
+		return resource;
+	}
+
+	FfxResource MakeCapturedTexture(uint32_t TextureIndex, const FrameCapture::FrameRecord& Record)
+	{
+		const auto& texture = Record.Textures[TextureIndex];
+
+		if (texture.RowPitch == 0)
+			return {};
+
+		return MakeTexture(TextureIndex, static_cast<FfxSurfaceFormat>(texture.Format), texture.Width, texture.Height, FFX_RESOURCE_STATE_COPY_DEST);
+	}
+
+	// Mirrors FFFrameInterpolator::CalculateResourceDimensions and BuildFrameInterpolationParameters
+	bool BuildParameters(const FrameCapture::FrameRecord& Record, FFInterpolatorDispatchParameters *OutParameters)
+	{
+		auto& desc = *OutParameters;
+
+		desc.InputColorBuffer = MakeCapturedTexture(0, Record);
+		desc.InputHUDLessColorBuffer = MakeCapturedTexture(1, Record);
+		desc.InputDepth = MakeCapturedTexture(2, Record);
+		desc.InputMotionVectors = MakeCapturedTexture(3, Record);
+
+		const auto& color = desc.InputColorBuffer.resource ? desc.InputColorBuffer : desc.InputHUDLessColorBuffer;
+
+		if (!color.resource || !desc.InputDepth.resource || !desc.InputMotionVectors.resource)
+			return false;
+
+		const uint32_t outputWidth = color.description.width;
+		const uint32_t outputHeight = color.description.height;
+
+		desc.RenderSize = { Record.DepthSubrect[0], Record.DepthSubrect[1] };
+
+		if (desc.RenderSize.width == 0 || desc.RenderSize.height == 0)
+			desc.RenderSize = { desc.InputDepth.description.width, desc.InputDepth.description.height };
+
+		desc.OutputSize = { outputWidth, outputHeight };
+		desc.InterpolationRect = { 0, 0, static_cast<int32_t>(outputWidth), static_cast<int32_t>(outputHeight) };
+
+		const bool useHUDLessSubrect = desc.InputHUDLessColorBuffer.resource &&
+			desc.InputHUDLessColorBuffer.description.width == outputWidth &&
+			desc.InputHUDLessColorBuffer.description.height == outputHeight &&
+			Record.HUDLessSubrectBase[0] >= 0 &&
+			Record.HUDLessSubrectBase[1] >= 0 &&
+			Record.HUDLessSubrect[0] != 0 &&
+			Record.HUDLessSubrect[1] != 0 &&
+			Record.HUDLessSubrectBase[0] + Record.HUDLessSubrect[0] <= outputWidth &&
+			Record.HUDLessSubrectBase[1] + Record.HUDLessSubrect[1] <= outputHeight;
+
+		if (useHUDLessSubrect)
+		{
+			desc.InterpolationRect = {
+				Record.HUDLessSubrectBase[0],
+				Record.HUDLessSubrectBase[1],
+				static_cast<int32_t>(Record.HUDLessSubrect[0]),
+				static_cast<int32_t>(Record.HUDLessSubrect[1]),
+			};
+		}
+
+		// Optical flow runs on the shared backend in the plugin. Only its outputs are needed here.
+		desc.InputOpticalFlowVector = MakeTexture(4, FFX_SURFACE_FORMAT_R16G16_SINT, outputWidth / 8, outputHeight / 8, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+		desc.InputOpticalFlowSceneChangeDetection = MakeTexture(5, FFX_SURFACE_FORMAT_R32_UINT, 3, 1, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+		desc.OutputInterpolatedColorBuffer = MakeTexture(6, color.description.format, outputWidth, outputHeight, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+
+		desc.OpticalFlowScale = { 1.0f / desc.InterpolationRect.width, 1.0f / desc.InterpolationRect.height };
+		desc.OpticalFlowBlockSize = 8;
+
+		FfxDimensions2D mvecExtents = { Record.MVecsSubrect[0], Record.MVecsSubrect[1] };
+
+		if (mvecExtents.width == 0 ||
+			mvecExtents.width > desc.InputMotionVectors.description.width ||
+			mvecExtents.height == 0 ||
+			mvecExtents.height > desc.InputMotionVectors.description.height)
+		{
+			mvecExtents.width = desc.InputMotionVectors.description.width;
+			mvecExtents.height = desc.InputMotionVectors.description.height;
+		}
+
+		desc.MotionVectorsFullResolution = static_cast<uint32_t>(desc.InterpolationRect.width) == mvecExtents.width &&
+			static_cast<uint32_t>(desc.InterpolationRect.height) == mvecExtents.height;
+		desc.MotionVectorJitterCancellation = (Record.Flags & FrameCapture::FrameFlagMvecJittered) != 0;
+		desc.MotionVectorsDilated = (Record.Flags & FrameCapture::FrameFlagMvecDilated) != 0;
+		desc.MotionVectorScale = { Record.MvecScale[0], Record.MvecScale[1] };
+		desc.MotionVectorJitterOffsets = { Record.JitterOffset[0], Record.JitterOffset[1] };
+
+		desc.HDR = (Record.Flags & FrameCapture::FrameFlagHDR) != 0;
+		desc.DepthInverted = (Record.Flags & FrameCapture::FrameFlagDepthInverted) != 0;
+		desc.Reset = (Record.Flags & FrameCapture::FrameFlagReset) != 0;
+
+		auto& camera = m_FrameInputs.Camera;
+		camera.OrthoProjection = (Record.Flags & FrameCapture::FrameFlagOrthoProjection) != 0;
+		camera.DepthInverted = desc.DepthInverted;
+		camera.ViewToClipValid = (Record.Flags & FrameCapture::FrameFlagViewToClipValid) != 0;
+		memcpy(camera.ViewToClip, Record.ViewToClip, sizeof(camera.ViewToClip));
+		camera.FOV = Record.FOV;
+		camera.Near = Record.Near;
+		camera.Far = Record.Far;
+
+		const auto& cameraParameters = m_FrameInputs.GetCameraParameters();
+		desc.CameraNear = cameraParameters.Near;
+		desc.CameraFar = cameraParameters.Far;
+		desc.CameraFovAngleVertical = cameraParameters.FovAngleVertical;
+		desc.DepthPlaneInfinite = cameraParameters.DepthPlaneInfinite;
+
+		desc.MinMaxLuminance = { 0.0001f, 1000.0f };
+
+		return true;
+	}
+
+	void ReportDispatch(uint32_t FrameIndex, uint32_t MultiFrameIndex, double HostMilliseconds)
+	{
+		const auto& log = m_FrameInterpolationRecording.GetLog();
+		std::map<std::string, PassTotals> passes;
+
+		for (const auto& job : log.Jobs)
+		{
+			if (job.Type != FFX_GPU_JOB_COMPUTE)
+				continue;
+
+			const auto groups = static_cast<uint64_t>(job.Dimensions[0]) * job.Dimensions[1] * job.Dimensions[2];
+			auto& pass = passes[ToNarrow(job.Label)];
+			pass.DispatchCount++;
+			pass.ThreadGroupCount += groups;
+		}
+
+		spdlog::info(
+			"Frame {}.{}: {} dispatches, {} jobs, {:.3f} ms host",
+			FrameIndex,
+			MultiFrameIndex,
+			log.GetTotals().DispatchCount,
+			log.Jobs.size(),
+			HostMilliseconds);
+
+		for (const auto& [label, totals] : passes)
+		{
+			spdlog::info("  {:<56} {:>3} dispatches {:>10} thread groups", label, totals.DispatchCount, totals.ThreadGroupCount);
+
+			auto& summary = m_PassTotals[label];
+			summary.DispatchCount += totals.DispatchCount;
+			summary.ThreadGroupCount += totals.ThreadGroupCount;
+		}
+	}
+};
+
+static int Replay(FrameCaptureReader& Reader)
+{
+	uint32_t maxWidth = 0;
+	uint32_t maxHeight = 0;
+
+	for (uint32_t i = 0; i < Reader.GetFrameCount(); i++)
+	{
+		for (const auto& texture : Reader.ReadRecord(i).Textures)
+		{
+			maxWidth = std::max(maxWidth, texture.Width);
+			maxHeight = std::max(maxHeight, texture.Height);
+		}
+	}
+
+	CaptureReplayer replayer;
+
+	if (!replayer.Initialize(maxWidth, maxHeight))
+	{
+		spdlog::error("Failed to create the recording backend.");
+		return 1;
+	}
+
+	uint32_t replayedFrames = 0;
+	uint32_t previousSourceFrame = 0;
+
+	for (uint32_t i = 0; i < Reader.GetFrameCount(); i++)
+	{
+		const auto record = Reader.ReadRecord(i);
+
+		// Frames dropped during capture leave a gap that history can't bridge
+		const bool resetHistory = i == 0 || record.SourceFrameIndex != previousSourceFrame + 1;
+		previousSourceFrame = record.SourceFrameIndex;
+
+		if (replayer.ReplayFrame(record, resetHistory))
+			replayedFrames++;
+	}
+
+	replayer.PrintSummary(replayedFrames);
+	return replayedFrames == Reader.GetFrameCount() ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+	spdlog::set_pattern("%v");
+
+	const std::vector<std::string_view> arguments(argv + 1, argv + argc);
+	const auto command = arguments.empty() ? std::string_view() : arguments[0];
+
+	if (arguments.size() < 2 || (command == "extract" && arguments.size() < 3) ||
+		(command != "info" && command != "extract" && command != "replay"))
+	{
+		spdlog::error("Usage: {} info|replay <capture> | extract <capture> <directory>", argc > 0 ? argv[0] : "dlssg_to_fsr3_capture_replay");
+		return 2;
+	}
+
+	try
+	{
+		FrameCaptureReader reader(arguments[1]);
+
+		if (command == "info")
+			return PrintInfo(reader);
+		else if (command == "extract")
+			return Extract(reader, arguments[2]);
+		else
+			return Replay(reader);
+	}
+	catch (const std::exception& e)
+	{
+		spdlog::error("{}", e.what());
+		return 1;
+	}
+}
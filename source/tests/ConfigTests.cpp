@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "Config.h"
+
+static std::optional<std::string> NoEnvironment(std::string_view)
+{
+	return std::nullopt;
+}
+
+static Configuration ParseWithEnvironment(std::string_view IniText, std::map<std::string, std::string, std::less<>> Environment)
+{
+	return Config::Parse(
+		IniText,
+		[&](std::string_view Key) -> std::optional<std::string>
+		{
+			if (auto itr = Environment.find(Key); itr != Environment.end())
+				return itr->second;
+
+			return std::nullopt;
+		});
+}
+
+TEST(Config, EmptyFileKeepsDefaults)
+{
+	EXPECT_EQ(Config::Parse("", NoEnvironment), Configuration {});
+	EXPECT_EQ(Config::Parse("\xEF\xBB\xBF", NoEnvironment), Configuration {});
+}
+
+TEST(Config, ReadsDebugSectionOnly)
+{
+	const auto config = Config::Parse(
+		"EnableDebugOverlay=1\n"
+		"[Other]\n"
+		"EnableTracing=1\n"
+		"[Debug]\n"
+		"; EnableFrameCapture=1\n"
+		"EnableLiveMetrics=1\n"
+		"FrameCaptureFrames=120\n",
+		NoEnvironment);
+
+	EXPECT_FALSE(config.EnableDebugOverlay);
+	EXPECT_FALSE(config.EnableTracing);
+	EXPECT_FALSE(config.EnableFrameCapture);
+	EXPECT_TRUE(config.EnableLiveMetrics);
+	EXPECT_EQ(config.FrameCaptureFrames, 120u);
+}
+
+TEST(Config, MatchesGetPrivateProfileInt)
+{
+	const auto config = Config::Parse(
+		"\xEF\xBB\xBF[ debug ]\r\n"
+		"  enabledebugoverlay =  1 \r\n"
+		"EnableDebugOverlay=0\r\n"
+		"MaxDisplayWidth=2560px\r\n"
+		"MaxDisplayHeight=-1440\r\n"
+		"HostStageProfilingFrames=\r\n"
+		"EnableVulkanPipelineCache=off\r\n",
+		NoEnvironment);
+
+	EXPECT_TRUE(config.EnableDebugOverlay); // Case insensitive, first occurrence wins
+	EXPECT_EQ(config.MaxDisplayWidth, 2560u); // Leading digits only
+	EXPECT_EQ(config.MaxDisplayHeight, 0u);
+	EXPECT_EQ(config.HostStageProfilingFrames, 0u);
+	EXPECT_FALSE(config.EnableVulkanPipelineCache);
+}
+
+TEST(Config, EnvironmentOverridesIni)
+{
+	const auto config = ParseWithEnvironment(
+		"[Debug]\n"
+		"EnableDebugOverlay=1\n"
+		"EnableTracing=1\n"
+		"GovernorTargetFrameRate=60\n"
+		"FrameCaptureFrames=30\n",
+		{
+			{ "EnableDebugOverlay", "0" },
+			{ "EnableTracing", "true" }, // Not a single character, ignored
+			{ "EnableLiveMetrics", "1" },
+			{ "GovernorTargetFrameRate", "144" },
+			{ "FrameCaptureFrames", "" }, // Empty, ignored
+		});
+
+	EXPECT_FALSE(config.EnableDebugOverlay);
+	EXPECT_TRUE(config.EnableTracing);
+	EXPECT_TRUE(config.EnableLiveMetrics);
+	EXPECT_EQ(config.GovernorTargetFrameRate, 144u);
+	EXPECT_EQ(config.FrameCaptureFrames, 30u);
+}
+
+TEST(Config, ShippedIniMatchesDefaults)
+{
+	std::ifstream file(DLSSG_TO_FSR3_INI_PATH, std::ios::binary);
+	ASSERT_TRUE(file);
+
+	const std::string iniText(std::istreambuf_iterator<char>(file), {});
+	auto config = Config::Parse(iniText, NoEnvironment);
+
+	// The ini lists every setting with its default, except for the overlay shipped enabled
+	EXPECT_TRUE(config.EnableDebugOverlay);
+	config.EnableDebugOverlay = false;
+
+	EXPECT_EQ(config, Configuration {});
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include <numbers>
+#include "DLSSGFrameInputs.h"
+#include "FakeNGXParameters.h"
+
+// Row-major perspective projection with a standard depth range, as Streamline expects
+static void BuildPerspectiveMatrix(float (&OutMatrix)[4][4], float FovAngleVertical, float Near, float Far)
+{
+	const float b = 1.0f / std::tan(FovAngleVertical / 2.0f);
+	const float c = Far / (Near - Far);
+
+	memset(OutMatrix, 0, sizeof(OutMatrix));
+	OutMatrix[0][0] = b;
+	OutMatrix[1][1] = b;
+	OutMatrix[2][2] = c;
+	OutMatrix[2][3] = -1.0f;
+	OutMatrix[3][2] = Near * c;
+}
+
+TEST(DLSSGFrameInputs, MissingKeysUseDefaults)
+{
+	FakeNGXParameters parameters;
+	DLSSGFrameInputs inputs;
+	inputs.Load(&parameters);
+
+	EXPECT_FALSE(inputs.EnableInterp);
+	EXPECT_FALSE(inputs.Reset);
+	EXPECT_EQ(inputs.MultiFrameCount, 1u);
+	EXPECT_EQ(inputs.MultiFrameIndex, 1u);
+	EXPECT_EQ(inputs.MvecScale.x, 1.0f);
+	EXPECT_EQ(inputs.MvecScale.y, 1.0f);
+	EXPECT_FALSE(inputs.Camera.ViewToClipValid);
+}
+
+TEST(DLSSGFrameInputs, ReadsEachKey)
+{
+	FakeNGXParameters parameters;
+	parameters.Set5("DLSSG.EnableInterp", 1);
+	parameters.Set5("DLSSG.Reset", 1);
+	parameters.Set5("DLSSG.MultiFrameCount", 3);
+	parameters.Set5("DLSSG.MultiFrameIndex", 2);
+	parameters.Set5("DLSSG.HUDLessSubrectBaseX", 16);
+	parameters.Set5("DLSSG.HUDLessSubrectWidth", 1920);
+	parameters.Set2("DLSSG.MvecScaleX", -0.5f);
+	parameters.Set2("DLSSG.JitterOffsetY", 0.25f);
+
+	DLSSGFrameInputs inputs;
+	inputs.Load(&parameters);
+
+	EXPECT_TRUE(inputs.EnableInterp);
+	EXPECT_TRUE(inputs.Reset);
+	EXPECT_EQ(inputs.MultiFrameCount, 3u);
+	EXPECT_EQ(inputs.MultiFrameIndex, 2u);
+	EXPECT_EQ(inputs.HUDLessSubrectBase.x, 16);
+	EXPECT_EQ(inputs.HUDLessSubrect.width, 1920u);
+	EXPECT_EQ(inputs.MvecScale.x, -0.5f);
+	EXPECT_EQ(inputs.MvecScale.y, 1.0f);
+	EXPECT_EQ(inputs.JitterOffset.y, 0.25f);
+}
+
+TEST(DLSSGFrameInputs, LoadDropsPreviousFrameState)
+{
+	FakeNGXParameters parameters;
+	float viewToClip[4][4];
+	BuildPerspectiveMatrix(viewToClip, 1.0f, 0.1f, 100.0f);
+	parameters.SetVoidPointer("DLSSG.CameraViewToClip", viewToClip);
+
+	DLSSGFrameInputs inputs;
+	inputs.Load(&parameters);
+	inputs.Backbuffer.resource = &inputs;
+	inputs.OutputInterpolated.resource = &inputs;
+
+	ASSERT_TRUE(inputs.Camera.ViewToClipValid);
+
+	parameters.Remove("DLSSG.CameraViewToClip");
+	inputs.Load(&parameters);
+
+	EXPECT_EQ(inputs.Backbuffer.resource, nullptr);
+	EXPECT_EQ(inputs.OutputInterpolated.resource, nullptr);
+	EXPECT_FALSE(inputs.Camera.ViewToClipValid);
+	EXPECT_EQ(inputs.Camera, DLSSGFrameInputs::CameraInputs {});
+}
+
+TEST(DLSSGFrameInputs, DecomposesProjectionMatrix)
+{
+	FakeNGXParameters parameters;
+	float viewToClip[4][4];
+	BuildPerspectiveMatrix(viewToClip, 1.0f, 0.1f, 100.0f);
+	parameters.SetVoidPointer("DLSSG.CameraViewToClip", viewToClip);
+
+	DLSSGFrameInputs inputs;
+	inputs.Load(&parameters);
+
+	const auto& camera = inputs.GetCameraParameters();
+	EXPECT_NEAR(camera.FovAngleVertical, 1.0f, 1e-5f);
+	EXPECT_NEAR(camera.Near, 0.1f, 1e-5f);
+	EXPECT_NEAR(camera.Far, 100.0f, 1e-2f);
+	EXPECT_FALSE(camera.DepthPlaneInfinite);
+}
+
+TEST(DLSSGFrameInputs, CameraParametersFollowInputChanges)
+{
+	FakeNGXParameters parameters;
+	parameters.Set2("DLSSG.CameraFOV", 90.0f);
+	parameters.Set2("DLSSG.CameraNear", 0.5f);
+	parameters.Set2("DLSSG.CameraFar", 500.0f);
+
+	DLSSGFrameInputs inputs;
+	inputs.Load(&parameters);
+
+	// Degrees are converted to radians
+	EXPECT_NEAR(inputs.GetCameraParameters().FovAngleVertical, std::numbers::pi_v<float> / 2.0f, 1e-6f);
+	EXPECT_EQ(inputs.GetCameraParameters().Far, 500.0f);
+
+	// Identical inputs hit the cached result, new ones are picked up on the next frame
+	inputs.Load(&parameters);
+	EXPECT_EQ(inputs.GetCameraParameters().Near, 0.5f);
+
+	parameters.Set2("DLSSG.CameraNear", 1.0f);
+	parameters.Set2("DLSSG.CameraFar", 0.0f);
+	inputs.Load(&parameters);
+
+	const auto& camera = inputs.GetCameraParameters();
+	EXPECT_EQ(camera.Near, 1.0f);
+	EXPECT_TRUE(camera.DepthPlaneInfinite);
+	EXPECT_GT(camera.Far, camera.Near);
+}
+
+TEST(DLSSGFrameInputs, IdentityMatrixFallsBackToCameraValues)
+{
+	FakeNGXParameters parameters;
+	float identity[4][4] = {};
+	identity[0][0] = identity[1][1] = identity[2][2] = identity[3][3] = 1.0f;
+
+	parameters.SetVoidPointer("DLSSG.CameraViewToClip", identity);
+	parameters.Set2("DLSSG.CameraNear", 0.25f);
+	parameters.Set2("DLSSG.CameraFar", 1000.0f);
+
+	DLSSGFrameInputs inputs;
+	inputs.Load(&parameters);
+
+	// No FOV at all is treated as 90 degrees
+	const auto& camera = inputs.GetCameraParameters();
+	EXPECT_NEAR(camera.FovAngleVertical, std::numbers::pi_v<float> / 2.0f, 1e-6f);
+	EXPECT_EQ(camera.Near, 0.25f);
+	EXPECT_EQ(camera.Far, 1000.0f);
+}
@@ -0,0 +1,130 @@
+#include "NGX/NvNGX.h"
+#include "FakeShaderBlobs.h"
+#include "FFFrameInterpolatorHeadless.h"
+
+FFFrameInterpolatorHeadless::FFFrameInterpolatorHeadless(
+	Device *Device,
+	uint32_t OutputWidth,
+	uint32_t OutputHeight,
+	NGXInstanceParameters *NGXParameters)
+	: m_Device(Device),
+	  FFFrameInterpolator(OutputWidth, OutputHeight)
+{
+	FFFrameInterpolator::Create(NGXParameters);
+
+	// Every evaluation is expected to do work, so don't pass the first frames through
+	FFFrameInterpolator::WaitForContextCreation();
+}
+
+FFFrameInterpolatorHeadless::~FFFrameInterpolatorHeadless()
+{
+	FFFrameInterpolator::Destroy();
+}
+
+FfxErrorCode FFFrameInterpolatorHeadless::Dispatch(void *CommandList, NGXInstanceParameters *NGXParameters)
+{
+	NGXParameters->Set4("DLSSG.FlushRequired", 0);
+
+	m_ActiveCommandList = CommandList;
+	return FFFrameInterpolator::Dispatch(CommandList, NGXParameters);
+}
+
+uint32_t FFFrameInterpolatorHeadless::GetCopyCount() const
+{
+	return m_CopyCount;
+}
+
+FfxErrorCode FFFrameInterpolatorHeadless::InitializeBackendInterface(
+	FFInterfaceWrapper *BackendInterface,
+	uint32_t MaxContexts,
+	NGXInstanceParameters *)
+{
+	std::scoped_lock lock(m_Device->Mutex);
+	auto& backend = m_Device->Backends.emplace_back();
+
+	if (auto status = backend.Initialize(FakeShaderBlobs::GetPermutationBlob, MaxContexts); status != FFX_OK)
+	{
+		m_Device->Backends.pop_back();
+		return status;
+	}
+
+	static_cast<FfxInterface&>(*BackendInterface) = backend;
+	return FFX_OK;
+}
+
+void *FFFrameInterpolatorHeadless::GetBackendDevice() const
+{
+	return m_Device;
+}
+
+std::array<uint8_t, 8> FFFrameInterpolatorHeadless::GetActiveAdapterLUID() const
+{
+	return {};
+}
+
+FfxCommandList FFFrameInterpolatorHeadless::GetActiveCommandList() const
+{
+	return m_ActiveCommandList;
+}
+
+void FFFrameInterpolatorHeadless::CopyTexture(FfxCommandList, const FfxResource *, const FfxResource *)
+{
+	m_CopyCount++;
+}
+
+FfxSurfaceFormat FFFrameInterpolatorHeadless::GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const
+{
+	return static_cast<FfxSurfaceFormat>(NGXParameters->GetUIntOrDefault("DLSSG.BackbufferFormat", FFX_SURFACE_FORMAT_UNKNOWN));
+}
+
+bool FFFrameInterpolatorHeadless::CreateReadbackBuffer(uint64_t, FrameCapture::ReadbackBuffer *)
+{
+	return false;
+}
+
+void FFFrameInterpolatorHeadless::DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer&)
+{
+}
+
+void FFFrameInterpolatorHeadless::CopyTextureToReadback(
+	FfxCommandList,
+	const FrameCapture::ReadbackBuffer&,
+	uint64_t,
+	uint32_t,
+	const FfxResource *)
+{
+}
+
+void FFFrameInterpolatorHeadless::WriteReadbackMarker(FfxCommandList, const FrameCapture::ReadbackBuffer&, uint64_t, uint32_t)
+{
+}
+
+bool FFFrameInterpolatorHeadless::LoadTextureFromNGXParameters(
+	NGXInstanceParameters *NGXParameters,
+	const char *Name,
+	FfxResource *OutFfxResource,
+	FfxResourceStates State)
+{
+	Texture *texture = nullptr;
+	NGXParameters->GetVoidPointer(Name, reinterpret_cast<void **>(&texture));
+
+	if (!texture)
+	{
+		*OutFfxResource = {};
+		return false;
+	}
+
+	*OutFfxResource = {};
+	OutFfxResource->resource = texture;
+	OutFfxResource->description = texture->Description;
+	OutFfxResource->state = State;
+
+	for (size_t i = 0; Name[i] && i + 1 < std::size(OutFfxResource->name); i++)
+		OutFfxResource->name[i] = Name[i];
+
+	return true;
+}
+
+void FFFrameInterpolatorHeadless::OnFrameTexturesLoaded(FFBackendInterfaces&, bool)
+{
+}
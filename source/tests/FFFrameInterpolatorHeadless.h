@@ -0,0 +1,74 @@
+#pragma once
+
+#include "FFFrameInterpolator.h"
+#include "FFRecordingInterface.h"
+
+// Frame generation on FFRecordingInterface instead of a GPU. Everything above the backend, from the NGX parameter map
+// to effect dispatches, runs the plugin's code unmodified.
+//
+// Textures in the parameter map are HeadlessTexture pointers and DLSSG.BackbufferFormat holds an FfxSurfaceFormat.
+// Copies are only counted and frame capture isn't supported.
+class FFFrameInterpolatorHeadless final : public FFFrameInterpolator
+{
+public:
+	// Stands in for a graphics device. Owns the backends created for every feature on it.
+	struct Device
+	{
+		std::mutex Mutex;
+		std::list<FFRecordingInterface> Backends;
+	};
+
+	struct Texture
+	{
+		FfxResourceDescription Description = {};
+	};
+
+private:
+	Device *const m_Device;
+	uint32_t m_CopyCount = 0;
+
+	// Transient
+	FfxCommandList m_ActiveCommandList = {};
+
+public:
+	FFFrameInterpolatorHeadless(Device *Device, uint32_t OutputWidth, uint32_t OutputHeight, NGXInstanceParameters *NGXParameters);
+	FFFrameInterpolatorHeadless(const FFFrameInterpolatorHeadless&) = delete;
+	FFFrameInterpolatorHeadless& operator=(const FFFrameInterpolatorHeadless&) = delete;
+	~FFFrameInterpolatorHeadless();
+
+	FfxErrorCode Dispatch(void *CommandList, NGXInstanceParameters *NGXParameters) override;
+
+	uint32_t GetCopyCount() const;
+
+private:
+	FfxErrorCode InitializeBackendInterface(
+		FFInterfaceWrapper *BackendInterface,
+		uint32_t MaxContexts,
+		NGXInstanceParameters *NGXParameters) override;
+
+	void *GetBackendDevice() const override;
+	std::array<uint8_t, 8> GetActiveAdapterLUID() const override;
+	FfxCommandList GetActiveCommandList() const override;
+
+	void CopyTexture(FfxCommandList CommandList, const FfxResource *Destination, const FfxResource *Source) override;
+	FfxSurfaceFormat GetBackBufferFormatFromNGXParameters(NGXInstanceParameters *NGXParameters) const override;
+
+	bool CreateReadbackBuffer(uint64_t Size, FrameCapture::ReadbackBuffer *OutBuffer) override;
+	void DestroyReadbackBuffer(const FrameCapture::ReadbackBuffer& Buffer) override;
+
+	void CopyTextureToReadback(
+		FfxCommandList CommandList,
+		const FrameCapture::ReadbackBuffer& Destination,
+		uint64_t Offset,
+		uint32_t RowPitch,
+		const FfxResource *Source) override;
+	void WriteReadbackMarker(FfxCommandList CommandList, const FrameCapture::ReadbackBuffer& Destination, uint64_t Offset, uint32_t Value) override;
+
+	bool LoadTextureFromNGXParameters(
+		NGXInstanceParameters *NGXParameters,
+		const char *Name,
+		FfxResource *OutFfxResource,
+		FfxResourceStates State) override;
+
+	void OnFrameTexturesLoaded(FFBackendInterfaces& Backend, bool Reset) override;
+};
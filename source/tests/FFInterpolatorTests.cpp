@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "FakeShaderBlobs.h"
+#include "FFBackendPool.h"
+#include "FFInterpolator.h"
+#include "FFRecordingInterface.h"
+#include "SyntheticScene.h"
+
+// Only scheduled when history is valid
+constexpr std::wstring_view PreparationPassLabel = L"Clear Reconstructed Depth Interpolated Frame";
+
+static FfxResource MakeTexture(
+	const wchar_t *Name,
+	void *Resource,
+	uint32_t Width,
+	uint32_t Height,
+	FfxSurfaceFormat Format,
+	FfxResourceStates State)
+{
+	FfxResource texture = {};
+	wcscpy_s(texture.name, Name);
+	texture.resource = Resource;
+	texture.description.type = FFX_RESOURCE_TYPE_TEXTURE2D;
+	texture.description.format = Format;
+	texture.description.width = Width;
+	texture.description.height = Height;
+	texture.description.depth = 1;
+	texture.description.mipCount = 1;
+	texture.state = State;
+
+	return texture;
+}
+
+class FFInterpolatorTest : public testing::Test
+{
+protected:
+	constexpr static uint32_t Width = 1920;
+	constexpr static uint32_t Height = 1080;
+
+	FFRecordingInterface m_FrameInterpolationRecording;
+	FFRecordingInterface m_SharedRecording;
+	FFBackendInterfaces m_Backend;
+	std::optional<FFInterpolator> m_Interpolator;
+
+	// Stand-ins for game resources. Only the addresses are used.
+	uint32_t m_GameResources[6] = {};
+
+	void SetUp() override
+	{
+		ASSERT_EQ(m_FrameInterpolationRecording.Initialize(FakeShaderBlobs::GetPermutationBlob, 8), FFX_OK);
+		ASSERT_EQ(m_SharedRecording.Initialize(FakeShaderBlobs::GetPermutationBlob, 2), FFX_OK);
+
+		static_cast<FfxInterface&>(m_Backend.FrameInterpolation) = m_FrameInterpolationRecording;
+		static_cast<FfxInterface&>(m_Backend.Shared) = m_SharedRecording;
+		m_Backend.MaxCachedContexts = 2;
+
+		FfxUInt32 sharedEffectContextId = 0;
+		ASSERT_EQ(m_SharedRecording.fpCreateBackendContext(&m_SharedRecording, FFX_EFFECT_SHAREDRESOURCES, nullptr, &sharedEffectContextId), FFX_OK);
+
+		m_Interpolator.emplace(m_Backend, sharedEffectContextId, Width, Height);
+	}
+
+	void TearDown() override
+	{
+		if (m_Interpolator)
+			m_Interpolator->WaitForContextCreation();
+	}
+
+	FFInterpolatorDispatchParameters MakeParameters(bool HDR = false)
+	{
+		const auto colorFormat = HDR ? FFX_SURFACE_FORMAT_R10G10B10A2_UNORM : FFX_SURFACE_FORMAT_R8G8B8A8_UNORM;
+
+		FFInterpolatorDispatchParameters parameters = {};
+		parameters.RenderSize = { Width, Height };
+		parameters.OutputSize = { Width, Height };
+		parameters.InterpolationRect = { 0, 0, static_cast<int32_t>(Width), static_cast<int32_t>(Height) };
+
+		parameters.InputColorBuffer = MakeTexture(L"Color", &m_GameResources[0], Width, Height, colorFormat, FFX_RESOURCE_STATE_COPY_DEST);
+		parameters.InputDepth = MakeTexture(L"Depth", &m_GameResources[1], Width, Height, FFX_SURFACE_FORMAT_R32_FLOAT, FFX_RESOURCE_STATE_COPY_DEST);
+		parameters.InputMotionVectors = MakeTexture(L"MotionVectors", &m_GameResources[2], Width, Height, FFX_SURFACE_FORMAT_R16G16_FLOAT, FFX_RESOURCE_STATE_COPY_DEST);
+		parameters.InputOpticalFlowVector = MakeTexture(L"OpticalFlowVector", &m_GameResources[3], Width / 8, Height / 8, FFX_SURFACE_FORMAT_R16G16_SINT, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+		parameters.InputOpticalFlowSceneChangeDetection = MakeTexture(L"OpticalFlowSCD", &m_GameResources[4], 3, 1, FFX_SURFACE_FORMAT_R32_UINT, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+		parameters.OutputInterpolatedColorBuffer = MakeTexture(L"Output", &m_GameResources[5], Width, Height, colorFormat, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+		parameters.OpticalFlowScale = { 1.0f / Width, 1.0f / Height };
+		parameters.OpticalFlowBlockSize = 8;
+
+		parameters.MotionVectorScale = { 1.0f, 1.0f };
+		parameters.HDR = HDR;
+		parameters.DepthInverted = true;
+		parameters.CameraNear = 0.1f;
+		parameters.CameraFar = 1000.0f;
+		parameters.CameraFovAngleVertical = 1.0f;
+		parameters.MinMaxLuminance = { 0.0f, 1000.0f };
+
+		parameters.InterpolationFactor = 0.5f;
+		parameters.PrepareInputs = true;
+		parameters.StoreInterpolationSource = true;
+
+		return parameters;
+	}
+
+	// Dispatches until the context for Parameters exists. Returns how many dispatches were deferred.
+	uint32_t DispatchUntilReady(const FFInterpolatorDispatchParameters& Parameters)
+	{
+		uint32_t deferredCount = 0;
+
+		for (FfxErrorCode status; (status = m_Interpolator->Dispatch(Parameters)) == FFX_EOF; deferredCount++)
+			m_Interpolator->WaitForContextCreation();
+
+		return deferredCount;
+	}
+
+	size_t CountJobs(std::wstring_view Label) const
+	{
+		return std::ranges::count(m_FrameInterpolationRecording.GetLog().Jobs, Label, &FFRecordingInterface::JobRecord::Label);
+	}
+};
+
+TEST_F(FFInterpolatorTest, BuildsContextOnWorkerBeforeDispatching)
+{
+	const auto parameters = MakeParameters();
+
+	EXPECT_EQ(m_Interpolator->Dispatch(parameters), FFX_EOF);
+	m_Interpolator->WaitForContextCreation();
+	EXPECT_FALSE(m_Interpolator->IsContextCreationPending());
+
+	// Every pass is built up front, in parallel, none of them while dispatching
+	const auto& log = m_FrameInterpolationRecording.GetLog();
+	const auto pipelineCount = log.Pipelines.size();
+	EXPECT_GE(pipelineCount, 8u);
+
+	ASSERT_EQ(m_Interpolator->Dispatch(parameters), FFX_OK);
+	EXPECT_EQ(log.Pipelines.size(), pipelineCount);
+
+	// Shared dilated depth, motion vectors and reconstructed depth live in the shared backend
+	EXPECT_EQ(m_SharedRecording.GetLog().Resources.size(), 3u);
+
+	for (auto& job : log.Jobs)
+	{
+		if (job.Type != FFX_GPU_JOB_COMPUTE)
+			continue;
+
+		EXPECT_GT(job.Dimensions[0] * job.Dimensions[1] * job.Dimensions[2], 0u);
+		EXPECT_FALSE(job.ConstantBufferSizes.empty());
+
+		for (auto size : job.ConstantBufferSizes)
+			EXPECT_GT(size, 0u);
+	}
+
+	// The game's output image is registered for the dispatch and written as a UAV
+	const auto output = std::ranges::find(log.Resources, std::wstring_view(L"Output"), &FFRecordingInterface::ResourceRecord::Name);
+	ASSERT_NE(output, log.Resources.end());
+	EXPECT_TRUE(output->External);
+
+	EXPECT_TRUE(std::ranges::any_of(
+		log.Barriers,
+		[&](const FFRecordingInterface::BarrierRecord& Barrier)
+		{
+			return Barrier.InternalIndex == output->InternalIndex && Barrier.After == FFX_RESOURCE_STATE_UNORDERED_ACCESS;
+		}));
+}
+
+TEST_F(FFInterpolatorTest, FirstDispatchOfAContextResetsHistory)
+{
+	const auto parameters = MakeParameters();
+	DispatchUntilReady(parameters);
+
+	EXPECT_EQ(CountJobs(PreparationPassLabel), 0u);
+
+	m_FrameInterpolationRecording.ResetLog();
+	ASSERT_EQ(m_Interpolator->Dispatch(parameters), FFX_OK);
+
+	EXPECT_EQ(CountJobs(PreparationPassLabel), 1u);
+}
+
+TEST_F(FFInterpolatorTest, SwitchingBackReusesCachedContext)
+{
+	const auto sdrParameters = MakeParameters(false);
+	const auto hdrParameters = MakeParameters(true);
+
+	EXPECT_EQ(DispatchUntilReady(sdrParameters), 1u);
+	ASSERT_EQ(m_Interpolator->Dispatch(sdrParameters), FFX_OK);
+
+	EXPECT_EQ(DispatchUntilReady(hdrParameters), 1u);
+
+	// No new context and no deferred frame, but the cached context's history is stale
+	m_FrameInterpolationRecording.ResetLog();
+	ASSERT_EQ(m_Interpolator->Dispatch(sdrParameters), FFX_OK);
+
+	EXPECT_TRUE(m_FrameInterpolationRecording.GetLog().Pipelines.empty());
+	EXPECT_EQ(CountJobs(PreparationPassLabel), 0u);
+
+	// Still reset for the remaining interpolated frames generated from the same real frame
+	auto secondFrame = sdrParameters;
+	secondFrame.PrepareInputs = false;
+
+	m_FrameInterpolationRecording.ResetLog();
+	ASSERT_EQ(m_Interpolator->Dispatch(secondFrame), FFX_OK);
+	EXPECT_EQ(CountJobs(PreparationPassLabel), 0u);
+
+	// History is valid again from the next real frame on
+	m_FrameInterpolationRecording.ResetLog();
+	ASSERT_EQ(m_Interpolator->Dispatch(sdrParameters), FFX_OK);
+	EXPECT_EQ(CountJobs(PreparationPassLabel), 1u);
+}
+
+TEST_F(FFInterpolatorTest, SteadyStateWorkDoesNotGrow)
+{
+	const auto parameters = MakeParameters();
+	DispatchUntilReady(parameters);
+	ASSERT_EQ(m_Interpolator->Dispatch(parameters), FFX_OK);
+
+	m_FrameInterpolationRecording.ResetLog();
+	ASSERT_EQ(m_Interpolator->Dispatch(parameters), FFX_OK);
+	const auto baseline = m_FrameInterpolationRecording.GetLog().GetTotals();
+
+	EXPECT_GT(baseline.DispatchCount, 0u);
+	EXPECT_EQ(baseline.ResourceCount, 0u);
+
+	for (int i = 0; i < 4; i++)
+	{
+		m_FrameInterpolationRecording.ResetLog();
+		ASSERT_EQ(m_Interpolator->Dispatch(parameters), FFX_OK);
+
+		const auto regressions = FFRecordingInterface::FindRegressions(baseline, m_FrameInterpolationRecording.GetLog().GetTotals());
+		EXPECT_TRUE(regressions.empty()) << regressions.front();
+	}
+}
+
+class FFInterpolatorScenarioTest : public FFInterpolatorTest, public testing::WithParamInterface<SyntheticScene::Scenario>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+	AllScenarios,
+	FFInterpolatorScenarioTest,
+	testing::Values(
+		SyntheticScene::Scenario::Panning,
+		SyntheticScene::Scenario::Disocclusion,
+		SyntheticScene::Scenario::SceneCut,
+		SyntheticScene::Scenario::HDR,
+		SyntheticScene::Scenario::UIOverlay),
+	[](const testing::TestParamInfo<SyntheticScene::Scenario>& Info) { return SyntheticScene::GetName(Info.param); });
+
+// Frame content doesn't reach the host side, but the flags each scenario sets do
+TEST_P(FFInterpolatorScenarioTest, WorkStaysWithinBaseline)
+{
+	std::optional<FFRecordingInterface::Totals> baseline;
+	uint32_t hudLessResource = 0;
+
+	for (int time = 0; time < 6; time++)
+	{
+		const auto frame = SyntheticScene::Render(GetParam(), 64, 36, time, time - 1);
+
+		auto parameters = MakeParameters(frame.HDR);
+		parameters.Reset = frame.Reset;
+
+		if (!frame.HUDLess.Texels.empty())
+			parameters.InputHUDLessColorBuffer = MakeTexture(L"HUDLess", &hudLessResource, Width, Height, parameters.InputColorBuffer.description.format, FFX_RESOURCE_STATE_COPY_DEST);
+
+		if (time == 0)
+			DispatchUntilReady(parameters);
+
+		m_FrameInterpolationRecording.ResetLog();
+		ASSERT_EQ(m_Interpolator->Dispatch(parameters), FFX_OK);
+
+		const auto totals = m_FrameInterpolationRecording.GetLog().GetTotals();
+
+		if (frame.Reset)
+		{
+			EXPECT_EQ(CountJobs(PreparationPassLabel), 0u) << "Frame " << time;
+			continue;
+		}
+
+		// The first dispatch after context creation resets history, the second one sets the bar
+		if (time < 2)
+			continue;
+
+		if (!baseline)
+		{
+			baseline = totals;
+			continue;
+		}
+
+		const auto regressions = FFRecordingInterface::FindRegressions(*baseline, totals);
+		EXPECT_TRUE(regressions.empty()) << "Frame " << time << ": " << regressions.front();
+	}
+}
+
+TEST(FFRecordingInterface, FindRegressionsHonorsTolerance)
+{
+	const FFRecordingInterface::Totals baseline = { .JobCount = 100, .AllocatedBytes = 1000 };
+
+	auto current = baseline;
+	current.JobCount = 105;
+	current.AllocatedBytes = 900;
+
+	EXPECT_TRUE(FFRecordingInterface::FindRegressions(baseline, current, 0.1).empty());
+
+	const auto regressions = FFRecordingInterface::FindRegressions(baseline, current);
+	ASSERT_EQ(regressions.size(), 1u);
+	EXPECT_EQ(regressions[0], "Job count increased from 100 to 105");
+}
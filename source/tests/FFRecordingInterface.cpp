@@ -0,0 +1,720 @@
+#include <bit>
+#include <FidelityFX/host/ffx_util.h>
+#include "FFRecordingInterface.h"
+#include "VRAMEstimator.h"
+
+struct FFRecordingInterface::State
+{
+	struct Resource
+	{
+		bool Valid = false;
+		ResourceRecord Record;
+		FfxResourceStates CurrentState = FFX_RESOURCE_STATE_COMMON;
+		void *ExternalResource = nullptr;
+		std::unique_ptr<uint8_t[]> HostMemory;
+	};
+
+	struct EffectContext
+	{
+		bool Active = false;
+		uint32_t NextStaticResource = 0;
+		uint32_t NextDynamicResource = 0;
+		FfxEffectMemoryUsage MemoryUsage = {};
+	};
+
+	std::vector<EffectContext> EffectContexts;
+	std::vector<Resource> Resources;
+	std::vector<FfxGpuJobDescription> PendingJobs;
+	std::mutex PipelineMutex; // ffxCreatePipelinesParallel calls CreatePipeline from several threads
+
+	std::unique_ptr<uint8_t[]> ConstantRingBuffer;
+	uint32_t ConstantRingBufferBase = 0;
+	uint32_t SubmissionCount = 0;
+
+	Log Recording;
+
+	Resource *GetResource(int32_t InternalIndex)
+	{
+		if (InternalIndex <= 0 || static_cast<size_t>(InternalIndex) >= Resources.size())
+			return nullptr;
+
+		return &Resources[InternalIndex];
+	}
+
+	void AddBarrier(int32_t InternalIndex, FfxResourceStates NewState)
+	{
+		// Same rules as the DX12 backend: transition when the state bits differ, UAV barrier when they don't
+		auto resource = GetResource(InternalIndex);
+
+		if (!resource)
+			return;
+
+		if ((resource->CurrentState & NewState) != NewState)
+		{
+			Recording.Barriers.emplace_back(Recording.Jobs.size(), InternalIndex, resource->CurrentState, NewState);
+			resource->CurrentState = NewState;
+		}
+		else if (NewState == FFX_RESOURCE_STATE_UNORDERED_ACCESS)
+		{
+			Recording.Barriers.emplace_back(Recording.Jobs.size(), InternalIndex, NewState, NewState);
+		}
+	}
+};
+
+static uint64_t GetResourceSize(const FfxResourceDescription& Description)
+{
+	if (Description.type == FFX_RESOURCE_TYPE_BUFFER)
+		return Description.size;
+
+	const uint32_t height = (Description.type == FFX_RESOURCE_TYPE_TEXTURE1D) ? 1 : Description.height;
+	const uint32_t depth = std::max(Description.depth, 1u);
+	uint32_t mipCount = Description.mipCount;
+
+	// A mip count of zero requests the full chain
+	if (mipCount == 0)
+		mipCount = static_cast<uint32_t>(std::bit_width(std::max(Description.width, height)));
+
+	uint64_t size = 0;
+
+	for (uint32_t i = 0; i < mipCount; i++)
+	{
+		const uint64_t mipWidth = std::max(Description.width >> i, 1u);
+		const uint64_t mipHeight = std::max(height >> i, 1u);
+
+		size += mipWidth * mipHeight * VRAMEstimator::GetSurfaceFormatSize(Description.format);
+	}
+
+	return size * depth;
+}
+
+static void CopyBindingName(wchar_t (&Destination)[FFX_RESOURCE_NAME_SIZE], const char *Source)
+{
+	size_t i = 0;
+
+	// Binding names are plain ASCII identifiers
+	for (; Source && Source[i] && i < (FFX_RESOURCE_NAME_SIZE - 1); i++)
+		Destination[i] = static_cast<wchar_t>(Source[i]);
+
+	Destination[i] = L'\0';
+}
+
+template<size_t N>
+static uint32_t FillBindings(
+	FfxResourceBinding (&Bindings)[N],
+	uint32_t Count,
+	const uint32_t *Slots,
+	const uint32_t *BindCounts,
+	const char **Names)
+{
+	uint32_t flattenedCount = 0;
+
+	for (uint32_t i = 0; i < Count; i++)
+	{
+		for (uint32_t arrayIndex = 0; arrayIndex < BindCounts[i]; arrayIndex++)
+		{
+			auto& binding = Bindings[flattenedCount++];
+
+			binding.slotIndex = Slots[i];
+			binding.arrayIndex = arrayIndex;
+			CopyBindingName(binding.name, Names[i]);
+		}
+	}
+
+	return flattenedCount;
+}
+
+FFRecordingInterface::Totals FFRecordingInterface::Log::GetTotals() const
+{
+	Totals totals = {};
+	totals.JobCount = Jobs.size();
+	totals.BarrierCount = Barriers.size();
+	totals.PipelineCount = Pipelines.size();
+
+	for (auto& job : Jobs)
+	{
+		if (job.Type == FFX_GPU_JOB_COMPUTE)
+			totals.DispatchCount++;
+
+		for (auto size : job.ConstantBufferSizes)
+			totals.ConstantBufferBytes += size;
+	}
+
+	for (auto& resource : Resources)
+	{
+		if (resource.External)
+			continue;
+
+		totals.ResourceCount++;
+		totals.AllocatedBytes += resource.Size;
+	}
+
+	return totals;
+}
+
+FFRecordingInterface::FFRecordingInterface()
+{
+	memset(static_cast<FfxInterface *>(this), 0, sizeof(FfxInterface));
+}
+
+FFRecordingInterface::~FFRecordingInterface()
+{
+	delete GetState();
+}
+
+FfxErrorCode FFRecordingInterface::Initialize(FfxGetPermutationBlobByIndexFunc GetPermutationBlob, uint32_t MaxContexts)
+{
+	if (!GetPermutationBlob || MaxContexts == 0)
+		return FFX_ERROR_INVALID_ARGUMENT;
+
+	delete GetState();
+
+	// Copies of this interface are held by every effect context, so all state lives behind the scratch pointer
+	auto state = new State;
+	state->EffectContexts.resize(MaxContexts);
+	state->Resources.resize(MaxContexts * FFX_MAX_RESOURCE_COUNT);
+	state->ConstantRingBuffer = std::make_unique<uint8_t[]>(FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE);
+
+	fpGetSDKVersion = GetSDKVersion;
+	fpGetEffectGpuMemoryUsage = GetEffectGpuMemoryUsage;
+	fpCreateBackendContext = CreateBackendContext;
+	fpGetDeviceCapabilities = GetDeviceCapabilities;
+	fpDestroyBackendContext = DestroyBackendContext;
+	fpCreateResource = CreateResource;
+	fpRegisterResource = RegisterResource;
+	fpGetResource = GetResource;
+	fpUnregisterResources = UnregisterResources;
+	fpRegisterStaticResource = RegisterStaticResource;
+	fpGetResourceDescription = GetResourceDescription;
+	fpDestroyResource = DestroyResource;
+	fpMapResource = MapResource;
+	fpUnmapResource = UnmapResource;
+	fpStageConstantBufferDataFunc = StageConstantBufferData;
+	fpCreatePipeline = CreatePipeline;
+	fpGetPermutationBlobByIndex = GetPermutationBlob;
+	fpDestroyPipeline = DestroyPipeline;
+	fpScheduleGpuJob = ScheduleGpuJob;
+	fpExecuteGpuJobs = ExecuteGpuJobs;
+	fpRegisterConstantBufferAllocator = RegisterConstantBufferAllocator;
+
+	scratchBuffer = state;
+	scratchBufferSize = sizeof(State);
+	device = state; // Effects assert on a null device
+
+	return FFX_OK;
+}
+
+const FFRecordingInterface::Log& FFRecordingInterface::GetLog() const
+{
+	return GetState()->Recording;
+}
+
+void FFRecordingInterface::ResetLog()
+{
+	GetState()->Recording = {};
+}
+
+std::vector<std::string> FFRecordingInterface::FindRegressions(const Totals& Baseline, const Totals& Current, double Tolerance)
+{
+	std::vector<std::string> regressions;
+
+	auto check = [&](const char *Name, uint64_t BaselineValue, uint64_t CurrentValue)
+	{
+		if (static_cast<double>(CurrentValue) > static_cast<double>(BaselineValue) * (1.0 + Tolerance))
+			regressions.emplace_back(std::string(Name) + " increased from " + std::to_string(BaselineValue) + " to " + std::to_string(CurrentValue));
+	};
+
+	check("Job count", Baseline.JobCount, Current.JobCount);
+	check("Dispatch count", Baseline.DispatchCount, Current.DispatchCount);
+	check("Barrier count", Baseline.BarrierCount, Current.BarrierCount);
+	check("Resource count", Baseline.ResourceCount, Current.ResourceCount);
+	check("Pipeline count", Baseline.PipelineCount, Current.PipelineCount);
+	check("Allocated bytes", Baseline.AllocatedBytes, Current.AllocatedBytes);
+	check("Constant buffer bytes", Baseline.ConstantBufferBytes, Current.ConstantBufferBytes);
+
+	return regressions;
+}
+
+FFRecordingInterface::State *FFRecordingInterface::GetState() const
+{
+	return static_cast<State *>(scratchBuffer);
+}
+
+FfxVersionNumber FFRecordingInterface::GetSDKVersion(FfxInterface *backendInterface)
+{
+	return FFX_SDK_MAKE_VERSION(FFX_SDK_VERSION_MAJOR, FFX_SDK_VERSION_MINOR, FFX_SDK_VERSION_PATCH);
+}
+
+FfxErrorCode FFRecordingInterface::GetEffectGpuMemoryUsage(
+	FfxInterface *backendInterface,
+	FfxUInt32 effectContextId,
+	FfxEffectMemoryUsage *outVramUsage)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	if (!outVramUsage)
+		return FFX_ERROR_INVALID_POINTER;
+
+	if (effectContextId >= state->EffectContexts.size())
+		return FFX_ERROR_OUT_OF_RANGE;
+
+	*outVramUsage = state->EffectContexts[effectContextId].MemoryUsage;
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::CreateBackendContext(
+	FfxInterface *backendInterface,
+	FfxEffect effect,
+	FfxEffectBindlessConfig *bindlessConfig,
+	FfxUInt32 *effectContextId)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	for (uint32_t i = 0; i < state->EffectContexts.size(); i++)
+	{
+		auto& effectContext = state->EffectContexts[i];
+
+		if (effectContext.Active)
+			continue;
+
+		effectContext = {};
+		effectContext.Active = true;
+		effectContext.NextStaticResource = (i * FFX_MAX_RESOURCE_COUNT) + 1;
+		effectContext.NextDynamicResource = (i * FFX_MAX_RESOURCE_COUNT) + FFX_MAX_RESOURCE_COUNT - 1;
+
+		*effectContextId = i;
+		return FFX_OK;
+	}
+
+	return FFX_ERROR_OUT_OF_MEMORY;
+}
+
+FfxErrorCode FFRecordingInterface::GetDeviceCapabilities(FfxInterface *backendInterface, FfxDeviceCapabilities *outDeviceCapabilities)
+{
+	// Report a typical desktop GPU so effects select their default permutations
+	*outDeviceCapabilities = {};
+	outDeviceCapabilities->maximumSupportedShaderModel = FFX_SHADER_MODEL_6_6;
+	outDeviceCapabilities->waveLaneCountMin = 32;
+	outDeviceCapabilities->waveLaneCountMax = 64;
+	outDeviceCapabilities->fp16Supported = true;
+
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::DestroyBackendContext(FfxInterface *backendInterface, FfxUInt32 effectContextId)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	if (effectContextId >= state->EffectContexts.size())
+		return FFX_ERROR_OUT_OF_RANGE;
+
+	for (uint32_t i = 0; i < FFX_MAX_RESOURCE_COUNT; i++)
+		state->Resources[(effectContextId * FFX_MAX_RESOURCE_COUNT) + i] = {};
+
+	state->EffectContexts[effectContextId] = {};
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::CreateResource(
+	FfxInterface *backendInterface,
+	const FfxCreateResourceDescription *createResourceDescription,
+	FfxUInt32 effectContextId,
+	FfxResourceInternal *outResource)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+	auto& effectContext = state->EffectContexts[effectContextId];
+
+	if (effectContext.NextStaticResource + 1 >= effectContext.NextDynamicResource)
+		return FFX_ERROR_OUT_OF_MEMORY;
+
+	outResource->internalIndex = effectContext.NextStaticResource++;
+
+	const auto& initData = createResourceDescription->initData;
+	const bool isUpload = createResourceDescription->heapType == FFX_HEAP_TYPE_UPLOAD;
+
+	auto& resource = state->Resources[outResource->internalIndex];
+	resource = {};
+	resource.Valid = true;
+	resource.Record.Name = createResourceDescription->name ? createResourceDescription->name : L"";
+	resource.Record.Description = createResourceDescription->resourceDescription;
+	resource.Record.HeapType = createResourceDescription->heapType;
+	resource.Record.EffectContextId = effectContextId;
+	resource.Record.InternalIndex = outResource->internalIndex;
+	resource.Record.Size = GetResourceSize(createResourceDescription->resourceDescription);
+
+	if (isUpload)
+		resource.Record.InitialState = FFX_RESOURCE_STATE_GENERIC_READ;
+	else if (initData.type != FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED)
+		resource.Record.InitialState = FFX_RESOURCE_STATE_COPY_DEST;
+	else
+		resource.Record.InitialState = createResourceDescription->initialState;
+
+	resource.CurrentState = resource.Record.InitialState;
+	state->Recording.Resources.emplace_back(resource.Record);
+
+	effectContext.MemoryUsage.totalUsageInBytes += resource.Record.Size;
+
+	if ((createResourceDescription->resourceDescription.flags & FFX_RESOURCE_FLAGS_ALIASABLE) == FFX_RESOURCE_FLAGS_ALIASABLE)
+		effectContext.MemoryUsage.aliasableUsageInBytes += resource.Record.Size;
+
+	// Initial data goes through a staging resource and a copy job like it would on hardware
+	if (!isUpload && initData.type != FFX_RESOURCE_INIT_DATA_TYPE_UNINITIALIZED)
+	{
+		FfxCreateResourceDescription uploadDescription = *createResourceDescription;
+		uploadDescription.heapType = FFX_HEAP_TYPE_UPLOAD;
+		uploadDescription.resourceDescription.usage = FFX_RESOURCE_USAGE_READ_ONLY;
+		uploadDescription.initialState = FFX_RESOURCE_STATE_GENERIC_READ;
+
+		FfxResourceInternal copySource = {};
+
+		if (auto result = backendInterface->fpCreateResource(backendInterface, &uploadDescription, effectContextId, &copySource);
+			result != FFX_OK)
+			return result;
+
+		FfxGpuJobDescription copyJob = { FFX_GPU_JOB_COPY, L"Resource Initialization Copy" };
+		copyJob.copyJobDescriptor.src = copySource;
+		copyJob.copyJobDescriptor.dst = *outResource;
+
+		return backendInterface->fpScheduleGpuJob(backendInterface, &copyJob);
+	}
+
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::RegisterResource(
+	FfxInterface *backendInterface,
+	const FfxResource *inResource,
+	FfxUInt32 effectContextId,
+	FfxResourceInternal *outResource)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+	auto& effectContext = state->EffectContexts[effectContextId];
+
+	if (!inResource->resource)
+	{
+		outResource->internalIndex = 0;
+		return FFX_OK;
+	}
+
+	if (effectContext.NextDynamicResource <= effectContext.NextStaticResource)
+		return FFX_ERROR_OUT_OF_MEMORY;
+
+	outResource->internalIndex = effectContext.NextDynamicResource--;
+
+	auto& resource = state->Resources[outResource->internalIndex];
+	resource = {};
+	resource.Valid = true;
+	resource.Record.Name = inResource->name;
+	resource.Record.Description = inResource->description;
+	resource.Record.InitialState = inResource->state;
+	resource.Record.EffectContextId = effectContextId;
+	resource.Record.InternalIndex = outResource->internalIndex;
+	resource.Record.Size = GetResourceSize(inResource->description);
+	resource.Record.External = true;
+	resource.CurrentState = inResource->state;
+	resource.ExternalResource = inResource->resource;
+
+	state->Recording.Resources.emplace_back(resource.Record);
+	return FFX_OK;
+}
+
+FfxResource FFRecordingInterface::GetResource(FfxInterface *backendInterface, FfxResourceInternal resource)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+	FfxResource result = {};
+
+	if (auto entry = state->GetResource(resource.internalIndex); entry && entry->Valid)
+	{
+		result.resource = entry->ExternalResource ? entry->ExternalResource : entry;
+		result.description = entry->Record.Description;
+		result.state = entry->CurrentState;
+		entry->Record.Name.copy(result.name, FFX_RESOURCE_NAME_SIZE - 1);
+	}
+
+	return result;
+}
+
+FfxErrorCode FFRecordingInterface::UnregisterResources(FfxInterface *backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+	auto& effectContext = state->EffectContexts[effectContextId];
+
+	// Walk back all the resources that don't belong to us and reset them to their initial state
+	const uint32_t end = (effectContextId * FFX_MAX_RESOURCE_COUNT) + FFX_MAX_RESOURCE_COUNT;
+
+	for (uint32_t i = effectContext.NextDynamicResource + 1; i < end; i++)
+	{
+		state->AddBarrier(i, state->Resources[i].Record.InitialState);
+		state->Resources[i] = {};
+	}
+
+	effectContext.NextDynamicResource = end - 1;
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::RegisterStaticResource(
+	FfxInterface *backendInterface,
+	const FfxStaticResourceDescription *desc,
+	FfxUInt32 effectContextId)
+{
+	// Bindless tables aren't used by frame interpolation or optical flow
+	return FFX_OK;
+}
+
+FfxResourceDescription FFRecordingInterface::GetResourceDescription(FfxInterface *backendInterface, FfxResourceInternal resource)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	if (auto entry = state->GetResource(resource.internalIndex))
+		return entry->Record.Description;
+
+	return {};
+}
+
+FfxErrorCode FFRecordingInterface::DestroyResource(FfxInterface *backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+	auto& effectContext = state->EffectContexts[effectContextId];
+
+	if (resource.internalIndex < static_cast<int32_t>(effectContextId * FFX_MAX_RESOURCE_COUNT) ||
+		resource.internalIndex >= static_cast<int32_t>(effectContext.NextStaticResource))
+		return FFX_ERROR_OUT_OF_RANGE;
+
+	auto& entry = state->Resources[resource.internalIndex];
+
+	if (entry.Valid)
+	{
+		effectContext.MemoryUsage.totalUsageInBytes -= entry.Record.Size;
+
+		if ((entry.Record.Description.flags & FFX_RESOURCE_FLAGS_ALIASABLE) == FFX_RESOURCE_FLAGS_ALIASABLE)
+			effectContext.MemoryUsage.aliasableUsageInBytes -= entry.Record.Size;
+
+		entry = {};
+	}
+
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::MapResource(FfxInterface *backendInterface, FfxResourceInternal resource, void **ptr)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+	auto entry = state->GetResource(resource.internalIndex);
+
+	if (!entry || !entry->Valid)
+		return FFX_ERROR_OUT_OF_RANGE;
+
+	if (!entry->HostMemory)
+		entry->HostMemory = std::make_unique<uint8_t[]>(std::max<uint64_t>(entry->Record.Size, 1));
+
+	*ptr = entry->HostMemory.get();
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::UnmapResource(FfxInterface *backendInterface, FfxResourceInternal resource)
+{
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::StageConstantBufferData(
+	FfxInterface *backendInterface,
+	void *data,
+	FfxUInt32 size,
+	FfxConstantBuffer *constantBuffer)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	if (!data || !constantBuffer)
+		return FFX_ERROR_INVALID_POINTER;
+
+	if ((state->ConstantRingBufferBase + FFX_ALIGN_UP(size, 256)) >= FFX_CONSTANT_BUFFER_RING_BUFFER_SIZE)
+		state->ConstantRingBufferBase = 0;
+
+	auto dst = state->ConstantRingBuffer.get() + state->ConstantRingBufferBase;
+	memcpy(dst, data, size);
+
+	constantBuffer->data = reinterpret_cast<uint32_t *>(dst);
+	constantBuffer->num32BitEntries = size / sizeof(uint32_t);
+
+	state->ConstantRingBufferBase += FFX_ALIGN_UP(size, 256);
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::CreatePipeline(
+	FfxInterface *backendInterface,
+	FfxEffect effect,
+	FfxPass pass,
+	uint32_t permutationOptions,
+	const FfxPipelineDescription *pipelineDescription,
+	FfxUInt32 effectContextId,
+	FfxPipelineState *outPipeline)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	FfxShaderBlob shaderBlob = {};
+
+	if (auto result = backendInterface->fpGetPermutationBlobByIndex(effect, pass, FFX_BIND_COMPUTE_SHADER_STAGE, permutationOptions, &shaderBlob);
+		result != FFX_OK)
+		return result;
+
+	outPipeline->passId = pass;
+	outPipeline->srvTextureCount = FillBindings(
+		outPipeline->srvTextureBindings,
+		shaderBlob.srvTextureCount,
+		shaderBlob.boundSRVTextures,
+		shaderBlob.boundSRVTextureCounts,
+		shaderBlob.boundSRVTextureNames);
+	outPipeline->uavTextureCount = FillBindings(
+		outPipeline->uavTextureBindings,
+		shaderBlob.uavTextureCount,
+		shaderBlob.boundUAVTextures,
+		shaderBlob.boundUAVTextureCounts,
+		shaderBlob.boundUAVTextureNames);
+	outPipeline->srvBufferCount = FillBindings(
+		outPipeline->srvBufferBindings,
+		shaderBlob.srvBufferCount,
+		shaderBlob.boundSRVBuffers,
+		shaderBlob.boundSRVBufferCounts,
+		shaderBlob.boundSRVBufferNames);
+	outPipeline->uavBufferCount = FillBindings(
+		outPipeline->uavBufferBindings,
+		shaderBlob.uavBufferCount,
+		shaderBlob.boundUAVBuffers,
+		shaderBlob.boundUAVBufferCounts,
+		shaderBlob.boundUAVBufferNames);
+
+	for (uint32_t i = 0; i < shaderBlob.cbvCount; i++)
+	{
+		outPipeline->constantBufferBindings[i].slotIndex = shaderBlob.boundConstantBuffers[i];
+		outPipeline->constantBufferBindings[i].arrayIndex = 1;
+		CopyBindingName(outPipeline->constantBufferBindings[i].name, shaderBlob.boundConstantBufferNames[i]);
+	}
+
+	outPipeline->constCount = shaderBlob.cbvCount;
+	std::ranges::copy(pipelineDescription->name, outPipeline->name);
+
+	std::scoped_lock lock(state->PipelineMutex);
+	auto& record = state->Recording.Pipelines.emplace_back();
+	record.Name = outPipeline->name;
+	record.Effect = effect;
+	record.Pass = pass;
+	record.PermutationOptions = permutationOptions;
+	record.EffectContextId = effectContextId;
+	record.SrvTextureCount = outPipeline->srvTextureCount;
+	record.UavTextureCount = outPipeline->uavTextureCount;
+	record.SrvBufferCount = outPipeline->srvBufferCount;
+	record.UavBufferCount = outPipeline->uavBufferCount;
+	record.ConstantBufferCount = outPipeline->constCount;
+
+	// Effects test these for null before dispatching. Hand out the 1-based record index instead.
+	const auto handle = reinterpret_cast<void *>(state->Recording.Pipelines.size());
+	outPipeline->pipeline = handle;
+	outPipeline->rootSignature = handle;
+	outPipeline->cmdSignature = pipelineDescription->indirectWorkload ? handle : nullptr;
+
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::DestroyPipeline(FfxInterface *backendInterface, FfxPipelineState *pipeline, FfxUInt32 effectContextId)
+{
+	if (pipeline)
+	{
+		pipeline->pipeline = nullptr;
+		pipeline->rootSignature = nullptr;
+		pipeline->cmdSignature = nullptr;
+	}
+
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::ScheduleGpuJob(FfxInterface *backendInterface, const FfxGpuJobDescription *job)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	if (!job)
+		return FFX_ERROR_INVALID_POINTER;
+
+	state->PendingJobs.emplace_back(*job);
+	return FFX_OK;
+}
+
+FfxErrorCode FFRecordingInterface::ExecuteGpuJobs(FfxInterface *backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId)
+{
+	auto state = static_cast<FFRecordingInterface *>(backendInterface)->GetState();
+
+	for (auto& job : state->PendingJobs)
+	{
+		JobRecord record;
+		record.Type = job.jobType;
+		record.Label = job.jobLabel;
+		record.EffectContextId = effectContextId;
+		record.Submission = state->SubmissionCount;
+
+		switch (job.jobType)
+		{
+		case FFX_GPU_JOB_CLEAR_FLOAT:
+			state->AddBarrier(job.clearJobDescriptor.target.internalIndex, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+			record.Resources.emplace_back(job.clearJobDescriptor.target.internalIndex);
+			break;
+
+		case FFX_GPU_JOB_COPY:
+			state->AddBarrier(job.copyJobDescriptor.src.internalIndex, FFX_RESOURCE_STATE_COPY_SRC);
+			state->AddBarrier(job.copyJobDescriptor.dst.internalIndex, FFX_RESOURCE_STATE_COPY_DEST);
+			record.Resources.emplace_back(job.copyJobDescriptor.src.internalIndex);
+			record.Resources.emplace_back(job.copyJobDescriptor.dst.internalIndex);
+			break;
+
+		case FFX_GPU_JOB_COMPUTE:
+		{
+			const auto& compute = job.computeJobDescriptor;
+
+			if (record.Label.empty())
+				record.Label = compute.pipeline.name;
+
+			for (uint32_t i = 0; i < compute.pipeline.uavTextureCount; i++)
+				state->AddBarrier(compute.uavTextures[i].resource.internalIndex, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+
+			for (uint32_t i = 0; i < compute.pipeline.uavBufferCount; i++)
+				state->AddBarrier(compute.uavBuffers[i].resource.internalIndex, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+
+			for (uint32_t i = 0; i < compute.pipeline.srvTextureCount; i++)
+				state->AddBarrier(compute.srvTextures[i].resource.internalIndex, FFX_RESOURCE_STATE_COMPUTE_READ);
+
+			for (uint32_t i = 0; i < compute.pipeline.srvBufferCount; i++)
+				state->AddBarrier(compute.srvBuffers[i].resource.internalIndex, FFX_RESOURCE_STATE_COMPUTE_READ);
+
+			if (compute.pipeline.cmdSignature)
+				state->AddBarrier(compute.cmdArgument.internalIndex, FFX_RESOURCE_STATE_INDIRECT_ARGUMENT);
+
+			record.Dimensions = { compute.dimensions[0], compute.dimensions[1], compute.dimensions[2] };
+
+			for (uint32_t i = 0; i < compute.pipeline.constCount; i++)
+				record.ConstantBufferSizes.emplace_back(compute.cbs[i].num32BitEntries * static_cast<uint32_t>(sizeof(uint32_t)));
+			break;
+		}
+
+		case FFX_GPU_JOB_BARRIER:
+			state->AddBarrier(job.barrierDescriptor.resource.internalIndex, job.barrierDescriptor.newState);
+			record.Resources.emplace_back(job.barrierDescriptor.resource.internalIndex);
+			break;
+
+		case FFX_GPU_JOB_DISCARD:
+			state->AddBarrier(job.discardJobDescriptor.target.internalIndex, FFX_RESOURCE_STATE_UNORDERED_ACCESS);
+			record.Resources.emplace_back(job.discardJobDescriptor.target.internalIndex);
+			break;
+
+		default:
+			break;
+		}
+
+		state->Recording.Jobs.emplace_back(std::move(record));
+	}
+
+	state->PendingJobs.clear();
+	state->SubmissionCount++;
+
+	return FFX_OK;
+}
+
+void FFRecordingInterface::RegisterConstantBufferAllocator(FfxInterface *backendInterface, FfxConstantBufferAllocator constantAllocator)
+{
+	// Constant data is always staged through the ring buffer above
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <FidelityFX/host/ffx_interface.h>
+
+// Backend interface that never touches a GPU. Every callback is logged instead, letting effect contexts run their host
+// side logic unmodified so pass order, dispatch sizes, barriers and allocation volume can be inspected and diffed.
+//
+// Resource indices, barrier rules and job ordering mirror the DX12 backend.
+class FFRecordingInterface : public FfxInterface
+{
+public:
+	struct ResourceRecord
+	{
+		std::wstring Name;
+		FfxResourceDescription Description = {};
+		FfxResourceStates InitialState = FFX_RESOURCE_STATE_COMMON;
+		FfxHeapType HeapType = FFX_HEAP_TYPE_DEFAULT;
+		FfxUInt32 EffectContextId = 0;
+		int32_t InternalIndex = 0;
+		uint64_t Size = 0;
+		bool External = false; // Registered by the caller, not created by the backend
+	};
+
+	struct PipelineRecord
+	{
+		std::wstring Name;
+		FfxEffect Effect = {};
+		FfxPass Pass = {};
+		uint32_t PermutationOptions = 0;
+		FfxUInt32 EffectContextId = 0;
+		uint32_t SrvTextureCount = 0;
+		uint32_t UavTextureCount = 0;
+		uint32_t SrvBufferCount = 0;
+		uint32_t UavBufferCount = 0;
+		uint32_t ConstantBufferCount = 0;
+	};
+
+	struct JobRecord
+	{
+		FfxGpuJobType Type = FFX_GPU_JOB_COMPUTE;
+		std::wstring Label; // Job label, or the pipeline name for unlabeled dispatches
+		FfxUInt32 EffectContextId = 0;
+		uint32_t Submission = 0; // Index of the fpExecuteGpuJobs call that consumed this job
+		std::array<uint32_t, 3> Dimensions = {};
+		std::vector<uint32_t> ConstantBufferSizes;
+		std::vector<int32_t> Resources; // Clear/discard target, copy source and destination, or barrier target
+	};
+
+	struct BarrierRecord
+	{
+		size_t JobIndex = 0; // Job that required the transition. Equal to the job count for UnregisterResources.
+		int32_t InternalIndex = 0;
+		FfxResourceStates Before = FFX_RESOURCE_STATE_COMMON;
+		FfxResourceStates After = FFX_RESOURCE_STATE_COMMON;
+	};
+
+	struct Totals
+	{
+		uint64_t JobCount = 0;
+		uint64_t DispatchCount = 0;
+		uint64_t BarrierCount = 0;
+		uint64_t ResourceCount = 0;
+		uint64_t PipelineCount = 0;
+		uint64_t AllocatedBytes = 0;
+		uint64_t ConstantBufferBytes = 0;
+	};
+
+	struct Log
+	{
+		std::vector<ResourceRecord> Resources;
+		std::vector<PipelineRecord> Pipelines;
+		std::vector<JobRecord> Jobs;
+		std::vector<BarrierRecord> Barriers;
+
+		Totals GetTotals() const;
+	};
+
+	FFRecordingInterface();
+	FFRecordingInterface(const FFRecordingInterface&) = delete;
+	FFRecordingInterface& operator=(const FFRecordingInterface&) = delete;
+	FFRecordingInterface(FFRecordingInterface&&) = delete;
+	~FFRecordingInterface();
+
+	// Shader blobs are still needed to derive the binding layout of each pass. Pass ffxGetPermutationBlobByIndex from
+	// the shared backend code.
+	FfxErrorCode Initialize(FfxGetPermutationBlobByIndexFunc GetPermutationBlob, uint32_t MaxContexts);
+
+	const Log& GetLog() const;
+	void ResetLog();
+
+	// Returns a description of every total in Current that grew by more than Tolerance (a fraction) over Baseline
+	static std::vector<std::string> FindRegressions(const Totals& Baseline, const Totals& Current, double Tolerance = 0.0);
+
+private:
+	struct State;
+	State *GetState() const;
+
+	static FfxVersionNumber GetSDKVersion(FfxInterface *backendInterface);
+	static FfxErrorCode GetEffectGpuMemoryUsage(FfxInterface *backendInterface, FfxUInt32 effectContextId, FfxEffectMemoryUsage *outVramUsage);
+	static FfxErrorCode CreateBackendContext(
+		FfxInterface *backendInterface,
+		FfxEffect effect,
+		FfxEffectBindlessConfig *bindlessConfig,
+		FfxUInt32 *effectContextId);
+	static FfxErrorCode GetDeviceCapabilities(FfxInterface *backendInterface, FfxDeviceCapabilities *outDeviceCapabilities);
+	static FfxErrorCode DestroyBackendContext(FfxInterface *backendInterface, FfxUInt32 effectContextId);
+	static FfxErrorCode CreateResource(
+		FfxInterface *backendInterface,
+		const FfxCreateResourceDescription *createResourceDescription,
+		FfxUInt32 effectContextId,
+		FfxResourceInternal *outResource);
+	static FfxErrorCode RegisterResource(
+		FfxInterface *backendInterface,
+		const FfxResource *inResource,
+		FfxUInt32 effectContextId,
+		FfxResourceInternal *outResource);
+	static FfxResource GetResource(FfxInterface *backendInterface, FfxResourceInternal resource);
+	static FfxErrorCode UnregisterResources(FfxInterface *backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+	static FfxErrorCode RegisterStaticResource(FfxInterface *backendInterface, const FfxStaticResourceDescription *desc, FfxUInt32 effectContextId);
+	static FfxResourceDescription GetResourceDescription(FfxInterface *backendInterface, FfxResourceInternal resource);
+	static FfxErrorCode DestroyResource(FfxInterface *backendInterface, FfxResourceInternal resource, FfxUInt32 effectContextId);
+	static FfxErrorCode MapResource(FfxInterface *backendInterface, FfxResourceInternal resource, void **ptr);
+	static FfxErrorCode UnmapResource(FfxInterface *backendInterface, FfxResourceInternal resource);
+	static FfxErrorCode StageConstantBufferData(FfxInterface *backendInterface, void *data, FfxUInt32 size, FfxConstantBuffer *constantBuffer);
+	static FfxErrorCode CreatePipeline(
+		FfxInterface *backendInterface,
+		FfxEffect effect,
+		FfxPass pass,
+		uint32_t permutationOptions,
+		const FfxPipelineDescription *pipelineDescription,
+		FfxUInt32 effectContextId,
+		FfxPipelineState *outPipeline);
+	static FfxErrorCode DestroyPipeline(FfxInterface *backendInterface, FfxPipelineState *pipeline, FfxUInt32 effectContextId);
+	static FfxErrorCode ScheduleGpuJob(FfxInterface *backendInterface, const FfxGpuJobDescription *job);
+	static FfxErrorCode ExecuteGpuJobs(FfxInterface *backendInterface, FfxCommandList commandList, FfxUInt32 effectContextId);
+	static void RegisterConstantBufferAllocator(FfxInterface *backendInterface, FfxConstantBufferAllocator constantAllocator);
+};
+static_assert(sizeof(FFRecordingInterface) == sizeof(FfxInterface));
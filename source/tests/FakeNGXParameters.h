@@ -0,0 +1,54 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include "NGX/NvNGX.h"
+
+// In-process stand-in for the Streamline parameter map. Only the getters used by the plugin are backed by storage.
+class FakeNGXParameters : public NGXInstanceParameters
+{
+private:
+	std::map<std::string, void *, std::less<>> m_Pointers;
+	std::map<std::string, float, std::less<>> m_Floats;
+	std::map<std::string, uint32_t, std::less<>> m_UInts;
+
+public:
+	void SetVoidPointer(const char *Name, void *Value) override { m_Pointers[Name] = Value; }
+	void Set2(const char *Name, float Value) override { m_Floats[Name] = Value; }
+	void Set3(const char *, void *) override {}
+	void Set4(const char *Name, uint32_t Value) override { m_UInts[Name] = Value; }
+	void Set5(const char *Name, uint32_t Value) override { m_UInts[Name] = Value; }
+	void Set6(const char *, void *) override {}
+	void Set7(const char *Name, struct ID3D12Resource *Value) override { m_Pointers[Name] = Value; }
+	void Set8(const char *Name, void *Value) override { m_Pointers[Name] = Value; }
+
+	NGXResult GetVoidPointer(const char *Name, void **Value) override { return Get(m_Pointers, Name, Value); }
+	NGXResult Get2(const char *Name, float *Value) override { return Get(m_Floats, Name, Value); }
+	NGXResult Get3(const char *, void *) override { return NGX_INVALID_PARAMETER; }
+	NGXResult Get4(const char *Name, uint32_t *Value) override { return Get(m_UInts, Name, Value); }
+	NGXResult Get5(const char *Name, uint32_t *Value) override { return Get(m_UInts, Name, Value); }
+	NGXResult Get6(const char *, void *) override { return NGX_INVALID_PARAMETER; }
+	NGXResult Get7(const char *Name, float *Value) override { return Get(m_Floats, Name, Value); }
+	NGXResult Get8(const char *, void *) override { return NGX_INVALID_PARAMETER; }
+	void Unknown() override {}
+
+	void Remove(std::string_view Name)
+	{
+		m_Pointers.erase(std::string(Name));
+		m_Floats.erase(std::string(Name));
+		m_UInts.erase(std::string(Name));
+	}
+
+private:
+	template<typename T>
+	static NGXResult Get(const std::map<std::string, T, std::less<>>& Values, const char *Name, T *Value)
+	{
+		const auto itr = Values.find(std::string_view(Name));
+
+		if (itr == Values.end())
+			return NGX_INVALID_PARAMETER;
+
+		*Value = itr->second;
+		return NGX_SUCCESS;
+	}
+};
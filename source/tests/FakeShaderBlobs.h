@@ -0,0 +1,90 @@
+#pragma once
+
+#include <FidelityFX/host/ffx_frameinterpolation.h>
+#include <FidelityFX/host/ffx_opticalflow.h>
+
+// Shader reflection for the recording backend. Real permutation blobs are generated by the SDK build on Windows, so
+// every pass gets the constant buffers it reads plus a few named bindings. Enough to run the effects' binding patching
+// and to see barriers on the resources the tests care about.
+namespace FakeShaderBlobs
+{
+	struct PassLayout
+	{
+		std::vector<const char *> ConstantBufferNames;
+		std::vector<const char *> SrvTextureNames;
+		std::vector<const char *> UavTextureNames;
+	};
+
+	inline const PassLayout& GetLayout(FfxEffect Effect, FfxPass Pass)
+	{
+		static const PassLayout frameInterpolation = { .ConstantBufferNames = { "cbFI" } };
+		static const PassLayout frameInterpolationPyramid = { .ConstantBufferNames = { "cbFI", "cbInpaintingPyramid" } };
+		static const PassLayout frameInterpolationOutput = {
+			.ConstantBufferNames = { "cbFI" },
+			.SrvTextureNames = { "r_current_interpolation_source" },
+			.UavTextureNames = { "rw_output" },
+		};
+		static const PassLayout opticalFlow = { .ConstantBufferNames = { "cbOF" } };
+		static const PassLayout opticalFlowPyramid = { .ConstantBufferNames = { "cbOF", "cbOF_SPD" } };
+		static const PassLayout opticalFlowOutput = { .ConstantBufferNames = { "cbOF" }, .UavTextureNames = { "rw_optical_flow" } };
+
+		if (Effect == FFX_EFFECT_OPTICALFLOW)
+		{
+			switch (Pass)
+			{
+			case FFX_OPTICALFLOW_PASS_GENERATE_OPTICAL_FLOW_INPUT_PYRAMID:
+				return opticalFlowPyramid;
+
+			case FFX_OPTICALFLOW_PASS_COMPUTE_OPTICAL_FLOW_ADVANCED_V5:
+				return opticalFlowOutput;
+
+			default:
+				return opticalFlow;
+			}
+		}
+
+		switch (Pass)
+		{
+		case FFX_FRAMEINTERPOLATION_PASS_INPAINTING_PYRAMID:
+		case FFX_FRAMEINTERPOLATION_PASS_GAME_VECTOR_FIELD_INPAINTING_PYRAMID:
+			return frameInterpolationPyramid;
+
+		case FFX_FRAMEINTERPOLATION_PASS_INTERPOLATION:
+			return frameInterpolationOutput;
+
+		default:
+			return frameInterpolation;
+		}
+	}
+
+	inline FfxErrorCode GetPermutationBlob(FfxEffect Effect, FfxPass Pass, FfxBindStage, uint32_t, FfxShaderBlob *OutBlob)
+	{
+		if (Effect != FFX_EFFECT_FRAMEINTERPOLATION && Effect != FFX_EFFECT_OPTICALFLOW)
+			return FFX_ERROR_INVALID_ARGUMENT;
+
+		// Slots and counts are only read up to each binding type's count. One shared array of zeros and ones covers all.
+		static const uint32_t slots[8] = {};
+		static const uint32_t counts[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+
+		auto& layout = GetLayout(Effect, Pass);
+
+		const FfxShaderBlob blob = {
+			.cbvCount = static_cast<uint32_t>(layout.ConstantBufferNames.size()),
+			.srvTextureCount = static_cast<uint32_t>(layout.SrvTextureNames.size()),
+			.uavTextureCount = static_cast<uint32_t>(layout.UavTextureNames.size()),
+			.boundConstantBufferNames = const_cast<const char **>(layout.ConstantBufferNames.data()),
+			.boundConstantBuffers = slots,
+			.boundConstantBufferCounts = counts,
+			.boundSRVTextureNames = const_cast<const char **>(layout.SrvTextureNames.data()),
+			.boundSRVTextures = slots,
+			.boundSRVTextureCounts = counts,
+			.boundUAVTextureNames = const_cast<const char **>(layout.UavTextureNames.data()),
+			.boundUAVTextures = slots,
+			.boundUAVTextureCounts = counts,
+		};
+
+		// Members are const, so the blob can't simply be assigned
+		memcpy(OutBlob, &blob, sizeof(blob));
+		return FFX_OK;
+	}
+}
@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include "FrameCaptureReader.h"
+
+class FrameCaptureTest : public testing::Test
+{
+protected:
+	struct TextureDescription
+	{
+		uint32_t Width;
+		uint32_t Height;
+		FfxSurfaceFormat Format;
+		bool Compressible;
+	};
+
+	// Backbuffer spans several LZ4 blocks, Depth is noise and gets stored raw, MVecs isn't bound
+	const std::array<std::optional<TextureDescription>, FrameCapture::TextureCount> m_Descriptions = {
+		TextureDescription { 1100, 1000, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, true },
+		TextureDescription { 320, 200, FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT, true },
+		TextureDescription { 64, 64, FFX_SURFACE_FORMAT_R32_FLOAT, false },
+		std::nullopt,
+	};
+
+	std::filesystem::path m_Path;
+	std::unordered_map<const FrameCapture::Slot *, std::vector<uint8_t>> m_ReadbackMemory;
+	std::vector<std::array<std::vector<uint8_t>, FrameCapture::TextureCount>> m_Expected;
+
+	void SetUp() override
+	{
+		const auto testName = testing::UnitTest::GetInstance()->current_test_info()->name();
+		m_Path = std::filesystem::temp_directory_path() / (std::string("dlssg_to_fsr3_capture_") + testName + ".bin");
+	}
+
+	void TearDown() override
+	{
+		std::error_code ec;
+		std::filesystem::remove(m_Path, ec);
+	}
+
+	static std::vector<uint8_t> MakeRows(uint32_t FrameIndex, uint32_t TextureIndex, size_t Size, bool Compressible)
+	{
+		std::vector<uint8_t> rows(Size);
+		std::mt19937 random(FrameIndex * FrameCapture::TextureCount + TextureIndex);
+
+		for (size_t i = 0; i < rows.size(); i++)
+			rows[i] = Compressible ? static_cast<uint8_t>((i / 64) + FrameIndex * 7 + TextureIndex) : static_cast<uint8_t>(random());
+
+		return rows;
+	}
+
+	// Stands in for the API-specific frame interpolator and the GPU: fills each slot's readback buffer and writes the
+	// marker right away
+	void Capture(FrameCapture& Capture, uint32_t FrameCount)
+	{
+		DLSSGFrameInputs inputs;
+		std::array<FfxResource, FrameCapture::TextureCount> resources = {};
+		std::array<const FfxResource *, FrameCapture::TextureCount> textures = {};
+
+		for (uint32_t i = 0; i < FrameCapture::TextureCount; i++)
+		{
+			if (!m_Descriptions[i])
+				continue;
+
+			resources[i].resource = &resources[i];
+			resources[i].description.type = FFX_RESOURCE_TYPE_TEXTURE2D;
+			resources[i].description.format = m_Descriptions[i]->Format;
+			resources[i].description.width = m_Descriptions[i]->Width;
+			resources[i].description.height = m_Descriptions[i]->Height;
+			textures[i] = &resources[i];
+		}
+
+		std::vector<FrameCapture::Slot *> submitted;
+
+		while (m_Expected.size() < FrameCount)
+		{
+			const auto frameIndex = static_cast<uint32_t>(m_Expected.size());
+			inputs.Reset = frameIndex == 0;
+			inputs.JitterOffset = { 0.25f * frameIndex, -0.5f };
+
+			auto slot = Capture.BeginFrame(inputs, textures);
+
+			// Ring is full. Dropped frames still count as source frames.
+			if (!slot)
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				continue;
+			}
+
+			auto& memory = m_ReadbackMemory[slot];
+
+			if (memory.size() < slot->RequiredSize)
+			{
+				memory.resize(slot->RequiredSize);
+				slot->Buffer = { .Handle = &memory, .Data = memory.data(), .Size = memory.size() };
+			}
+
+			auto& expected = m_Expected.emplace_back();
+
+			for (uint32_t i = 0; i < FrameCapture::TextureCount; i++)
+			{
+				const auto& layout = slot->Layouts[i];
+
+				if (layout.RowPitch == 0)
+					continue;
+
+				expected[i] = MakeRows(frameIndex, i, static_cast<size_t>(layout.RowPitch) * layout.RowCount, m_Descriptions[i]->Compressible);
+				memcpy(memory.data() + layout.Offset, expected[i].data(), expected[i].size());
+			}
+
+			memcpy(memory.data() + FrameCapture::MarkerOffset, &slot->Serial, sizeof(slot->Serial));
+			Capture.SubmitFrame(slot);
+			submitted.push_back(slot);
+		}
+
+		// The writer thread has to be done with every frame before it's stopped
+		for (auto slot : submitted)
+		{
+			while (slot->Status.load() != FrameCapture::Slot::State::Free)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		uint32_t destroyedBuffers = 0;
+		Capture.Stop([&](const FrameCapture::ReadbackBuffer&) { destroyedBuffers++; });
+		EXPECT_EQ(destroyedBuffers, m_ReadbackMemory.size());
+	}
+
+	void ExpectFrameMatches(FrameCaptureReader& Reader, uint32_t FrameIndex)
+	{
+		const auto frame = Reader.ReadFrame(FrameIndex);
+
+		EXPECT_EQ(frame.Record.FrameIndex, FrameIndex);
+		EXPECT_GE(frame.Record.SourceFrameIndex, FrameIndex);
+		EXPECT_EQ((frame.Record.Flags & FrameCapture::FrameFlagReset) != 0, FrameIndex == 0);
+		EXPECT_EQ(frame.Record.JitterOffset[0], 0.25f * FrameIndex);
+
+		for (uint32_t i = 0; i < FrameCapture::TextureCount; i++)
+		{
+			const auto& texture = frame.Record.Textures[i];
+
+			if (!m_Descriptions[i])
+			{
+				EXPECT_EQ(texture.RowPitch, 0u);
+				continue;
+			}
+
+			EXPECT_EQ(texture.Width, m_Descriptions[i]->Width);
+			EXPECT_EQ(texture.Height, m_Descriptions[i]->Height);
+			EXPECT_EQ(texture.Format, static_cast<uint32_t>(m_Descriptions[i]->Format));
+			EXPECT_EQ(texture.RowPitch % FrameCapture::RowPitchAlignment, 0u);
+			EXPECT_TRUE(frame.Textures[i] == m_Expected[FrameIndex][i]) << "Texture " << i << " of frame " << FrameIndex;
+		}
+	}
+
+	FrameCapture::FileHeader ReadFileHeader() const
+	{
+		FrameCapture::FileHeader header = {};
+		std::ifstream file(m_Path, std::ios::binary);
+		file.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+		return header;
+	}
+};
+
+TEST_F(FrameCaptureTest, RoundTripsEveryFrame)
+{
+	{
+		FrameCapture capture(m_Path, 6);
+		Capture(capture, 6);
+	}
+
+	FrameCaptureReader reader(m_Path);
+	EXPECT_TRUE(reader.HasIndex());
+	ASSERT_EQ(reader.GetFrameCount(), 6u);
+
+	// Random access through the index
+	for (uint32_t i : { 5u, 0u, 3u, 1u, 4u, 2u })
+		ExpectFrameMatches(reader, i);
+
+	// Compressible rows actually compress
+	EXPECT_LT(std::filesystem::file_size(m_Path), m_Expected.size() * m_Expected[0][0].size());
+}
+
+TEST_F(FrameCaptureTest, StoppedCaptureKeepsWrittenFrames)
+{
+	{
+		FrameCapture capture(m_Path, 10);
+		Capture(capture, 3);
+	}
+
+	FrameCaptureReader reader(m_Path);
+	EXPECT_TRUE(reader.HasIndex());
+	ASSERT_EQ(reader.GetFrameCount(), 3u);
+	ExpectFrameMatches(reader, 2);
+}
+
+TEST_F(FrameCaptureTest, TruncatedCaptureIsWalked)
+{
+	{
+		FrameCapture capture(m_Path, 4);
+		Capture(capture, 4);
+	}
+
+	// Cut through the last chunk, the way a crash mid-write would leave the file
+	const auto header = ReadFileHeader();
+	std::filesystem::resize_file(m_Path, header.IndexOffset - 64);
+
+	FrameCaptureReader reader(m_Path);
+	EXPECT_FALSE(reader.HasIndex());
+	ASSERT_EQ(reader.GetFrameCount(), 4u);
+
+	for (uint32_t i = 0; i < 3; i++)
+		ExpectFrameMatches(reader, i);
+
+	const auto lastFrame = reader.ReadFrame(3);
+	EXPECT_FALSE(lastFrame.Textures[0].empty());
+	EXPECT_TRUE(lastFrame.Textures[2].empty());
+}
+
+TEST_F(FrameCaptureTest, RejectsCorruptFiles)
+{
+	{
+		FrameCapture capture(m_Path, 2);
+		Capture(capture, 2);
+	}
+
+	const auto header = ReadFileHeader();
+
+	const auto patchFile = [&](uint64_t Offset, const auto& Value)
+	{
+		std::fstream file(m_Path, std::ios::in | std::ios::out | std::ios::binary);
+		file.seekp(static_cast<std::streamoff>(Offset));
+		file.write(reinterpret_cast<const char *>(&Value), sizeof(Value));
+	};
+
+	// Index entry pointing into the middle of a chunk
+	FrameCapture::IndexEntry firstEntry = {};
+	{
+		std::ifstream file(m_Path, std::ios::binary);
+		file.seekg(static_cast<std::streamoff>(header.IndexOffset));
+		file.read(reinterpret_cast<char *>(&firstEntry), sizeof(firstEntry));
+	}
+
+	patchFile(header.IndexOffset, firstEntry.Offset + 16);
+	EXPECT_THROW(FrameCaptureReader { m_Path }, std::runtime_error);
+	patchFile(header.IndexOffset, firstEntry.Offset);
+
+	// First block of the Backbuffer claims more data than the chunk holds
+	FrameCaptureReader reader(m_Path);
+	ASSERT_EQ(reader.GetFrameCount(), 2u);
+
+	const uint64_t backbufferChunk = sizeof(FrameCapture::FileHeader) + sizeof(FrameCapture::ChunkHeader) +
+		sizeof(FrameCapture::FrameRecord);
+	patchFile(backbufferChunk + sizeof(FrameCapture::ChunkHeader), uint32_t(0x7FFFFFFF));
+
+	FrameCaptureReader corruptReader(m_Path);
+	EXPECT_THROW(corruptReader.ReadFrame(0), std::runtime_error);
+	EXPECT_NO_THROW(corruptReader.ReadFrame(1));
+	EXPECT_THROW(corruptReader.ReadFrame(2), std::out_of_range);
+
+	// Not a capture at all
+	patchFile(0, uint64_t(0));
+	EXPECT_THROW(FrameCaptureReader { m_Path }, std::runtime_error);
+}
+
+TEST(FrameCaptureReader, DecompressTextureChecksBlockSizes)
+{
+	std::vector<uint8_t> raw(1000, 0x42);
+	std::vector<uint8_t> stored(sizeof(uint32_t) + raw.size());
+
+	const uint32_t uncompressedHeader = static_cast<uint32_t>(raw.size()) | FrameCapture::BlockUncompressedFlag;
+	memcpy(stored.data(), &uncompressedHeader, sizeof(uncompressedHeader));
+	memcpy(stored.data() + sizeof(uncompressedHeader), raw.data(), raw.size());
+
+	std::vector<uint8_t> decoded(raw.size());
+	EXPECT_TRUE(FrameCaptureReader::DecompressTexture(stored, decoded));
+	EXPECT_EQ(decoded, raw);
+
+	// Short output, trailing input and truncated input
+	decoded.resize(raw.size() - 1);
+	EXPECT_FALSE(FrameCaptureReader::DecompressTexture(stored, decoded));
+
+	decoded.resize(raw.size());
+	stored.push_back(0);
+	EXPECT_FALSE(FrameCaptureReader::DecompressTexture(stored, decoded));
+
+	stored.resize(stored.size() - 2);
+	EXPECT_FALSE(FrameCaptureReader::DecompressTexture(stored, decoded));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "FrameGenerationGovernor.h"
+
+using Decision = FrameGenerationGovernor::Decision;
+
+// Feeds real frames at a fixed interval and returns the last decision
+static Decision RunFrames(FrameGenerationGovernor& Governor, double& Timestamp, double FrameTime, double Duration, uint32_t FrameMultiplier = 2)
+{
+	for (const double end = Timestamp + Duration; Timestamp < end;)
+	{
+		Timestamp += FrameTime;
+		Governor.OnRealFrame(Timestamp, FrameMultiplier);
+	}
+
+	return Governor.GetDecision();
+}
+
+// Feeds real frames at a fixed interval until the decision changes and returns how long that took
+static double RunUntilTransition(FrameGenerationGovernor& Governor, double& Timestamp, double FrameTime, uint32_t FrameMultiplier = 2)
+{
+	const auto initialDecision = Governor.GetDecision();
+	const double start = Timestamp;
+
+	while (Governor.GetDecision() == initialDecision && Timestamp - start < 60.0)
+	{
+		Timestamp += FrameTime;
+		Governor.OnRealFrame(Timestamp, FrameMultiplier);
+	}
+
+	return Timestamp - start;
+}
+
+TEST(FrameGenerationGovernor, EngagesAfterBaseline)
+{
+	FrameGenerationGovernor governor({});
+	double timestamp = 0.0;
+
+	EXPECT_EQ(governor.GetDecision(), Decision::PassThrough);
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 60.0, 0.5), Decision::PassThrough);
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 60.0, 1.0), Decision::Generate);
+
+	// Interpolation history is stale after passing frames through
+	EXPECT_TRUE(governor.ConsumeResetRequest());
+	EXPECT_FALSE(governor.ConsumeResetRequest());
+}
+
+TEST(FrameGenerationGovernor, PassesThroughAtFrameRateCap)
+{
+	FrameGenerationGovernor governor({ .TargetFrameRate = 120.0 });
+	double timestamp = 0.0;
+
+	// 50 real fps doubled stays below the cap
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 50.0, 1.5), Decision::Generate);
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 50.0, 2.0), Decision::Generate);
+
+	// 62 real fps presents 124 fps, which is already at the cap
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 62.0, 4.0), Decision::PassThrough);
+
+	// Hysteresis: 55 real fps would present 110 fps, above the 0.85 disengage ratio
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 55.0, 4.0), Decision::PassThrough);
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 45.0, 4.0), Decision::Generate);
+}
+
+TEST(FrameGenerationGovernor, BacksOffAfterRegression)
+{
+	FrameGenerationGovernor governor({});
+	double timestamp = 0.0;
+
+	ASSERT_NEAR(RunUntilTransition(governor, timestamp, 1.0 / 60.0), 1.0, 0.05);
+
+	// Generation halves the real frame rate. Detected once the state has lasted long enough.
+	EXPECT_NEAR(RunUntilTransition(governor, timestamp, 1.0 / 30.0), 1.0, 0.05);
+	EXPECT_EQ(governor.GetDecision(), Decision::PassThrough);
+
+	// First retry waits twice the minimum state duration, the next one twice as long again
+	EXPECT_NEAR(RunUntilTransition(governor, timestamp, 1.0 / 60.0), 2.0, 0.05);
+	EXPECT_NEAR(RunUntilTransition(governor, timestamp, 1.0 / 30.0), 1.0, 0.05);
+	EXPECT_NEAR(RunUntilTransition(governor, timestamp, 1.0 / 60.0), 4.0, 0.05);
+	EXPECT_EQ(governor.GetDecision(), Decision::Generate);
+
+	// Paying off for a full state duration clears the back-off
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 60.0, 1.5), Decision::Generate);
+	EXPECT_LT(RunUntilTransition(governor, timestamp, 1.0 / 30.0), 1.0);
+	EXPECT_NEAR(RunUntilTransition(governor, timestamp, 1.0 / 60.0), 2.0, 0.05);
+}
+
+TEST(FrameGenerationGovernor, HitchesRestartMeasurements)
+{
+	FrameGenerationGovernor governor({});
+	double timestamp = 0.0;
+
+	ASSERT_EQ(RunFrames(governor, timestamp, 1.0 / 60.0, 1.5), Decision::Generate);
+
+	// A loading screen between two steady sections is not a regression
+	timestamp += 5.0;
+	governor.OnRealFrame(timestamp, 2);
+
+	EXPECT_EQ(RunFrames(governor, timestamp, 1.0 / 30.0, 0.9), Decision::Generate);
+}
@@ -0,0 +1,211 @@
+#include "NGX/NvNGXFeature.h"
+#include "FakeNGXParameters.h"
+#include "NvNGXHeadless.h"
+
+//
+// Replays the call sequence sl.dlss_g makes into the NGX exports, without a game, a GPU or Windows:
+//
+//   dlssg_to_fsr3_headless_host [frames] [width] [height] [multi frame count]
+//
+// Init_Ext2, PopulateParameters_Impl, GetFeatureRequirements, CreateFeature1, GetCurrentSettingsCallback and
+// EvaluateFeature once per frame, ReleaseFeature and Shutdown. Reports the latency of each step and exits with 1 when
+// the plugin broke its side of the parameter contract.
+//
+// The feature runs on FFRecordingInterface. Shaders aren't run. The FidelityFX shader permutations and GPU backends
+// are only built by the Windows SDK toolchain.
+//
+using Clock = std::chrono::steady_clock;
+
+struct LatencyStatistics
+{
+	uint32_t Count = 0;
+	double Min = std::numeric_limits<double>::max();
+	double Max = 0.0;
+	double Sum = 0.0;
+
+	void Add(Clock::time_point Start)
+	{
+		const auto milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+		Count++;
+		Min = std::min(Min, milliseconds);
+		Max = std::max(Max, milliseconds);
+		Sum += milliseconds;
+	}
+};
+
+class ContractChecker
+{
+private:
+	uint32_t m_ViolationCount = 0;
+
+public:
+	template<typename... Args>
+	void Expect(bool Condition, fmt::format_string<Args...> Format, Args&&...Arguments)
+	{
+		if (Condition)
+			return;
+
+		m_ViolationCount++;
+		spdlog::error(Format, std::forward<Args>(Arguments)...);
+	}
+
+	uint32_t GetViolationCount() const
+	{
+		return m_ViolationCount;
+	}
+};
+
+static void PrintLatency(const char *Name, const LatencyStatistics& Statistics)
+{
+	if (Statistics.Count == 0)
+		return;
+
+	spdlog::info(
+		"{:<24} {:>6} calls  min {:>9.3f} ms  avg {:>9.3f} ms  max {:>9.3f} ms",
+		Name,
+		Statistics.Count,
+		Statistics.Min,
+		Statistics.Sum / Statistics.Count,
+		Statistics.Max);
+}
+
+int main(int argc, char **argv)
+{
+	const auto frameCount = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 120u;
+	const auto width = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 1920u;
+	const auto height = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 1080u;
+	const auto multiFrameCount = argc > 4 ? static_cast<uint32_t>(std::stoul(argv[4])) : 1u;
+
+	if (frameCount == 0 || width <= 64 || height <= 64 || multiFrameCount == 0)
+	{
+		spdlog::error("Usage: dlssg_to_fsr3_headless_host [frames] [width] [height] [multi frame count]");
+		return 2;
+	}
+
+	spdlog::set_pattern("%v");
+
+	HeadlessDevice device;
+	HeadlessSwapchain swapchain(width, height, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM);
+	FakeNGXParameters parameters;
+	ContractChecker contract;
+
+	uint32_t commandList = 0; // Only has to be non-null
+	std::map<std::string, LatencyStatistics> latencies;
+
+	auto timed = [&](const char *Name, const auto& Call)
+	{
+		const auto start = Clock::now();
+		const auto result = Call();
+		latencies[Name].Add(start);
+
+		return result;
+	};
+
+	// Device and parameter setup
+	contract.Expect(
+		timed("Init_Ext2", [&] { return NVSDK_NGX_HEADLESS_Init_Ext2(&device, &parameters); }) == NGX_SUCCESS,
+		"Init_Ext2 failed");
+	contract.Expect(
+		timed("PopulateParameters_Impl", [&] { return NVSDK_NGX_HEADLESS_PopulateParameters_Impl(&parameters); }) == NGX_SUCCESS,
+		"PopulateParameters_Impl failed");
+
+	NGXFeature::EstimateVRAMFunc *estimateVRAM = nullptr;
+	parameters.GetVoidPointer("DLSSG.EstimateVRAMCallback", reinterpret_cast<void **>(&estimateVRAM));
+	contract.Expect(estimateVRAM != nullptr, "DLSSG.EstimateVRAMCallback is missing");
+
+	if (estimateVRAM)
+	{
+		size_t estimate = 0;
+		const auto result = estimateVRAM(3, width, height, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, 0, 0, 0, 0, 0, &estimate);
+
+		contract.Expect(result == NGX_SUCCESS && estimate > 0, "DLSSG.EstimateVRAMCallback returned {:X} with {} bytes", result, estimate);
+		contract.Expect(estimateVRAM(3, width, height, 0, 0, 0, 0, 0, 0, nullptr) == NGX_INVALID_PARAMETER, "DLSSG.EstimateVRAMCallback accepted a null output");
+		spdlog::info("Estimated VRAM: {:.1f} MB", estimate / (1024.0 * 1024.0));
+	}
+
+	const auto multiFrameCountMax = parameters.GetUIntOrDefault("DLSSG.MultiFrameCountMax", 0);
+	contract.Expect(
+		multiFrameCount <= multiFrameCountMax,
+		"Requested {} interpolated frames, DLSSG.MultiFrameCountMax is {}",
+		multiFrameCount,
+		multiFrameCountMax);
+
+	uint32_t featureDiscoveryInfo = 0;
+	NGXFeatureRequirementInfo requirements = {};
+	contract.Expect(
+		NVSDK_NGX_HEADLESS_GetFeatureRequirements(&featureDiscoveryInfo, &requirements) == NGX_SUCCESS &&
+			requirements.RequiredGPUArchitecture == NGXHardcodedArchitecture,
+		"GetFeatureRequirements failed");
+
+	// Feature lifetime
+	swapchain.SetCreateParameters(&parameters);
+
+	NGXHandle *handle = nullptr;
+	contract.Expect(
+		timed("CreateFeature1", [&] { return NVSDK_NGX_HEADLESS_CreateFeature1(&device, &commandList, &parameters, &handle); }) == NGX_SUCCESS &&
+			handle,
+		"CreateFeature1 failed");
+
+	if (!handle)
+		return 1;
+
+	contract.Expect(parameters.GetUIntOrDefault("DLSSG.MustCallEval", 0) == 1, "DLSSG.MustCallEval wasn't set by CreateFeature1");
+
+	using GetCurrentSettingsFunc = NGXResult(NGXHandle *, NGXInstanceParameters *);
+	GetCurrentSettingsFunc *getCurrentSettings = nullptr;
+	parameters.GetVoidPointer("DLSSG.GetCurrentSettingsCallback", reinterpret_cast<void **>(&getCurrentSettings));
+	contract.Expect(getCurrentSettings != nullptr, "DLSSG.GetCurrentSettingsCallback is missing");
+
+	uint32_t failedEvaluations = 0;
+
+	for (uint32_t frame = 0; frame < frameCount; frame++)
+	{
+		if (getCurrentSettings)
+		{
+			parameters.Remove("DLSSG.MustCallEval");
+			contract.Expect(getCurrentSettings(handle, &parameters) == NGX_SUCCESS, "GetCurrentSettingsCallback failed");
+			contract.Expect(parameters.GetUIntOrDefault("DLSSG.MustCallEval", 0) == 1, "DLSSG.MustCallEval wasn't set on frame {}", frame);
+		}
+
+		for (uint32_t index = 1; index <= multiFrameCount; index++)
+		{
+			swapchain.SetFrameParameters(&parameters, frame == 0, multiFrameCount, index);
+
+			if (timed("EvaluateFeature", [&] { return NVSDK_NGX_HEADLESS_EvaluateFeature(&commandList, handle, &parameters); }) != NGX_SUCCESS)
+				failedEvaluations++;
+		}
+	}
+
+	contract.Expect(failedEvaluations == 0, "{} EvaluateFeature calls failed", failedEvaluations);
+
+	uint64_t dispatchCount = 0;
+
+	for (auto& backend : device.Backends)
+		dispatchCount += backend.GetLog().GetTotals().DispatchCount;
+
+	contract.Expect(dispatchCount > 0, "No compute work was recorded");
+
+	contract.Expect(
+		timed("ReleaseFeature", [&] { return NVSDK_NGX_HEADLESS_ReleaseFeature(handle); }) == NGX_SUCCESS,
+		"ReleaseFeature failed");
+
+	// Released handles stay readable and are rejected from then on
+	contract.Expect(NVSDK_NGX_HEADLESS_EvaluateFeature(&commandList, handle, &parameters) == NGX_FEATURE_NOT_FOUND, "Released handle was evaluated");
+	contract.Expect(NVSDK_NGX_HEADLESS_ReleaseFeature(handle) == NGX_FEATURE_NOT_FOUND, "Released handle was released again");
+	contract.Expect(NVSDK_NGX_HEADLESS_Shutdown() == NGX_SUCCESS, "Shutdown failed");
+
+	spdlog::info("");
+	spdlog::info("{} frames at {}x{}, {} interpolated per real frame, {} dispatches recorded", frameCount, width, height, multiFrameCount, dispatchCount);
+
+	for (const char *name : { "Init_Ext2", "PopulateParameters_Impl", "CreateFeature1", "EvaluateFeature", "ReleaseFeature" })
+		PrintLatency(name, latencies[name]);
+
+	if (contract.GetViolationCount() != 0)
+	{
+		spdlog::error("{} contract violations", contract.GetViolationCount());
+		return 1;
+	}
+
+	return 0;
+}
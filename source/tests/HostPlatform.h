@@ -0,0 +1,50 @@
+#pragma once
+
+// Stand-ins for the few Windows calls reachable from the plugin and FidelityFX sources under test
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <algorithm> // Reached through other standard headers on MSVC
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <cwchar>
+
+#ifndef _countof
+#define _countof(Array) (sizeof(Array) / sizeof((Array)[0]))
+#endif
+
+#define __declspec(Attribute)
+
+inline void *GetModuleHandleW(const wchar_t *)
+{
+	return nullptr;
+}
+
+inline int wcscpy_s(wchar_t *Destination, size_t DestinationSize, const wchar_t *Source)
+{
+	if (!Destination || DestinationSize == 0 || !Source)
+		return EINVAL;
+
+	wcsncpy(Destination, Source, DestinationSize - 1);
+	Destination[DestinationSize - 1] = L'\0';
+	return 0;
+}
+
+template<size_t N>
+inline int wcscpy_s(wchar_t (&Destination)[N], const wchar_t *Source)
+{
+	return wcscpy_s(Destination, N, Source);
+}
+
+template<size_t N>
+inline int strcpy_s(char (&Destination)[N], const char *Source)
+{
+	if (!Source)
+		return EINVAL;
+
+	strncpy(Destination, Source, N - 1);
+	Destination[N - 1] = '\0';
+	return 0;
+}
+#endif
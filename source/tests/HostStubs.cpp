@@ -0,0 +1,126 @@
+#include "Config.h"
+#include "FFInterfaceWrapper.h"
+#include "HostStageProfiler.h"
+#include "LiveMetrics.h"
+#include "Util.h"
+
+// Link-time stand-ins for the pieces of the plugin that need a device, the DLL or the ini file. Tests install a
+// recording backend into the wrapper directly, so the wrapper owns nothing here.
+thread_local std::unique_lock<std::mutex> *FFInterfaceWrapper::m_PipelineCreationLock = nullptr;
+
+FFInterfaceWrapper::FFInterfaceWrapper()
+{
+	memset(static_cast<FfxInterface *>(this), 0, sizeof(FfxInterface));
+}
+
+FFInterfaceWrapper::~FFInterfaceWrapper()
+{
+}
+
+void FFInterfaceWrapper::SavePipelineCache()
+{
+}
+
+uint64_t FFInterfaceWrapper::QueryVRAMUsage(uint32_t MaxContexts)
+{
+	uint64_t totalUsage = 0;
+
+	for (uint32_t i = 0; fpGetEffectGpuMemoryUsage && i < MaxContexts; i++)
+	{
+		FfxEffectMemoryUsage usage = {};
+
+		if (fpGetEffectGpuMemoryUsage(this, i, &usage) == FFX_OK)
+			totalUsage += usage.totalUsageInBytes;
+	}
+
+	return totalUsage;
+}
+
+void FFInterfaceWrapper::LogMemoryStatistics(const char *Name)
+{
+}
+
+void FFInterfaceWrapper::SetPipelineCreationLock(std::unique_lock<std::mutex> *Lock)
+{
+	m_PipelineCreationLock = Lock;
+}
+
+std::shared_ptr<const Configuration> Config::Get()
+{
+	static const auto defaults = std::make_shared<const Configuration>();
+	return defaults;
+}
+
+bool Config::Reload()
+{
+	return false;
+}
+
+namespace Util
+{
+	const std::wstring& GetThisDllPath()
+	{
+		static const std::wstring path;
+		return path;
+	}
+
+	std::optional<std::pair<float, float>> FindHDROutputLuminanceRange(const std::array<uint8_t, 8>&)
+	{
+		return std::nullopt;
+	}
+
+	bool LogRateLimiter::TryAcquire(uint32_t& OutSuppressedCount)
+	{
+		OutSuppressedCount = 0;
+		return true;
+	}
+
+	void FlushLog()
+	{
+		spdlog::default_logger_raw()->flush();
+	}
+}
+
+namespace LiveMetrics
+{
+	bool IsEnabled()
+	{
+		return false;
+	}
+
+	void Publish(const Sample&)
+	{
+	}
+
+	void SetGpuPassMilliseconds(float)
+	{
+	}
+}
+
+// The real profiler formats its reports with <format>, which not every host compiler has yet
+HostStageProfiler::ScopedSample::ScopedSample(std::optional<HostStageProfiler>&, Stage Stage)
+	: m_Profiler(nullptr),
+	  m_Stage(Stage),
+	  m_Start()
+{
+}
+
+HostStageProfiler::ScopedSample::~ScopedSample()
+{
+}
+
+HostStageProfiler::HostStageProfiler(uint32_t WindowSize) : m_WindowSize(WindowSize)
+{
+}
+
+HostStageProfiler::~HostStageProfiler()
+{
+}
+
+void HostStageProfiler::BeginFrame()
+{
+}
+
+void HostStageProfiler::EndFrame(const Configuration&)
+{
+}
@@ -0,0 +1,157 @@
+#include "NGX/NvNGXFeature.h"
+#include "NvNGXHeadless.h"
+
+static NGXFeature::Registry<FFFrameInterpolatorHeadless> FeatureInstances;
+
+NGXResult NVSDK_NGX_HEADLESS_Init_Ext2(HeadlessDevice *Device, NGXInstanceParameters *)
+{
+	spdlog::info(__FUNCTION__);
+
+	if (!Device)
+		return NGX_INVALID_PARAMETER;
+
+	return NGX_SUCCESS;
+}
+
+// Same argument order as the D3D12 and Vulkan callbacks. BackbufferFormat is an FfxSurfaceFormat.
+static NGXResult EstimateVRAMCallback(
+	uint32_t SwapchainBufferCount,
+	uint32_t SwapchainWidth,
+	uint32_t SwapchainHeight,
+	uint32_t BackbufferFormat,
+	uint32_t,
+	uint32_t,
+	uint32_t,
+	uint32_t,
+	uint32_t,
+	size_t *EstimatedSize)
+{
+	if (!EstimatedSize)
+		return NGX_INVALID_PARAMETER;
+
+	*EstimatedSize = FFFrameInterpolator::EstimateVRAMUsage(
+		SwapchainBufferCount,
+		SwapchainWidth,
+		SwapchainHeight,
+		static_cast<FfxSurfaceFormat>(BackbufferFormat));
+	return NGX_SUCCESS;
+}
+
+NGXResult NVSDK_NGX_HEADLESS_PopulateParameters_Impl(NGXInstanceParameters *Parameters)
+{
+	spdlog::info(__FUNCTION__);
+
+	if (!Parameters)
+		return NGX_INVALID_PARAMETER;
+
+	NGXFeature::PopulateParameters(Parameters, &EstimateVRAMCallback);
+
+	return NGX_SUCCESS;
+}
+
+NGXResult NVSDK_NGX_HEADLESS_GetFeatureRequirements(void *FeatureDiscoveryInfo, NGXFeatureRequirementInfo *RequirementInfo)
+{
+	if (!FeatureDiscoveryInfo || !RequirementInfo)
+		return NGX_INVALID_PARAMETER;
+
+	NGXFeature::GetRequirements(RequirementInfo);
+
+	return NGX_SUCCESS;
+}
+
+NGXResult NVSDK_NGX_HEADLESS_CreateFeature1(
+	HeadlessDevice *Device,
+	void *,
+	NGXInstanceParameters *Parameters,
+	NGXHandle **OutInstanceHandle)
+{
+	spdlog::info(__FUNCTION__);
+
+	if (!Device || !Parameters || !OutInstanceHandle)
+		return NGX_INVALID_PARAMETER;
+
+	return FeatureInstances.Create(
+		__FUNCTION__,
+		Parameters,
+		OutInstanceHandle,
+		[&](uint32_t SwapchainWidth, uint32_t SwapchainHeight)
+		{
+			return std::make_shared<FFFrameInterpolatorHeadless>(Device, SwapchainWidth, SwapchainHeight, Parameters);
+		});
+}
+
+NGXResult NVSDK_NGX_HEADLESS_EvaluateFeature(void *CommandList, NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters)
+{
+	if (!CommandList || !InstanceHandle || !Parameters)
+		return NGX_INVALID_PARAMETER;
+
+	return FeatureInstances.Evaluate(__FUNCTION__, CommandList, InstanceHandle, Parameters);
+}
+
+NGXResult NVSDK_NGX_HEADLESS_ReleaseFeature(NGXHandle *InstanceHandle)
+{
+	spdlog::info(__FUNCTION__);
+
+	if (!InstanceHandle)
+		return NGX_INVALID_PARAMETER;
+
+	return FeatureInstances.Release(__FUNCTION__, InstanceHandle);
+}
+
+NGXResult NVSDK_NGX_HEADLESS_Shutdown()
+{
+	spdlog::info(__FUNCTION__);
+	Util::FlushLog();
+	return NGX_SUCCESS;
+}
+
+static FFFrameInterpolatorHeadless::Texture MakeTexture(uint32_t Width, uint32_t Height, FfxSurfaceFormat Format)
+{
+	FFFrameInterpolatorHeadless::Texture texture;
+	texture.Description.type = FFX_RESOURCE_TYPE_TEXTURE2D;
+	texture.Description.format = Format;
+	texture.Description.width = Width;
+	texture.Description.height = Height;
+	texture.Description.depth = 1;
+	texture.Description.mipCount = 1;
+
+	return texture;
+}
+
+HeadlessSwapchain::HeadlessSwapchain(uint32_t Width, uint32_t Height, FfxSurfaceFormat Format)
+	: m_Width(Width),
+	  m_Height(Height),
+	  m_Format(Format),
+	  m_Backbuffer(MakeTexture(Width, Height, Format)),
+	  m_Depth(MakeTexture(Width / 2, Height / 2, FFX_SURFACE_FORMAT_R32_FLOAT)),
+	  m_MotionVectors(MakeTexture(Width / 2, Height / 2, FFX_SURFACE_FORMAT_R16G16_FLOAT)),
+	  m_OutputReal(MakeTexture(Width, Height, Format)),
+	  m_OutputInterpolated(MakeTexture(Width, Height, Format))
+{
+}
+
+void HeadlessSwapchain::SetCreateParameters(NGXInstanceParameters *Parameters) const
+{
+	Parameters->Set5("Width", m_Width);
+	Parameters->Set5("Height", m_Height);
+	Parameters->Set5("DLSSG.BackbufferFormat", m_Format);
+	Parameters->Set5("DLSSG.DepthInverted", 1);
+}
+
+void HeadlessSwapchain::SetFrameParameters(NGXInstanceParameters *Parameters, bool Reset, uint32_t MultiFrameCount, uint32_t MultiFrameIndex)
+{
+	Parameters->SetVoidPointer("DLSSG.Backbuffer", &m_Backbuffer);
+	Parameters->SetVoidPointer("DLSSG.Depth", &m_Depth);
+	Parameters->SetVoidPointer("DLSSG.MVecs", &m_MotionVectors);
+	Parameters->SetVoidPointer("DLSSG.OutputReal", &m_OutputReal);
+	Parameters->SetVoidPointer("DLSSG.OutputInterpolated", &m_OutputInterpolated);
+
+	Parameters->Set5("DLSSG.EnableInterp", 1);
+	Parameters->Set5("DLSSG.Reset", Reset ? 1 : 0);
+	Parameters->Set5("DLSSG.MultiFrameCount", MultiFrameCount);
+	Parameters->Set5("DLSSG.MultiFrameIndex", MultiFrameIndex);
+	Parameters->Set5("DLSSG.DepthInverted", 1);
+	Parameters->Set2("DLSSG.CameraFOV", 1.0f);
+	Parameters->Set2("DLSSG.CameraNear", 0.1f);
+	Parameters->Set2("DLSSG.CameraFar", 1000.0f);
+}
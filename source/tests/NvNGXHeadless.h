@@ -0,0 +1,44 @@
+#pragma once
+
+#include "NGX/NvNGX.h"
+#include "FFFrameInterpolatorHeadless.h"
+
+// NGX entry points for FFFrameInterpolatorHeadless, shaped after the Vulkan exports. Handle bookkeeping and the
+// parameter contract with sl.dlss_g come from the same NGXFeature code the D3D12 and Vulkan exports use.
+using HeadlessDevice = FFFrameInterpolatorHeadless::Device;
+
+NGXResult NVSDK_NGX_HEADLESS_Init_Ext2(HeadlessDevice *Device, NGXInstanceParameters *Parameters);
+NGXResult NVSDK_NGX_HEADLESS_PopulateParameters_Impl(NGXInstanceParameters *Parameters);
+NGXResult NVSDK_NGX_HEADLESS_GetFeatureRequirements(void *FeatureDiscoveryInfo, NGXFeatureRequirementInfo *RequirementInfo);
+NGXResult NVSDK_NGX_HEADLESS_CreateFeature1(
+	HeadlessDevice *Device,
+	void *CommandList,
+	NGXInstanceParameters *Parameters,
+	NGXHandle **OutInstanceHandle);
+NGXResult NVSDK_NGX_HEADLESS_EvaluateFeature(void *CommandList, NGXHandle *InstanceHandle, NGXInstanceParameters *Parameters);
+NGXResult NVSDK_NGX_HEADLESS_ReleaseFeature(NGXHandle *InstanceHandle);
+NGXResult NVSDK_NGX_HEADLESS_Shutdown();
+
+// Game side textures and the DLSSG parameters sl.dlss_g sets for them
+class HeadlessSwapchain
+{
+private:
+	const uint32_t m_Width;
+	const uint32_t m_Height;
+	const FfxSurfaceFormat m_Format;
+
+	FFFrameInterpolatorHeadless::Texture m_Backbuffer;
+	FFFrameInterpolatorHeadless::Texture m_Depth;
+	FFFrameInterpolatorHeadless::Texture m_MotionVectors;
+	FFFrameInterpolatorHeadless::Texture m_OutputReal;
+	FFFrameInterpolatorHeadless::Texture m_OutputInterpolated;
+
+public:
+	HeadlessSwapchain(uint32_t Width, uint32_t Height, FfxSurfaceFormat Format);
+
+	// Read by CreateFeature1
+	void SetCreateParameters(NGXInstanceParameters *Parameters) const;
+
+	// Read by every EvaluateFeature call. Rendering happens at half resolution.
+	void SetFrameParameters(NGXInstanceParameters *Parameters, bool Reset, uint32_t MultiFrameCount, uint32_t MultiFrameIndex);
+};
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "NGX/NvNGXFeature.h"
+#include "FakeNGXParameters.h"
+#include "NvNGXHeadless.h"
+
+class NvNGXHeadlessTest : public testing::Test
+{
+protected:
+	HeadlessDevice m_Device;
+	HeadlessSwapchain m_Swapchain { 640, 360, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM };
+	FakeNGXParameters m_Parameters;
+	uint32_t m_CommandList = 0;
+
+	void SetUp() override
+	{
+		ASSERT_EQ(NVSDK_NGX_HEADLESS_Init_Ext2(&m_Device, &m_Parameters), NGX_SUCCESS);
+		ASSERT_EQ(NVSDK_NGX_HEADLESS_PopulateParameters_Impl(&m_Parameters), NGX_SUCCESS);
+
+		m_Swapchain.SetCreateParameters(&m_Parameters);
+	}
+
+	NGXHandle *CreateFeature()
+	{
+		NGXHandle *handle = nullptr;
+
+		EXPECT_EQ(NVSDK_NGX_HEADLESS_CreateFeature1(&m_Device, &m_CommandList, &m_Parameters, &handle), NGX_SUCCESS);
+		return handle;
+	}
+
+	uint64_t GetDispatchCount() const
+	{
+		uint64_t count = 0;
+
+		for (auto& backend : m_Device.Backends)
+			count += backend.GetLog().GetTotals().DispatchCount;
+
+		return count;
+	}
+};
+
+TEST_F(NvNGXHeadlessTest, PopulatesCallbacks)
+{
+	NGXFeature::EstimateVRAMFunc *estimateVRAM = nullptr;
+	void *getCurrentSettings = nullptr;
+
+	ASSERT_EQ(m_Parameters.GetVoidPointer("DLSSG.EstimateVRAMCallback", reinterpret_cast<void **>(&estimateVRAM)), NGX_SUCCESS);
+	ASSERT_EQ(m_Parameters.GetVoidPointer("DLSSG.GetCurrentSettingsCallback", &getCurrentSettings), NGX_SUCCESS);
+	EXPECT_EQ(m_Parameters.GetUIntOrDefault("DLSSG.MultiFrameCountMax", 0), FFFrameInterpolator::MaxMultiFrameCount);
+
+	size_t estimate = 0;
+	EXPECT_EQ(estimateVRAM(3, 1920, 1080, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, 0, 0, 0, 0, 0, &estimate), NGX_SUCCESS);
+	EXPECT_GT(estimate, 0u);
+	EXPECT_EQ(estimateVRAM(3, 1920, 1080, FFX_SURFACE_FORMAT_R8G8B8A8_UNORM, 0, 0, 0, 0, 0, nullptr), NGX_INVALID_PARAMETER);
+}
+
+TEST_F(NvNGXHeadlessTest, CreateRequestsEvaluation)
+{
+	const auto handle = CreateFeature();
+	ASSERT_NE(handle, nullptr);
+
+	EXPECT_EQ(m_Parameters.GetUIntOrDefault("DLSSG.MustCallEval", 0), 1u);
+	EXPECT_FALSE(m_Device.Backends.empty());
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_ReleaseFeature(handle), NGX_SUCCESS);
+}
+
+TEST_F(NvNGXHeadlessTest, EvaluatesEveryMultiFrameIndex)
+{
+	const auto handle = CreateFeature();
+	ASSERT_NE(handle, nullptr);
+
+	for (uint32_t frame = 0; frame < 4; frame++)
+	{
+		for (uint32_t index = 1; index <= 2; index++)
+		{
+			m_Swapchain.SetFrameParameters(&m_Parameters, frame == 0, 2, index);
+			EXPECT_EQ(NVSDK_NGX_HEADLESS_EvaluateFeature(&m_CommandList, handle, &m_Parameters), NGX_SUCCESS)
+				<< "Frame " << frame << ", index " << index;
+		}
+	}
+
+	EXPECT_GT(GetDispatchCount(), 0u);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_ReleaseFeature(handle), NGX_SUCCESS);
+}
+
+TEST_F(NvNGXHeadlessTest, MissingInputsAreRejected)
+{
+	const auto handle = CreateFeature();
+	ASSERT_NE(handle, nullptr);
+
+	m_Swapchain.SetFrameParameters(&m_Parameters, true, 1, 1);
+	m_Parameters.Remove("DLSSG.Depth");
+
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_EvaluateFeature(&m_CommandList, handle, &m_Parameters), NGX_INVALID_PARAMETER);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_ReleaseFeature(handle), NGX_SUCCESS);
+}
+
+TEST_F(NvNGXHeadlessTest, ReleasedHandlesAreRejected)
+{
+	const auto handle = CreateFeature();
+	ASSERT_NE(handle, nullptr);
+	ASSERT_EQ(NVSDK_NGX_HEADLESS_ReleaseFeature(handle), NGX_SUCCESS);
+
+	m_Swapchain.SetFrameParameters(&m_Parameters, true, 1, 1);
+
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_EvaluateFeature(&m_CommandList, handle, &m_Parameters), NGX_FEATURE_NOT_FOUND);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_ReleaseFeature(handle), NGX_FEATURE_NOT_FOUND);
+}
+
+TEST_F(NvNGXHeadlessTest, NullArgumentsAreRejected)
+{
+	NGXHandle *handle = nullptr;
+	NGXFeatureRequirementInfo requirements = {};
+
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_Init_Ext2(nullptr, &m_Parameters), NGX_INVALID_PARAMETER);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_CreateFeature1(nullptr, &m_CommandList, &m_Parameters, &handle), NGX_INVALID_PARAMETER);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_GetFeatureRequirements(nullptr, &requirements), NGX_INVALID_PARAMETER);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_EvaluateFeature(&m_CommandList, nullptr, &m_Parameters), NGX_INVALID_PARAMETER);
+	EXPECT_EQ(NVSDK_NGX_HEADLESS_ReleaseFeature(nullptr), NGX_INVALID_PARAMETER);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <FidelityFX/host/ffx_interface.h>
+#include "ffx_object_management.h"
+
+// Stand-in for a backend's fpCreatePipeline. Every pipeline records the pass it was built for.
+class PipelineCreationTest : public testing::Test
+{
+protected:
+	inline static std::atomic<uint32_t> ActiveCalls;
+	inline static std::atomic<uint32_t> MaxActiveCalls;
+	inline static std::atomic<uint32_t> DestroyCount;
+	inline static std::optional<FfxPass> FailingPass;
+
+	FfxInterface m_Interface = {};
+
+	void SetUp() override
+	{
+		ActiveCalls = 0;
+		MaxActiveCalls = 0;
+		DestroyCount = 0;
+		FailingPass.reset();
+
+		m_Interface.fpCreatePipeline = CreatePipeline;
+		m_Interface.fpDestroyPipeline = DestroyPipeline;
+	}
+
+	static FfxErrorCode CreatePipeline(
+		FfxInterface *,
+		FfxEffect,
+		FfxPass Pass,
+		uint32_t,
+		const FfxPipelineDescription *,
+		FfxUInt32,
+		FfxPipelineState *OutPipeline)
+	{
+		const auto active = ++ActiveCalls;
+
+		for (auto max = MaxActiveCalls.load(); active > max && !MaxActiveCalls.compare_exchange_weak(max, active);)
+			;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		ActiveCalls--;
+
+		if (FailingPass == Pass)
+			return FFX_ERROR_BACKEND_API_ERROR;
+
+		OutPipeline->passId = Pass;
+		return FFX_OK;
+	}
+
+	static FfxErrorCode DestroyPipeline(FfxInterface *, FfxPipelineState *Pipeline, FfxUInt32)
+	{
+		Pipeline->passId = ~0u;
+		DestroyCount++;
+
+		return FFX_OK;
+	}
+
+	static std::vector<FfxPipelineCreationJob> MakeJobs(std::vector<FfxPipelineState>& Pipelines)
+	{
+		std::vector<FfxPipelineCreationJob> jobs(Pipelines.size());
+
+		for (uint32_t i = 0; i < jobs.size(); i++)
+		{
+			jobs[i].pass = static_cast<FfxPass>(i);
+			jobs[i].pipeline = &Pipelines[i];
+		}
+
+		return jobs;
+	}
+};
+
+TEST_F(PipelineCreationTest, CreatesEveryPipeline)
+{
+	std::vector<FfxPipelineState> pipelines(20);
+	auto jobs = MakeJobs(pipelines);
+
+	ASSERT_EQ(ffxCreatePipelinesParallel(&m_Interface, FFX_EFFECT_FRAMEINTERPOLATION, 0, jobs.data(), 20), FFX_OK);
+
+	for (uint32_t i = 0; i < pipelines.size(); i++)
+		EXPECT_EQ(pipelines[i].passId, i);
+
+	EXPECT_LE(MaxActiveCalls, static_cast<uint32_t>(FFX_MAX_PIPELINE_CREATION_THREADS));
+	EXPECT_EQ(ffxCreatePipelinesParallel(&m_Interface, FFX_EFFECT_FRAMEINTERPOLATION, 0, nullptr, 0), FFX_OK);
+}
+
+TEST_F(PipelineCreationTest, ConcurrentCallsShareHelpers)
+{
+	constexpr uint32_t callerCount = 6;
+	constexpr uint32_t jobCount = 24;
+
+	std::vector<std::vector<FfxPipelineState>> pipelines(callerCount, std::vector<FfxPipelineState>(jobCount));
+	std::vector<std::thread> callers;
+	std::atomic<uint32_t> failures = 0;
+
+	for (uint32_t i = 0; i < callerCount; i++)
+	{
+		callers.emplace_back(
+			[&, i]()
+			{
+				auto jobs = MakeJobs(pipelines[i]);
+
+				if (ffxCreatePipelinesParallel(&m_Interface, FFX_EFFECT_OPTICALFLOW, i, jobs.data(), jobCount) != FFX_OK)
+					failures++;
+			});
+	}
+
+	for (auto& caller : callers)
+		caller.join();
+
+	EXPECT_EQ(failures, 0u);
+
+	for (const auto& set : pipelines)
+	{
+		for (uint32_t i = 0; i < jobCount; i++)
+			EXPECT_EQ(set[i].passId, i);
+	}
+
+	// Callers only ever work on their own jobs, helpers are shared
+	EXPECT_LE(MaxActiveCalls, callerCount + FFX_MAX_PIPELINE_CREATION_THREADS - 1);
+}
+
+TEST_F(PipelineCreationTest, FailureReleasesCreatedPipelines)
+{
+	std::vector<FfxPipelineState> pipelines(12);
+	auto jobs = MakeJobs(pipelines);
+	FailingPass = static_cast<FfxPass>(7);
+
+	EXPECT_EQ(ffxCreatePipelinesParallel(&m_Interface, FFX_EFFECT_FRAMEINTERPOLATION, 0, jobs.data(), 12), FFX_ERROR_BACKEND_API_ERROR);
+	EXPECT_EQ(DestroyCount, 11u);
+
+	for (uint32_t i = 0; i < pipelines.size(); i++)
+	{
+		if (i != 7)
+			EXPECT_EQ(pipelines[i].passId, ~0u);
+	}
+}
@@ -0,0 +1,333 @@
+#include <cmath>
+#include <numbers>
+#include "SyntheticScene.h"
+
+namespace SyntheticScene
+{
+	struct Vector2
+	{
+		double X;
+		double Y;
+	};
+
+	// Smooth content only. Bilinear resampling of sharp edges would drown the errors the metrics are meant to catch.
+	static std::array<float, 3> SampleBackground(Vector2 P, uint32_t Content)
+	{
+		const double phase = Content * 1.7;
+
+		return {
+			static_cast<float>(0.5 + 0.4 * std::sin(P.X * 0.11 + phase) * std::cos(P.Y * 0.07)),
+			static_cast<float>(0.5 + 0.4 * std::sin(P.X * std::numbers::pi / 16.0) * std::sin(P.Y * std::numbers::pi / 16.0 + phase)),
+			static_cast<float>(0.5 + 0.3 * std::sin((P.X + P.Y) * 0.05 + phase)),
+		};
+	}
+
+	static std::array<float, 3> SampleForeground(Vector2 P)
+	{
+		return {
+			static_cast<float>(0.8 + 0.15 * std::sin(P.X * 0.3)),
+			static_cast<float>(0.2 + 0.1 * std::cos(P.Y * 0.25)),
+			0.1f,
+		};
+	}
+
+	// Screen position of a point on the background plane at Time
+	static Vector2 BackgroundToScreen(Scenario Scenario, Vector2 P, double Time, Vector2 Center)
+	{
+		switch (Scenario)
+		{
+		case Scenario::Panning:
+		case Scenario::SceneCut:
+		case Scenario::HDR:
+		case Scenario::UIOverlay:
+			return { P.X - 5.5 * Time, P.Y - 2.25 * Time };
+
+		case Scenario::Rotation:
+		{
+			const double angle = 0.015 * Time;
+			const double dx = P.X - Center.X;
+			const double dy = P.Y - Center.Y;
+
+			return { Center.X + dx * std::cos(angle) - dy * std::sin(angle), Center.Y + dx * std::sin(angle) + dy * std::cos(angle) };
+		}
+
+		case Scenario::Zoom:
+		{
+			const double scale = std::pow(1.02, Time);
+			return { Center.X + (P.X - Center.X) * scale, Center.Y + (P.Y - Center.Y) * scale };
+		}
+
+		default:
+			return P;
+		}
+	}
+
+	static Vector2 ScreenToBackground(Scenario Scenario, Vector2 P, double Time, Vector2 Center)
+	{
+		switch (Scenario)
+		{
+		case Scenario::Rotation:
+			return BackgroundToScreen(Scenario, P, -Time, Center);
+
+		case Scenario::Zoom:
+			return BackgroundToScreen(Scenario, P, -Time, Center);
+
+		case Scenario::Panning:
+		case Scenario::SceneCut:
+		case Scenario::HDR:
+		case Scenario::UIOverlay:
+			return { P.X + 5.5 * Time, P.Y + 2.25 * Time };
+
+		default:
+			return P;
+		}
+	}
+
+	Image::Image(uint32_t Width, uint32_t Height, uint32_t Channels)
+		: Width(Width),
+		  Height(Height),
+		  Channels(Channels),
+		  Texels(static_cast<size_t>(Width) * Height * Channels)
+	{
+	}
+
+	float *Image::At(uint32_t X, uint32_t Y)
+	{
+		return &Texels[(static_cast<size_t>(Y) * Width + X) * Channels];
+	}
+
+	const float *Image::At(uint32_t X, uint32_t Y) const
+	{
+		return &Texels[(static_cast<size_t>(Y) * Width + X) * Channels];
+	}
+
+	const char *GetName(Scenario Scenario)
+	{
+		constexpr std::array<const char *, static_cast<size_t>(Scenario::Count)> names = {
+			"Panning", "Rotation", "Zoom", "Disocclusion", "SceneCut", "HDR", "UIOverlay",
+		};
+
+		return names.at(static_cast<size_t>(Scenario));
+	}
+
+	Frame Render(Scenario Scenario, uint32_t Width, uint32_t Height, double Time, double PreviousTime)
+	{
+		const Vector2 center = { Width / 2.0, Height / 2.0 };
+		const uint32_t content = (Scenario == Scenario::SceneCut && Time >= CutFrame) ? 1 : 0;
+		const uint32_t previousContent = (Scenario == Scenario::SceneCut && PreviousTime >= CutFrame) ? 1 : 0;
+
+		// Foreground quad for disocclusion, moving right by whole pixels per frame
+		const double quadSize = Height / 3.0;
+		const auto quadOrigin = [&](double T) { return Vector2 { Width / 4.0 + 6.0 * T, Height / 3.0 }; };
+
+		// HUD in the lower left corner, fixed on screen
+		const uint32_t hudWidth = Width / 4;
+		const uint32_t hudHeight = Height / 6;
+
+		Frame frame;
+		frame.Color = Image(Width, Height, 4);
+		frame.Depth = Image(Width, Height, 1);
+		frame.MotionVectors = Image(Width, Height, 2);
+		frame.Reset = content != previousContent;
+		frame.HDR = Scenario == Scenario::HDR;
+
+		if (Scenario == Scenario::UIOverlay)
+			frame.HUDLess = Image(Width, Height, 4);
+
+		for (uint32_t y = 0; y < Height; y++)
+		{
+			for (uint32_t x = 0; x < Width; x++)
+			{
+				const Vector2 p = { x + 0.5, y + 0.5 };
+				std::array<float, 3> color;
+				float depth;
+				Vector2 previous;
+
+				const auto origin = quadOrigin(Time);
+				const bool inQuad = Scenario == Scenario::Disocclusion && p.X >= origin.X && p.X < origin.X + quadSize &&
+					p.Y >= origin.Y && p.Y < origin.Y + quadSize;
+
+				if (inQuad)
+				{
+					const auto previousOrigin = quadOrigin(PreviousTime);
+
+					color = SampleForeground({ p.X - origin.X, p.Y - origin.Y });
+					depth = 0.8f;
+					previous = { p.X - origin.X + previousOrigin.X, p.Y - origin.Y + previousOrigin.Y };
+				}
+				else
+				{
+					const auto background = ScreenToBackground(Scenario, p, Time, center);
+
+					color = SampleBackground(background, content);
+					depth = 0.2f;
+					previous = BackgroundToScreen(Scenario, background, PreviousTime, center);
+				}
+
+				if (frame.HDR)
+				{
+					for (auto& c : color)
+						c *= HDRPeak;
+				}
+
+				auto output = frame.Color.At(x, y);
+				std::copy(color.begin(), color.end(), output);
+				output[3] = 1.0f;
+
+				if (!frame.HUDLess.Texels.empty())
+				{
+					std::copy(output, output + 4, frame.HUDLess.At(x, y));
+
+					if (x < hudWidth && y >= Height - hudHeight)
+					{
+						for (uint32_t c = 0; c < 3; c++)
+							output[c] = output[c] * 0.25f + 0.9f * 0.75f;
+					}
+				}
+
+				*frame.Depth.At(x, y) = depth;
+				frame.MotionVectors.At(x, y)[0] = static_cast<float>(previous.X - p.X);
+				frame.MotionVectors.At(x, y)[1] = static_cast<float>(previous.Y - p.Y);
+			}
+		}
+
+		return frame;
+	}
+
+	Image BackwardWarp(const Frame& Previous, const Frame& Current, std::vector<bool> *OutMask)
+	{
+		// The HUD stays put while the scene moves underneath it
+		const auto& source = Previous.HUDLess.Texels.empty() ? Previous.Color : Previous.HUDLess;
+		Image output(source.Width, source.Height, source.Channels);
+
+		if (OutMask)
+			OutMask->assign(static_cast<size_t>(source.Width) * source.Height, false);
+
+		for (uint32_t y = 0; y < source.Height; y++)
+		{
+			for (uint32_t x = 0; x < source.Width; x++)
+			{
+				const auto motion = Current.MotionVectors.At(x, y);
+
+				// Texel space, where texel centers sit on integers
+				const double sx = x + motion[0];
+				const double sy = y + motion[1];
+				const double fx = std::floor(sx);
+				const double fy = std::floor(sy);
+
+				if (fx < 0.0 || fy < 0.0 || fx + 1.0 >= source.Width || fy + 1.0 >= source.Height)
+				{
+					std::copy_n(source.At(x, y), source.Channels, output.At(x, y));
+					continue;
+				}
+
+				const auto x0 = static_cast<uint32_t>(fx);
+				const auto y0 = static_cast<uint32_t>(fy);
+				const auto wx = static_cast<float>(sx - fx);
+				const auto wy = static_cast<float>(sy - fy);
+
+				for (uint32_t c = 0; c < source.Channels; c++)
+				{
+					const float top = source.At(x0, y0)[c] * (1.0f - wx) + source.At(x0 + 1, y0)[c] * wx;
+					const float bottom = source.At(x0, y0 + 1)[c] * (1.0f - wx) + source.At(x0 + 1, y0 + 1)[c] * wx;
+					output.At(x, y)[c] = top * (1.0f - wy) + bottom * wy;
+				}
+
+				// Every texel in the footprint has to show the same surface
+				bool visible = true;
+
+				for (uint32_t j = 0; j < 2; j++)
+				{
+					for (uint32_t i = 0; i < 2; i++)
+						visible = visible && std::abs(*Previous.Depth.At(x0 + i, y0 + j) - *Current.Depth.At(x, y)) < 1e-3f;
+				}
+
+				if (OutMask)
+					(*OutMask)[static_cast<size_t>(y) * source.Width + x] = visible && !Current.Reset;
+			}
+		}
+
+		return output;
+	}
+
+	double ComputePSNR(const Image& A, const Image& B, float Peak, const std::vector<bool> *Mask)
+	{
+		double sum = 0.0;
+		size_t count = 0;
+
+		for (size_t i = 0; i < static_cast<size_t>(A.Width) * A.Height; i++)
+		{
+			if (Mask && !(*Mask)[i])
+				continue;
+
+			for (uint32_t c = 0; c < A.Channels; c++)
+			{
+				const double difference = A.Texels[i * A.Channels + c] - B.Texels[i * B.Channels + c];
+				sum += difference * difference;
+				count++;
+			}
+		}
+
+		if (count == 0 || sum == 0.0)
+			return std::numeric_limits<double>::infinity();
+
+		return 10.0 * std::log10(static_cast<double>(Peak) * Peak / (sum / count));
+	}
+
+	double ComputeSSIM(const Image& A, const Image& B, float Peak)
+	{
+		constexpr uint32_t windowSize = 8;
+
+		const double c1 = std::pow(0.01 * Peak, 2.0);
+		const double c2 = std::pow(0.03 * Peak, 2.0);
+
+		const auto luminance = [](const float *Texel) { return 0.2126 * Texel[0] + 0.7152 * Texel[1] + 0.0722 * Texel[2]; };
+
+		double sum = 0.0;
+		uint32_t windowCount = 0;
+
+		for (uint32_t wy = 0; wy + windowSize <= A.Height; wy += windowSize)
+		{
+			for (uint32_t wx = 0; wx + windowSize <= A.Width; wx += windowSize)
+			{
+				double meanA = 0.0, meanB = 0.0, varianceA = 0.0, varianceB = 0.0, covariance = 0.0;
+
+				for (uint32_t y = wy; y < wy + windowSize; y++)
+				{
+					for (uint32_t x = wx; x < wx + windowSize; x++)
+					{
+						meanA += luminance(A.At(x, y));
+						meanB += luminance(B.At(x, y));
+					}
+				}
+
+				constexpr double n = windowSize * windowSize;
+				meanA /= n;
+				meanB /= n;
+
+				for (uint32_t y = wy; y < wy + windowSize; y++)
+				{
+					for (uint32_t x = wx; x < wx + windowSize; x++)
+					{
+						const double a = luminance(A.At(x, y)) - meanA;
+						const double b = luminance(B.At(x, y)) - meanB;
+
+						varianceA += a * a;
+						varianceB += b * b;
+						covariance += a * b;
+					}
+				}
+
+				varianceA /= n - 1;
+				varianceB /= n - 1;
+				covariance /= n - 1;
+
+				sum += ((2.0 * meanA * meanB + c1) * (2.0 * covariance + c2)) /
+					((meanA * meanA + meanB * meanB + c1) * (varianceA + varianceB + c2));
+				windowCount++;
+			}
+		}
+
+		return windowCount ? sum / windowCount : 1.0;
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// Procedural frame sequences with exact ground truth for frame generation. Every frame is rendered analytically at
+// any point in time, so the true midpoint between two frames is known and interpolated output can be scored against
+// it. Color is linear RGBA, depth is inverted (1 is near) and motion vectors point from a pixel to where the same
+// surface was in the previous frame, in pixels, the way DLSSG.MVecs are defined.
+namespace SyntheticScene
+{
+	enum class Scenario
+	{
+		Panning,
+		Rotation,
+		Zoom,
+		Disocclusion, // Foreground quad moving over a static background
+		SceneCut,	  // Different content from CutFrame on
+		HDR,		  // Scene linear color well above 1.0
+		UIOverlay,	  // Static HUD composited over a panning scene. HUDLess has no HUD.
+
+		Count,
+	};
+
+	constexpr uint32_t CutFrame = 3;
+	constexpr float HDRPeak = 8.0f;
+
+	struct Image
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t Channels = 0;
+		std::vector<float> Texels;
+
+		Image() = default;
+		Image(uint32_t Width, uint32_t Height, uint32_t Channels);
+
+		float *At(uint32_t X, uint32_t Y);
+		const float *At(uint32_t X, uint32_t Y) const;
+	};
+
+	struct Frame
+	{
+		Image Color;		 // RGBA
+		Image HUDLess;		 // RGBA, empty unless the scenario has a HUD
+		Image Depth;		 // R
+		Image MotionVectors; // RG
+		bool Reset = false;	 // No valid history, e.g. the first frame after a scene cut
+		bool HDR = false;
+	};
+
+	const char *GetName(Scenario Scenario);
+
+	// Renders Scenario at Time. Motion vectors lead back to PreviousTime, which is usually Time - 1.
+	Frame Render(Scenario Scenario, uint32_t Width, uint32_t Height, double Time, double PreviousTime);
+
+	// Reference for a perfect interpolator: samples Previous bilinearly, without HUD, where Current's motion vectors lead.
+	// Mask is set for pixels that were visible in Previous, i.e. stay inside it and match its depth.
+	Image BackwardWarp(const Frame& Previous, const Frame& Current, std::vector<bool> *OutMask = nullptr);
+
+	// Peak signal to noise ratio in dB over every channel, restricted to Mask when given. Infinite for equal images.
+	double ComputePSNR(const Image& A, const Image& B, float Peak, const std::vector<bool> *Mask = nullptr);
+
+	// Mean structural similarity of luminance over 8x8 windows
+	double ComputeSSIM(const Image& A, const Image& B, float Peak);
+}
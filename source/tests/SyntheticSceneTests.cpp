@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "SyntheticScene.h"
+
+using namespace SyntheticScene;
+
+// Bars an interpolated frame has to clear against the analytic midpoint
+constexpr double MinimumPSNR = 40.0;
+constexpr double MinimumSSIM = 0.98;
+
+constexpr uint32_t Width = 160;
+constexpr uint32_t Height = 90;
+
+static float GetPeak(const Frame& Frame)
+{
+	return Frame.HDR ? HDRPeak : 1.0f;
+}
+
+namespace SyntheticScene
+{
+	// For testing::Range
+	static Scenario operator+(Scenario Value, int Step)
+	{
+		return static_cast<Scenario>(static_cast<int>(Value) + Step);
+	}
+}
+
+class SyntheticSceneTest : public testing::TestWithParam<Scenario>
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(
+	AllScenarios,
+	SyntheticSceneTest,
+	testing::Range(Scenario::Panning, Scenario::Count, 1),
+	[](const testing::TestParamInfo<Scenario>& Info) { return GetName(Info.param); });
+
+TEST_P(SyntheticSceneTest, MotionVectorsLeadToPreviousFrame)
+{
+	for (double time = 1.0; time < 6.0; time++)
+	{
+		const auto previous = Render(GetParam(), Width, Height, time - 1, time - 2);
+		const auto current = Render(GetParam(), Width, Height, time, time - 1);
+
+		std::vector<bool> mask;
+		const auto warped = BackwardWarp(previous, current, &mask);
+
+		if (current.Reset)
+		{
+			EXPECT_TRUE(std::ranges::none_of(mask, std::identity()));
+			continue;
+		}
+
+		// Disoccluded and off screen pixels aside, nearly everything was visible last frame
+		EXPECT_GT(std::ranges::count(mask, true), mask.size() * 3 / 4);
+		EXPECT_GT(ComputePSNR(warped, current.HUDLess.Texels.empty() ? current.Color : current.HUDLess, GetPeak(current), &mask), MinimumPSNR)
+			<< "Frame " << time;
+	}
+}
+
+TEST_P(SyntheticSceneTest, WarpedHalfStepMatchesMidpoint)
+{
+	const auto first = Render(GetParam(), Width, Height, 0.0, -1.0);
+	const auto midpoint = Render(GetParam(), Width, Height, 0.5, 0.0);
+
+	std::vector<bool> mask;
+	const auto interpolated = BackwardWarp(first, midpoint, &mask);
+	const auto& expected = midpoint.HUDLess.Texels.empty() ? midpoint.Color : midpoint.HUDLess;
+
+	EXPECT_GT(ComputePSNR(interpolated, expected, GetPeak(midpoint), &mask), MinimumPSNR);
+
+	if (GetParam() != Scenario::Disocclusion)
+		EXPECT_GT(ComputeSSIM(interpolated, expected, GetPeak(midpoint)), MinimumSSIM);
+}
+
+TEST(SyntheticScene, RepeatedFrameFailsThresholds)
+{
+	const auto first = Render(Scenario::Panning, Width, Height, 0.0, -1.0);
+	const auto midpoint = Render(Scenario::Panning, Width, Height, 0.5, 0.0);
+
+	// Presenting the previous frame again is what a broken interpolator looks like
+	EXPECT_LT(ComputePSNR(first.Color, midpoint.Color, 1.0f), MinimumPSNR);
+	EXPECT_LT(ComputeSSIM(first.Color, midpoint.Color, 1.0f), MinimumSSIM);
+}
+
+TEST(SyntheticScene, SceneCutResetsOnce)
+{
+	for (uint32_t time = 1; time < 6; time++)
+		EXPECT_EQ(Render(Scenario::SceneCut, Width, Height, time, time - 1).Reset, time == CutFrame) << "Frame " << time;
+
+	const auto beforeCut = Render(Scenario::SceneCut, Width, Height, CutFrame - 1, CutFrame - 2);
+	const auto afterCut = Render(Scenario::SceneCut, Width, Height, CutFrame, CutFrame - 1);
+
+	EXPECT_LT(ComputeSSIM(beforeCut.Color, afterCut.Color, 1.0f), 0.5);
+}
+
+TEST(SyntheticScene, HUDIsOnlyInColor)
+{
+	const auto frame = Render(Scenario::UIOverlay, Width, Height, 2.0, 1.0);
+	ASSERT_FALSE(frame.HUDLess.Texels.empty());
+
+	for (uint32_t y = 0; y < Height; y++)
+	{
+		for (uint32_t x = 0; x < Width; x++)
+		{
+			const bool inHUD = x < Width / 4 && y >= Height - Height / 6;
+			EXPECT_EQ(frame.Color.At(x, y)[0] != frame.HUDLess.At(x, y)[0], inHUD) << x << ", " << y;
+		}
+	}
+}
+
+TEST(SyntheticScene, HDRExceedsDisplayRange)
+{
+	const auto frame = Render(Scenario::HDR, Width, Height, 0.0, -1.0);
+
+	EXPECT_TRUE(frame.HDR);
+	EXPECT_GT(*std::ranges::max_element(frame.Color.Texels), 4.0f);
+}
+
+TEST(SyntheticScene, MetricsOfKnownImages)
+{
+	Image a(16, 16, 4);
+	Image b(16, 16, 4);
+
+	std::ranges::fill(a.Texels, 0.5f);
+	std::ranges::fill(b.Texels, 0.6f);
+
+	EXPECT_EQ(ComputePSNR(a, a, 1.0f), std::numeric_limits<double>::infinity());
+	EXPECT_NEAR(ComputePSNR(a, b, 1.0f), 20.0, 1e-4);
+	EXPECT_NEAR(ComputeSSIM(a, a, 1.0f), 1.0, 1e-9);
+
+	// Masked out differences don't count
+	std::vector<bool> mask(16 * 16, true);
+	b.Texels = a.Texels;
+	b.Texels[0] = 0.9f;
+	mask[0] = false;
+
+	EXPECT_EQ(ComputePSNR(a, b, 1.0f, &mask), std::numeric_limits<double>::infinity());
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "VRAMEstimator.h"
+
+static VRAMEstimator::Inputs MakeInputs(uint32_t Width, uint32_t Height)
+{
+	return {
+		.DisplaySize = { Width, Height },
+		.BackbufferFormat = FFX_SURFACE_FORMAT_R8G8B8A8_UNORM,
+		.SharedBackendContexts = 3,
+		.FrameInterpolationBackendContexts = 5,
+	};
+}
+
+TEST(VRAMEstimator, EmptySwapchainNeedsNothing)
+{
+	EXPECT_EQ(VRAMEstimator::EstimateFrameGeneration(MakeInputs(0, 1080)), 0u);
+	EXPECT_EQ(VRAMEstimator::EstimateFrameGeneration(MakeInputs(1920, 0)), 0u);
+}
+
+TEST(VRAMEstimator, ScalesWithDisplaySize)
+{
+	// A single 1080p context with optical flow and both backends lands in the low hundreds of megabytes
+	const auto estimate1080p = VRAMEstimator::EstimateFrameGeneration(MakeInputs(1920, 1080));
+	EXPECT_GT(estimate1080p, 64ull * 1024 * 1024);
+	EXPECT_LT(estimate1080p, 256ull * 1024 * 1024);
+
+	// Everything but the backends is per pixel
+	auto inputs1080p = MakeInputs(1920, 1080);
+	auto inputs4K = MakeInputs(3840, 2160);
+	inputs1080p.SharedBackendContexts = inputs1080p.FrameInterpolationBackendContexts = 0;
+	inputs4K.SharedBackendContexts = inputs4K.FrameInterpolationBackendContexts = 0;
+
+	const auto texels1080p = VRAMEstimator::EstimateFrameGeneration(inputs1080p);
+	const auto texels4K = VRAMEstimator::EstimateFrameGeneration(inputs4K);
+	EXPECT_GT(texels4K, texels1080p * 3);
+	EXPECT_LT(texels4K, texels1080p * 5);
+}
+
+TEST(VRAMEstimator, WiderSourceFormatsCostMore)
+{
+	auto inputs = MakeInputs(1920, 1080);
+	const auto baseEstimate = VRAMEstimator::EstimateFrameGeneration(inputs);
+
+	// The interpolation source copy takes the wider of the back buffer and HUD-less formats
+	inputs.HUDLessFormat = FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT;
+	const auto hudLessEstimate = VRAMEstimator::EstimateFrameGeneration(inputs);
+
+	EXPECT_GE(hudLessEstimate - baseEstimate, 1920ull * 1080 * 4);
+
+	inputs.HUDLessFormat = FFX_SURFACE_FORMAT_R8_UNORM;
+	EXPECT_EQ(VRAMEstimator::EstimateFrameGeneration(inputs), baseEstimate);
+}
+
+TEST(VRAMEstimator, BackendContextsAddLinearly)
+{
+	auto inputs = MakeInputs(1920, 1080);
+	inputs.FrameInterpolationBackendContexts = 0;
+	const auto withoutContexts = VRAMEstimator::EstimateFrameGeneration(inputs);
+
+	inputs.FrameInterpolationBackendContexts = 4;
+	const auto fourContexts = VRAMEstimator::EstimateFrameGeneration(inputs) - withoutContexts;
+
+	inputs.FrameInterpolationBackendContexts = 8;
+	const auto eightContexts = VRAMEstimator::EstimateFrameGeneration(inputs) - withoutContexts;
+
+	EXPECT_GT(fourContexts, 0u);
+	EXPECT_NEAR(static_cast<double>(eightContexts), static_cast<double>(fourContexts) * 2.0, 64.0 * 1024);
+}
+
+TEST(VRAMEstimator, RejectsImplausibleSwapchains)
+{
+	EXPECT_TRUE(VRAMEstimator::IsPlausibleSwapchain(3, MakeInputs(1920, 1080)));
+	EXPECT_TRUE(VRAMEstimator::IsPlausibleSwapchain(1, MakeInputs(16384, 16384)));
+
+	EXPECT_FALSE(VRAMEstimator::IsPlausibleSwapchain(0, MakeInputs(1920, 1080)));
+	EXPECT_FALSE(VRAMEstimator::IsPlausibleSwapchain(17, MakeInputs(1920, 1080)));
+	EXPECT_FALSE(VRAMEstimator::IsPlausibleSwapchain(3, MakeInputs(16385, 1080)));
+	EXPECT_FALSE(VRAMEstimator::IsPlausibleSwapchain(3, MakeInputs(1920, 0)));
+
+	auto inputs = MakeInputs(1920, 1080);
+	inputs.BackbufferFormat = FFX_SURFACE_FORMAT_UNKNOWN;
+	EXPECT_FALSE(VRAMEstimator::IsPlausibleSwapchain(3, inputs));
+}
+
+TEST(VRAMEstimator, SurfaceFormatSizes)
+{
+	EXPECT_EQ(VRAMEstimator::GetSurfaceFormatSize(FFX_SURFACE_FORMAT_R32G32B32A32_FLOAT), 16u);
+	EXPECT_EQ(VRAMEstimator::GetSurfaceFormatSize(FFX_SURFACE_FORMAT_R16G16B16A16_FLOAT), 8u);
+	EXPECT_EQ(VRAMEstimator::GetSurfaceFormatSize(FFX_SURFACE_FORMAT_R10G10B10A2_UNORM), 4u);
+	EXPECT_EQ(VRAMEstimator::GetSurfaceFormatSize(FFX_SURFACE_FORMAT_R8G8_UNORM), 2u);
+	EXPECT_EQ(VRAMEstimator::GetSurfaceFormatSize(FFX_SURFACE_FORMAT_R8_UNORM), 1u);
+}
@@ -0,0 +1,204 @@
+#include <random>
+#include <gtest/gtest.h>
+#include "ffx_vk_memory_block.h"
+
+constexpr uint64_t BlockSize = 64 * 1024 * 1024;
+constexpr uint64_t Granularity = 1024;
+
+struct Allocation
+{
+	uint64_t Offset = 0;
+	uint64_t Size = 0;
+};
+
+class VulkanMemoryBlockTest : public testing::Test
+{
+protected:
+	FfxMemoryBlockRanges m_Block = {};
+
+	void SetUp() override
+	{
+		ffxMemoryBlockReset(m_Block, BlockSize);
+	}
+
+	std::optional<Allocation> Allocate(uint64_t Size, uint64_t Alignment = 256)
+	{
+		Allocation allocation;
+
+		if (!ffxMemoryBlockAllocate(m_Block, Size, Alignment, Granularity, &allocation.Offset, &allocation.Size))
+			return std::nullopt;
+
+		return allocation;
+	}
+
+	void Free(const Allocation& Allocation)
+	{
+		ffxMemoryBlockFree(m_Block, Allocation.Offset, Allocation.Size);
+	}
+
+	// Free ranges are sorted, never touch and together with the allocations cover the block exactly
+	void ExpectConsistent(const std::vector<Allocation>& Live) const
+	{
+		uint64_t freeSize = 0;
+
+		for (uint32_t i = 0; i < m_Block.freeRangeCount; i++)
+		{
+			const auto& range = m_Block.freeRanges[i];
+
+			EXPECT_GT(range.size, 0u);
+			EXPECT_LE(range.offset + range.size, BlockSize);
+
+			if (i > 0)
+				EXPECT_GT(range.offset, m_Block.freeRanges[i - 1].offset + m_Block.freeRanges[i - 1].size) << "Range " << i;
+
+			freeSize += range.size;
+		}
+
+		uint64_t liveSize = 0;
+
+		for (const auto& allocation : Live)
+		{
+			liveSize += allocation.Size;
+
+			for (uint32_t i = 0; i < m_Block.freeRangeCount; i++)
+			{
+				const auto& range = m_Block.freeRanges[i];
+				EXPECT_TRUE(allocation.Offset + allocation.Size <= range.offset || range.offset + range.size <= allocation.Offset);
+			}
+		}
+
+		EXPECT_EQ(m_Block.allocationCount, Live.size());
+
+		// Alignment padding in front of an allocation stays free, so nothing is lost
+		EXPECT_EQ(freeSize + liveSize, BlockSize);
+	}
+};
+
+TEST_F(VulkanMemoryBlockTest, FirstFitRespectsAlignmentAndGranularity)
+{
+	const auto a = Allocate(1000);
+	const auto b = Allocate(5000, 4096);
+	ASSERT_TRUE(a && b);
+
+	EXPECT_EQ(a->Offset, 0u);
+	EXPECT_EQ(a->Size, Granularity); // Ends on granularity
+	EXPECT_EQ(b->Offset, 4096u);
+	EXPECT_EQ(b->Size % Granularity, 0u);
+	EXPECT_GE(b->Size, 5000u);
+
+	// The padding between them is reused by a small enough allocation
+	const auto c = Allocate(2048);
+	ASSERT_TRUE(c);
+	EXPECT_EQ(c->Offset, Granularity);
+
+	ExpectConsistent({ *a, *b, *c });
+}
+
+TEST_F(VulkanMemoryBlockTest, FreeMergesNeighbours)
+{
+	std::vector<Allocation> live;
+
+	for (uint32_t i = 0; i < 5; i++)
+		live.push_back(*Allocate(1024 * 1024));
+
+	ASSERT_EQ(m_Block.freeRangeCount, 1u);
+
+	// Isolated, then merging with the previous range, the next one and both
+	Free(live[1]);
+	EXPECT_EQ(m_Block.freeRangeCount, 2u);
+
+	Free(live[2]);
+	EXPECT_EQ(m_Block.freeRangeCount, 2u);
+
+	Free(live[0]);
+	EXPECT_EQ(m_Block.freeRangeCount, 2u);
+	EXPECT_EQ(m_Block.freeRanges[0].offset, 0u);
+	EXPECT_EQ(m_Block.freeRanges[0].size, 3u * 1024 * 1024);
+
+	Free(live[3]);
+	EXPECT_EQ(m_Block.freeRangeCount, 2u);
+
+	ExpectConsistent({ live[4] });
+
+	Free(live[4]);
+	EXPECT_EQ(m_Block.freeRangeCount, 1u);
+	ExpectConsistent({});
+	EXPECT_EQ(m_Block.freeRanges[0].offset, 0u);
+	EXPECT_EQ(m_Block.freeRanges[0].size, BlockSize);
+}
+
+TEST_F(VulkanMemoryBlockTest, ExactFitRemovesRange)
+{
+	const auto a = Allocate(BlockSize / 2);
+	const auto b = Allocate(BlockSize / 2);
+	ASSERT_TRUE(a && b);
+
+	EXPECT_EQ(m_Block.freeRangeCount, 0u);
+	EXPECT_FALSE(Allocate(1));
+
+	Free(*a);
+	EXPECT_EQ(m_Block.freeRangeCount, 1u);
+	EXPECT_TRUE(Allocate(BlockSize / 2));
+}
+
+TEST_F(VulkanMemoryBlockTest, RangeLimitCapsAllocations)
+{
+	std::vector<Allocation> live;
+
+	while (const auto allocation = Allocate(4096))
+		live.push_back(*allocation);
+
+	EXPECT_EQ(live.size(), FFX_MAX_MEMORY_BLOCK_RANGES - 1u);
+
+	// Freeing every other allocation needs one range each, which must still fit
+	std::vector<Allocation> remaining;
+
+	for (size_t i = 0; i < live.size(); i++)
+	{
+		if (i % 2 == 0)
+			Free(live[i]);
+		else
+			remaining.push_back(live[i]);
+	}
+
+	EXPECT_LE(m_Block.freeRangeCount, static_cast<uint32_t>(FFX_MAX_MEMORY_BLOCK_RANGES));
+	ExpectConsistent(remaining);
+}
+
+TEST_F(VulkanMemoryBlockTest, RandomWorkloadStaysConsistent)
+{
+	std::mt19937 random(1234);
+	std::vector<Allocation> live;
+
+	for (uint32_t step = 0; step < 5000; step++)
+	{
+		if (!live.empty() && (random() % 3 == 0 || live.size() > 40))
+		{
+			const auto index = random() % live.size();
+
+			Free(live[index]);
+			live.erase(live.begin() + index);
+		}
+		else
+		{
+			const uint64_t size = 1 + random() % (4 * 1024 * 1024);
+			const uint64_t alignment = uint64_t(256) << (random() % 8);
+
+			if (const auto allocation = Allocate(size, alignment))
+			{
+				EXPECT_EQ(allocation->Offset % alignment, 0u);
+				EXPECT_GE(allocation->Size, size);
+				live.push_back(*allocation);
+			}
+		}
+
+		if (step % 100 == 0)
+			ExpectConsistent(live);
+	}
+
+	for (const auto& allocation : live)
+		Free(allocation);
+
+	ExpectConsistent({});
+	EXPECT_EQ(m_Block.freeRangeCount, 1u);
+}
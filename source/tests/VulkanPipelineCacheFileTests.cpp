@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include "VulkanPipelineCacheFile.h"
+
+using Status = VulkanPipelineCacheFile::Status;
+
+class VulkanPipelineCacheFileTest : public testing::Test
+{
+protected:
+	const VulkanPipelineCacheFile::DeviceIdentity m_Device = {
+		.VendorID = 0x10DE,
+		.DeviceID = 0x2684,
+		.DriverVersion = 0x8C2A8000,
+		.PipelineCacheUUID = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 },
+	};
+
+	std::filesystem::path m_Path;
+
+	void SetUp() override
+	{
+		const auto testName = testing::UnitTest::GetInstance()->current_test_info()->name();
+		m_Path = std::filesystem::temp_directory_path() / (std::string("dlssg_to_fsr3_vk_pipelines_") + testName + ".bin");
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(m_Path);
+	}
+
+	// What vkGetPipelineCacheData returns for m_Device
+	std::vector<uint8_t> MakeCacheData(size_t PayloadSize, const VulkanPipelineCacheFile::DeviceIdentity& Device) const
+	{
+		VulkanPipelineCacheFile::DataHeader header = {
+			.HeaderSize = sizeof(VulkanPipelineCacheFile::DataHeader),
+			.HeaderVersion = 1,
+			.VendorID = Device.VendorID,
+			.DeviceID = Device.DeviceID,
+		};
+
+		std::ranges::copy(Device.PipelineCacheUUID, header.PipelineCacheUUID);
+
+		std::vector<uint8_t> data(sizeof(header) + PayloadSize);
+		memcpy(data.data(), &header, sizeof(header));
+
+		for (size_t i = sizeof(header); i < data.size(); i++)
+			data[i] = static_cast<uint8_t>(i * 31);
+
+		return data;
+	}
+
+	std::vector<uint8_t> ReadFile() const
+	{
+		std::ifstream file(m_Path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(file), {} };
+	}
+
+	void WriteFile(std::span<const uint8_t> Contents) const
+	{
+		std::ofstream file(m_Path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(Contents.data()), Contents.size());
+	}
+
+	Status Load(std::vector<uint8_t> *OutData = nullptr) const
+	{
+		std::vector<uint8_t> data;
+		const auto status = VulkanPipelineCacheFile::Load(m_Path, m_Device, &data);
+
+		// Nothing may reach the driver unless the file checked out
+		EXPECT_EQ(status == Status::Loaded, !data.empty());
+
+		if (OutData)
+			*OutData = std::move(data);
+
+		return status;
+	}
+};
+
+TEST_F(VulkanPipelineCacheFileTest, SaveLoadRoundTrip)
+{
+	const auto data = MakeCacheData(4096, m_Device);
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, data));
+
+	std::vector<uint8_t> loaded;
+	EXPECT_EQ(Load(&loaded), Status::Loaded);
+	EXPECT_EQ(loaded, data);
+
+	// Saving again replaces the file in place
+	const auto grown = MakeCacheData(8192, m_Device);
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, grown));
+	EXPECT_EQ(Load(&loaded), Status::Loaded);
+	EXPECT_EQ(loaded, grown);
+	EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(m_Path) += ".tmp"));
+}
+
+TEST_F(VulkanPipelineCacheFileTest, MissingFile)
+{
+	EXPECT_EQ(Load(), Status::Missing);
+}
+
+TEST_F(VulkanPipelineCacheFileTest, StaleDeviceOrDriver)
+{
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, MakeCacheData(256, m_Device)));
+
+	auto check = [&](const VulkanPipelineCacheFile::DeviceIdentity& Current)
+	{
+		std::vector<uint8_t> data;
+		EXPECT_EQ(VulkanPipelineCacheFile::Load(m_Path, Current, &data), Status::DifferentDevice);
+		EXPECT_TRUE(data.empty());
+	};
+
+	auto other = m_Device;
+	other.VendorID = 0x1002;
+	check(other);
+
+	other = m_Device;
+	other.DeviceID++;
+	check(other);
+
+	other = m_Device;
+	other.DriverVersion++;
+	check(other);
+
+	other = m_Device;
+	other.PipelineCacheUUID[15] ^= 0xFF;
+	check(other);
+}
+
+TEST_F(VulkanPipelineCacheFileTest, ForeignBlobBehindMatchingHeader)
+{
+	// A valid file whose blob came from another device, which some drivers crash on
+	auto other = m_Device;
+	other.PipelineCacheUUID[0] ^= 0xFF;
+
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, MakeCacheData(256, other)));
+	EXPECT_EQ(Load(), Status::Corrupt);
+
+	other = m_Device;
+	other.VendorID = 0x8086;
+
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, MakeCacheData(256, other)));
+	EXPECT_EQ(Load(), Status::Corrupt);
+}
+
+TEST_F(VulkanPipelineCacheFileTest, CorruptFiles)
+{
+	const auto data = MakeCacheData(1024, m_Device);
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, data));
+
+	const auto original = ReadFile();
+	constexpr auto headerSize = sizeof(VulkanPipelineCacheFile::FileHeader);
+
+	auto check = [&](std::vector<uint8_t> Contents, Status Expected, const char *What)
+	{
+		WriteFile(Contents);
+		EXPECT_EQ(Load(), Expected) << What;
+	};
+
+	check({}, Status::Unrecognized, "Empty");
+	check({ original.begin(), original.begin() + headerSize / 2 }, Status::Corrupt, "Truncated header");
+	check({ original.begin(), original.begin() + headerSize }, Status::Corrupt, "No data");
+	check({ original.begin(), original.end() - 1 }, Status::Corrupt, "Truncated data");
+
+	auto contents = original;
+	contents.push_back(0);
+	check(contents, Status::Corrupt, "Trailing bytes");
+
+	contents = original;
+	contents[0] = 'X';
+	check(contents, Status::Unrecognized, "Magic");
+
+	contents = original;
+	contents[offsetof(VulkanPipelineCacheFile::FileHeader, Version)]++;
+	check(contents, Status::Unrecognized, "Version");
+
+	contents = original;
+	contents.back() ^= 0x01;
+	check(contents, Status::Corrupt, "Flipped data bit");
+
+	contents = original;
+	const uint64_t hugeSize = VulkanPipelineCacheFile::MaxDataSize + 1;
+	memcpy(&contents[offsetof(VulkanPipelineCacheFile::FileHeader, DataSize)], &hugeSize, sizeof(hugeSize));
+	check(contents, Status::Corrupt, "Oversized data");
+
+	// A blob header claiming to be shorter than it is
+	contents = original;
+	contents[headerSize] = 4;
+	const auto hash = VulkanPipelineCacheFile::HashData(std::span(contents).subspan(headerSize));
+	memcpy(&contents[offsetof(VulkanPipelineCacheFile::FileHeader, DataHash)], &hash, sizeof(hash));
+	check(contents, Status::Corrupt, "Blob header size");
+
+	// Saving over a corrupt file recovers
+	ASSERT_TRUE(VulkanPipelineCacheFile::Save(m_Path, m_Device, data));
+	EXPECT_EQ(Load(), Status::Loaded);
+}